@@ -144,6 +144,10 @@ QString CustomFunctionData::paramToString(const ModelData * model) const
     return QString("%1").arg(param);
   }
   else if (func == FuncLogs) {
+    if (adjustMode == FUNC_LOGS_FORMAT_BINARY)
+      return QString("%1").arg(param / 100.0) + tr("s") + " " + tr("(binary)");
+    if (adjustMode == FUNC_LOGS_FORMAT_CAPTURE)
+      return QString("%1").arg(param / 100.0) + tr("s") + " " + tr("(raw telemetry)");
     return QString("%1").arg(param / 10.0) + tr("s");
   }
   else if (func == FuncPlaySound) {
@@ -87,6 +87,14 @@ enum GVarAdjustModes
   FUNC_ADJUST_GVAR_COUNT
 };
 
+// SD Logs format, stored in adjustMode
+enum LogsFormats
+{
+  FUNC_LOGS_FORMAT_CSV,
+  FUNC_LOGS_FORMAT_BINARY,
+  FUNC_LOGS_FORMAT_CAPTURE
+};
+
 class CustomFunctionData {
   Q_DECLARE_TR_FUNCTIONS(CustomFunctionData)
 
@@ -217,6 +217,10 @@ Node convert<CustomFunctionData>::encode(const CustomFunctionData& rhs)
   } break;
   case FuncLogs:
     def += std::to_string(rhs.param);
+    if (rhs.adjustMode == FUNC_LOGS_FORMAT_BINARY)
+      def += ",bin";
+    else if (rhs.adjustMode == FUNC_LOGS_FORMAT_CAPTURE)
+      def += ",raw";
     break;
   case FuncSetScreen:
     def += std::to_string(rhs.param);
@@ -371,6 +375,17 @@ bool convert<CustomFunctionData>::decode(const Node& node,
     int param = 0;
     def >> param;
     rhs.param = param;
+    std::string format;
+    if (def.peek() == ',') {
+      def.ignore();
+      getline(def, format, ',');
+    }
+    if (format == "bin")
+      rhs.adjustMode = FUNC_LOGS_FORMAT_BINARY;
+    else if (format == "raw")
+      rhs.adjustMode = FUNC_LOGS_FORMAT_CAPTURE;
+    else
+      rhs.adjustMode = FUNC_LOGS_FORMAT_CSV;
   } break;
   case FuncSetScreen: {
     int param = 0;
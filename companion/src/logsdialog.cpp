@@ -678,29 +678,35 @@ bool LogsDialog::cvsFileParse()
     QTextStream inputStream(&file);
     QString buffer = file.readLine();
 
-    if (buffer.startsWith("Date,Time")) {
+    if (buffer.startsWith("ETXL")) {
+      if (!binaryFileParse(file.fileName())) {
+        return false;
+      }
+      lines = csvlog.count() - 1;
+    }
+    else if (buffer.startsWith("Date,Time")) {
       file.reset();
+
+      int numfields=-1;
+      while (!file.atEnd()) {
+        QString line = file.readLine().trimmed();
+        QStringList columns = line.split(',');
+        if (numfields==-1) {
+          numfields=columns.count();
+        }
+        if (columns.count()==numfields) {
+          csvlog.append(columns);
+        }
+        else {
+          errors++;
+        }
+        lines++;
+      }
     }
     else {
       return false;
     }
 
-    int numfields=-1;
-    while (!file.atEnd()) {
-      QString line = file.readLine().trimmed();
-      QStringList columns = line.split(',');
-      if (numfields==-1) {
-        numfields=columns.count();
-      }
-      if (columns.count()==numfields) {
-        csvlog.append(columns);
-      }
-      else {
-        errors++;
-      }
-      lines++;
-    }
-
     logFilename = QFileInfo(file.fileName()).baseName();
   }
 
@@ -722,6 +728,100 @@ bool LogsDialog::cvsFileParse()
   return true;
 }
 
+// Converts a binary log (see radio/src/logs_binary.h) into the same rows
+// as a CSV log
+bool LogsDialog::binaryFileParse(const QString & fileName)
+{
+  enum ColumnType {
+    COLUMN_VALUE,
+    COLUMN_GPS,
+    COLUMN_DATETIME,
+    COLUMN_HEX64,
+  };
+
+  struct Column {
+    quint8 type;
+    quint8 prec;
+    quint8 size;
+  };
+
+  QFile file(fileName);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+  const QByteArray data = file.readAll();
+  file.close();
+
+  QDataStream stream(data);
+  stream.setByteOrder(QDataStream::LittleEndian);
+
+  char magic[4];
+  quint8 version, reserved;
+  quint16 headerSize, recordSize, columnsCount;
+  quint32 startTime, period;
+  stream.readRawData(magic, sizeof(magic));
+  stream >> version >> reserved >> headerSize >> recordSize >> columnsCount >> startTime >> period;
+  if (stream.status() != QDataStream::Ok || memcmp(magic, "ETXL", sizeof(magic)) || version != 1) {
+    return false;
+  }
+
+  QStringList header = { "Date", "Time" };
+  QList<Column> columns;
+  int size = sizeof(quint32);
+  for (int i = 0; i < columnsCount; i++) {
+    char name[17] = {};
+    Column column;
+    stream.readRawData(name, 16);
+    stream >> column.type >> column.prec >> column.size >> reserved;
+    header.append(QString::fromLatin1(name));
+    columns.append(column);
+    size += column.size;
+  }
+  if (stream.status() != QDataStream::Ok || size != recordSize || headerSize > data.size()) {
+    return false;
+  }
+  csvlog.append(header);
+
+  const QDateTime start = QDateTime::fromSecsSinceEpoch(startTime, Qt::UTC);
+  for (int pos = headerSize; pos + recordSize <= data.size(); pos += recordSize) {
+    stream.device()->seek(pos);
+    quint32 time;
+    stream >> time;
+    QDateTime timestamp = start.addMSecs(time);
+    QStringList row = { timestamp.toString("yyyy-MM-dd"), timestamp.toString("HH:mm:ss.zzz") };
+
+    for (const Column & column : columns) {
+      qint32 value = 0, value2 = 0;
+      stream >> value;
+      if (column.size >= 8)
+        stream >> value2;
+      if (column.size > 8)
+        stream.skipRawData(column.size - 8);
+
+      switch (column.type) {
+        case COLUMN_GPS:
+          row.append(QString("%1 %2").arg(value / 1000000.0, 0, 'f', 6).arg(value2 / 1000000.0, 0, 'f', 6));
+          break;
+        case COLUMN_DATETIME:
+          row.append(QString("%1-%2-%3 %4:%5:%6")
+                     .arg(value / 10000, 4, 10, QChar('0')).arg(value / 100 % 100, 2, 10, QChar('0'))
+                     .arg(value % 100, 2, 10, QChar('0')).arg(value2 / 10000, 2, 10, QChar('0'))
+                     .arg(value2 / 100 % 100, 2, 10, QChar('0')).arg(value2 % 100, 2, 10, QChar('0')));
+          break;
+        case COLUMN_HEX64:
+          row.append("0x" + QString("%1%2").arg((quint32)value2, 8, 16, QChar('0')).arg((quint32)value, 8, 16, QChar('0')).toUpper());
+          break;
+        default:
+          row.append(QString::number(value / pow(10, column.prec), 'f', column.prec));
+          break;
+      }
+    }
+    csvlog.append(row);
+  }
+
+  return true;
+}
+
 struct FlightSession {
   QDateTime start;
   QDateTime end;
@@ -175,6 +175,15 @@ CustomFunctionsPanel::CustomFunctionsPanel(QWidget * parent, ModelData * model,
     connect(fswtchParam[i], SIGNAL(editingFinished()), this, SLOT(customFunctionEdited()));
     paramLayout->addWidget(fswtchParam[i]);
 
+    fswtchLogsFormat[i] = new QComboBox(this);
+    fswtchLogsFormat[i]->setProperty("index", i);
+    fswtchLogsFormat[i]->addItem(tr("CSV"), FUNC_LOGS_FORMAT_CSV);
+    fswtchLogsFormat[i]->addItem(tr("Binary"), FUNC_LOGS_FORMAT_BINARY);
+    fswtchLogsFormat[i]->addItem(tr("Raw telemetry"), FUNC_LOGS_FORMAT_CAPTURE);
+    fswtchLogsFormat[i]->setSizeAdjustPolicy(QComboBox::AdjustToContents);
+    connect(fswtchLogsFormat[i], SIGNAL(currentIndexChanged(int)), this, SLOT(customFunctionEdited()));
+    paramLayout->addWidget(fswtchLogsFormat[i]);
+
     fswtchParamTime[i] = new TimerEdit(this);
     fswtchParamTime[i]->setProperty("index", i);
     connect(fswtchParamTime[i], SIGNAL(editingFinished()), this, SLOT(customFunctionEdited()));
@@ -328,6 +337,7 @@ void CustomFunctionsPanel::toggleSound(bool play)
 #define CUSTOM_FUNCTION_ENABLE         (1<<6)
 #define CUSTOM_FUNCTION_REPEAT         (1<<7)
 #define CUSTOM_FUNCTION_PLAY           (1<<8)
+#define CUSTOM_FUNCTION_LOGS_FORMAT    (1<<9)
 #define CUSTOM_FUNCTION_SHOW_FUNC      (1<<10)
 
 
@@ -395,14 +405,27 @@ void CustomFunctionsPanel::refreshCustomFunction(int i, bool modified)
       }
     }
     else if (func == FuncLogs) {
-      fswtchParam[i]->setDecimals(1);
-      fswtchParam[i]->setMinimum(0);
-      fswtchParam[i]->setMaximum(25.5);
-      fswtchParam[i]->setSingleStep(0.1);
-      if (modified)
-        cfn.param = fswtchParam[i]->value() * 10.0;
-      fswtchParam[i]->setValue(cfn.param / 10.0);
-      widgetsMask |= CUSTOM_FUNCTION_NUMERIC_PARAM;
+      // the period is in 100ms steps for CSV, 10ms steps for the binary formats
+      if (modified) {
+        unsigned int format = fswtchLogsFormat[i]->currentData().toUInt();
+        bool wasBinary = (cfn.adjustMode != FUNC_LOGS_FORMAT_CSV);
+        bool binary = (format != FUNC_LOGS_FORMAT_CSV);
+        if (binary == wasBinary)
+          cfn.param = qRound(fswtchParam[i]->value() * (binary ? 100.0 : 10.0));
+        else if (binary)
+          cfn.param = qMin(cfn.param * 10, 255);
+        else
+          cfn.param = qMax(cfn.param / 10, 1);
+        cfn.adjustMode = format;
+      }
+      bool binary = (cfn.adjustMode != FUNC_LOGS_FORMAT_CSV);
+      fswtchLogsFormat[i]->setCurrentIndex(fswtchLogsFormat[i]->findData(cfn.adjustMode));
+      fswtchParam[i]->setDecimals(binary ? 2 : 1);
+      fswtchParam[i]->setMinimum(binary ? 0.02 : 0);
+      fswtchParam[i]->setMaximum(binary ? 2.55 : 25.5);
+      fswtchParam[i]->setSingleStep(binary ? 0.01 : 0.1);
+      fswtchParam[i]->setValue(cfn.param / (binary ? 100.0 : 10.0));
+      widgetsMask |= CUSTOM_FUNCTION_NUMERIC_PARAM | CUSTOM_FUNCTION_LOGS_FORMAT;
     }
     else if (func >= FuncAdjustGV1 && func <= FuncAdjustGVLast) {
       int gvidx = func - FuncAdjustGV1;
@@ -587,6 +610,7 @@ void CustomFunctionsPanel::refreshCustomFunction(int i, bool modified)
     fswtchEnable[i]->setChecked(false);
   fswtchRepeat[i]->setVisible(widgetsMask & CUSTOM_FUNCTION_REPEAT);
   fswtchGVmode[i]->setVisible(widgetsMask & CUSTOM_FUNCTION_GV_MODE);
+  fswtchLogsFormat[i]->setVisible(widgetsMask & CUSTOM_FUNCTION_LOGS_FORMAT);
   playBT[i]->setVisible(widgetsMask & CUSTOM_FUNCTION_PLAY);
 }
 
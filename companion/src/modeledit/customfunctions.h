@@ -104,6 +104,7 @@ class CustomFunctionsPanel : public GenericPanel
     QCheckBox * fswtchEnable[CPN_MAX_SPECIAL_FUNCTIONS];
     QComboBox * fswtchRepeat[CPN_MAX_SPECIAL_FUNCTIONS];
     QComboBox * fswtchGVmode[CPN_MAX_SPECIAL_FUNCTIONS];
+    QComboBox * fswtchLogsFormat[CPN_MAX_SPECIAL_FUNCTIONS];
     QMediaPlayer * mediaPlayer;
 
     int selectedIndex;
@@ -148,6 +148,8 @@ class SimulatorInterface : public QObject
     virtual void lcdFlushed() = 0;
     virtual void setTrainerTimeout(uint16_t ms) = 0;
     virtual void sendTelemetry(const QByteArray data) = 0;
+    // Stops the simulation and replays a raw telemetry capture (speed 0 = as fast as possible)
+    virtual bool replayCapture(const QString & captureFile, const QString & traceFile = "", unsigned speed = 0) = 0;
     virtual void setLuaStateReloadPermanentScripts() = 0;
     virtual void addTracebackDevice(QIODevice * device) = 0;
     virtual void removeTracebackDevice(QIODevice * device) = 0;
@@ -37,6 +37,9 @@
 
 #include "tasks.h"
 #include "tasks/mixer_task.h"
+#include "mixer_stats.h"
+#include "mixer_scheduler.h"
+#include "telemetry/telemetry_stats.h"
 
 #include "cli.h"
 
@@ -993,6 +996,16 @@ int cliSet(const char **argv)
       }
       cliSerialPrint("%s: rfmod %d power %s", argv[0], module, argv[4]);
     }
+    else if (!strcmp(argv[3], "sync")) {
+      int offset = 0;
+      if (toInt(argv, 4, &offset) < 0) {
+        cliSerialPrint("%s: invalid sync argument '%s'", argv[0], argv[4]);
+        return -1;
+      }
+      offset = limit(-MAX_REFRESH_RATE / 2, offset, MAX_REFRESH_RATE / 2);
+      getModuleSyncStatus(module).setPhaseOffset(offset);
+      cliSerialPrint("%s: rfmod %d sync %d us", argv[0], module, offset);
+    }
 #if defined(INTMODULE_BOOTCMD_GPIO)
     else if (!strcmp(argv[3], "bootpin")) {
       int level = 0;
@@ -1386,7 +1399,7 @@ int cliDisplay(const char ** argv)
   else if (!strcmp(argv[1], "dc")) {
     DiskCacheStats stats = diskCache.getStats();
     uint32_t hitRate = diskCache.getHitRate();
-    cliSerialPrint("Disk Cache stats: w:%u r: %u, h: %u(%0.1f%%), m: %u", stats.noWrites, (stats.noHits + stats.noMisses), stats.noHits, hitRate*0.1f, stats.noMisses);
+    cliSerialPrint("Disk Cache stats: w:%u r: %u, h: %u(%0.1f%%), m: %u, wb: %u", stats.noWrites, (stats.noHits + stats.noMisses), stats.noHits, hitRate*0.1f, stats.noMisses, stats.noWriteBacks);
   }
 #endif
   else if (toLongLongInt(argv, 1, &address) > 0) {
@@ -1438,6 +1451,45 @@ int cliRepeat(const char ** argv)
 }
 #endif
 
+int cliMixerStats(const char ** argv)
+{
+  if (!strcmp(argv[1], "reset")) {
+    mixerStatsReset();
+    maxMixerDuration = 0;
+    return 0;
+  }
+
+  cliSerialPrint("stage          last    p50    p99    max    count");
+  for (uint8_t stage = 0; stage < MIXER_STATS_COUNT; stage++) {
+    MixerStageStats stats;
+    mixerStatsGet(stage, stats);
+    cliSerialPrint("%-12s %6d %6d %6d %6d %8u", mixerStageName(stage),
+                   stats.last, stats.p50, stats.p99, stats.max, (unsigned)stats.count);
+  }
+  cliSerialPrint("mixer max      %u us", (unsigned)maxMixerDuration);
+  return 0;
+}
+
+int cliTelemetryStats(const char ** argv)
+{
+  if (!strcmp(argv[1], "reset")) {
+    telemetryStatsReset();
+    return 0;
+  }
+
+  cliSerialPrint("module    frames      bytes    crc   size  overrun  latency    max");
+  for (uint8_t module = 0; module < NUM_MODULES; module++) {
+    TelemetryStats stats;
+    telemetryStatsGet(module, stats);
+    cliSerialPrint("%-6s %9u %10u %6d %6d %8d %8d %6d",
+                   module == INTERNAL_MODULE ? "int" : "ext",
+                   (unsigned)stats.frames, (unsigned)stats.bytes,
+                   stats.crcErrors, stats.sizeErrors, stats.overruns,
+                   stats.lastLatency, stats.maxLatency);
+  }
+  return 0;
+}
+
 #if defined(JITTER_MEASURE)
 int cliShowJitter(const char ** argv)
 {
@@ -1633,6 +1685,8 @@ const CliCommand cliCommands[] = {
   { "repeat", cliRepeat, "<interval> <command>" },
 #endif
   { "help", cliHelp, "[<command>]" },
+  { "mixerstats", cliMixerStats, "[reset]" },
+  { "telemetrystats", cliTelemetryStats, "[reset]" },
 #if defined(JITTER_MEASURE)
   { "jitter", cliShowJitter, "" },
 #endif
@@ -47,6 +47,8 @@ uint8_t getCurvePoints(uint8_t index)
 
 void loadCurves()
 {
+  invalidateCurvesCache();
+
   bool showWarning= false;
   int8_t * tmp = g_model.points;
   for (int i=0; i<MAX_CURVES; i++) {
@@ -111,7 +113,7 @@ bool moveCurve(uint8_t index, int8_t shift)
 
   curveMove_unsafe(index, shift);
   
-  storageDirty(EE_MODEL);
+  storageConfigDirty(EE_MODEL);
   return true;
 }
 
@@ -228,6 +230,35 @@ int32_t compute_tangent(CurveHeader* crv, const int8_t* points, int i)
   return m;
 }
 
+static int32_t hermite_interpolate(int32_t x, int32_t p0x, int32_t p0y, int32_t m0,
+                                   int32_t p3x, int32_t p3y, int32_t m3)
+{
+  int32_t y;
+  int32_t h = p3x - p0x;
+  int32_t t = (h > 0 ? (MMULT * (x - p0x)) / h : 0);
+  int32_t t2 = t * t / MMULT;
+  int32_t t3 = t2 * t / MMULT;
+  int32_t h00 = 2*t3 - 3*t2 + MMULT;
+  int32_t h10 = t3 - 2*t2 + t;
+  int32_t h01 = -2*t3 + 3*t2;
+  int32_t h11 = t3 - t2;
+  y = p0y * h00 + h * (m0 * h10 / MMULT) + p3y * h01 + h * (m3 * h11 / MMULT);
+  y /= MMULT;
+  return y;
+}
+
+static int32_t hermite_point_x(const int8_t * points, uint8_t count, bool custom, int i)
+{
+  if (i == 0)
+    return -RESX;
+  else if (i == count - 1)
+    return RESX;
+  else if (custom)
+    return calc100toRESX(points[count+i-1]);
+  else
+    return -RESX + (i*2*RESX)/(count-1);
+}
+
 /* The following is a hermite cubic spline.
    The basis functions can be found here:
    http://en.wikipedia.org/wiki/Cubic_Hermite_spline
@@ -246,33 +277,111 @@ int16_t hermite_spline(int16_t x, uint8_t idx)
     x = RESX;
 
   for (int i=0; i<count-1; i++) {
-    int32_t p0x, p3x;
-    if (custom) {
-      p0x = (i>0 ? calc100toRESX(points[count+i-1]) : -RESX);
-      p3x = (i<count-2 ? calc100toRESX(points[count+i]) : RESX);
-    }
-    else {
-      p0x = -RESX + (i*2*RESX)/(count-1);
-      p3x = -RESX + ((i+1)*2*RESX)/(count-1);
-    }
+    int32_t p0x = hermite_point_x(points, count, custom, i);
+    int32_t p3x = hermite_point_x(points, count, custom, i+1);
 
     if (x >= p0x && x <= p3x) {
       int32_t p0y = calc100toRESX(points[i]);
       int32_t p3y = calc100toRESX(points[i+1]);
       int32_t m0 = compute_tangent(&crv, points, i);
       int32_t m3 = compute_tangent(&crv, points, i+1);
-      int32_t y;
-      int32_t h = p3x - p0x;
-      int32_t t = (h > 0 ? (MMULT * (x - p0x)) / h : 0);
-      int32_t t2 = t * t / MMULT;
-      int32_t t3 = t2 * t / MMULT;
-      int32_t h00 = 2*t3 - 3*t2 + MMULT;
-      int32_t h10 = t3 - 2*t2 + t;
-      int32_t h01 = -2*t3 + 3*t2;
-      int32_t h11 = t3 - t2;
-      y = p0y * h00 + h * (m0 * h10 / MMULT) + p3y * h01 + h * (m3 * h11 / MMULT);
-      y /= MMULT;
-      return y;
+      return hermite_interpolate(x, p0x, p0y, m0, p3x, p3y, m3);
+    }
+  }
+  return 0;
+}
+
+/*
+  Smooth curves cache
+
+  The segments bounds and tangents of smooth curves are computed on
+  first use, instead of on every call. They are dropped when the model
+  is loaded or edited.
+*/
+
+#if defined(COLORLCD)
+  #define CURVE_CACHE_SLOTS  8
+#else
+  #define CURVE_CACHE_SLOTS  4
+#endif
+
+#define CURVE_CACHE_NONE   0
+#define CURVE_CACHE_FULL   0xFF // no slot left, use the spline
+
+struct CurveCache {
+  uint8_t count;
+  int16_t x[MAX_POINTS_PER_CURVE];
+  int16_t y[MAX_POINTS_PER_CURVE];
+  int32_t m[MAX_POINTS_PER_CURVE];
+};
+
+static CurveCache curveCaches[CURVE_CACHE_SLOTS];
+static uint8_t curveCacheSlot[MAX_CURVES]; // slot + 1
+static uint8_t curveCacheCount = 0;
+static volatile uint8_t curveCacheGeneration = 0;
+
+void invalidateCurvesCache()
+{
+  curveCacheGeneration++;
+  curveCacheCount = 0;
+  memclear(curveCacheSlot, sizeof(curveCacheSlot));
+}
+
+static void buildCurveCache(uint8_t idx, CurveCache & cache)
+{
+  CurveHeader &crv = g_model.curves[idx];
+  int8_t *points = curveAddress(idx);
+  uint8_t count = STD_CURVE_POINTS(crv.points);
+  bool custom = (crv.type == CURVE_TYPE_CUSTOM);
+
+  cache.count = count;
+  for (int i=0; i<count; i++) {
+    cache.x[i] = hermite_point_x(points, count, custom, i);
+    cache.y[i] = calc100toRESX(points[i]);
+    cache.m[i] = compute_tangent(&crv, points, i);
+  }
+}
+
+static const CurveCache * getCurveCache(uint8_t idx)
+{
+  uint8_t slot = curveCacheSlot[idx];
+  if (slot == CURVE_CACHE_FULL)
+    return nullptr;
+  else if (slot != CURVE_CACHE_NONE)
+    return &curveCaches[slot - 1];
+
+  uint8_t generation = curveCacheGeneration;
+  if (curveCacheCount >= CURVE_CACHE_SLOTS ||
+      STD_CURVE_POINTS(g_model.curves[idx].points) > MAX_POINTS_PER_CURVE) {
+    curveCacheSlot[idx] = CURVE_CACHE_FULL;
+    return nullptr;
+  }
+
+  slot = curveCacheCount++;
+  buildCurveCache(idx, curveCaches[slot]);
+  curveCacheSlot[idx] = slot + 1;
+
+  // the model was edited while building the cache
+  if (generation != curveCacheGeneration) {
+    curveCacheSlot[idx] = CURVE_CACHE_NONE;
+    return nullptr;
+  }
+
+  return &curveCaches[slot];
+}
+
+// Same result as hermite_spline()
+static int16_t cached_hermite_spline(int16_t x, const CurveCache & cache)
+{
+  if (x < -RESX)
+    x = -RESX;
+  else if (x > RESX)
+    x = RESX;
+
+  for (int i=0; i<cache.count-1; i++) {
+    if (x >= cache.x[i] && x <= cache.x[i+1]) {
+      return hermite_interpolate(x, cache.x[i], cache.y[i], cache.m[i],
+                                 cache.x[i+1], cache.y[i+1], cache.m[i+1]);
     }
   }
   return 0;
@@ -362,7 +471,7 @@ int applyCurve(int x, CurveRef & curve)
         curveParam = -curveParam;
       }
       if (curveParam > 0 && curveParam <= MAX_CURVES) {
-        return applyCustomCurve(x, curveParam - 1);
+        return applyCustomCurve(x, curveParam - 1, true);
       }
       break;
     }
@@ -371,16 +480,23 @@ int applyCurve(int x, CurveRef & curve)
   return x;
 }
 
-int applyCustomCurve(int x, uint8_t idx)
+int applyCustomCurve(int x, uint8_t idx, bool cached)
 {
   if (idx >= MAX_CURVES)
     return 0;
 
   CurveHeader & crv = g_model.curves[idx];
-  if (crv.smooth)
+  if (crv.smooth) {
+    // only the mixer fills the cache, so that the curves displayed
+    // by the GUI don't take the slots
+    const CurveCache * cache = cached ? getCurveCache(idx) : nullptr;
+    if (cache)
+      return cached_hermite_spline(x, *cache);
     return hermite_spline(x, idx);
-  else
+  }
+  else {
     return intpol(x, idx);
+  }
 }
 
 point_t getPoint(uint8_t curveIndex, uint8_t index)
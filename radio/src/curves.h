@@ -37,13 +37,14 @@ void curveClear(uint8_t index);
 void curveMirror(uint8_t index);
 bool isCurveUsed(uint8_t index);
 void loadCurves();
+void invalidateCurvesCache();
 int8_t * curveAddress(uint8_t idx);
 bool moveCurve(uint8_t index, int8_t shift);
 int8_t getCurveX(int noPoints, int point);
 void resetCustomCurveX(int8_t * points, int noPoints);
 point_t getPoint(uint8_t i);
 point_t getPoint(uint8_t curveIndex, uint8_t index);
-int applyCustomCurve(int x, uint8_t idx);
+int applyCustomCurve(int x, uint8_t idx, bool cached = false);
 int applyCurve(int x, CurveRef & curve);
 int applyCurrentCurve(int x);
 
@@ -38,103 +38,263 @@
 #define BLOCK_SIZE FF_MAX_SS
 #define DISK_CACHE_BLOCK_SIZE (DISK_CACHE_BLOCK_SECTORS * BLOCK_SIZE)
 
+#define NO_BLOCK        -1
+#define INVALID_BLOCK   0xFFFFFFFF
+
+static_assert(DISK_CACHE_BLOCK_SECTORS <= 16, "dirty sectors mask is 16 bits");
+static_assert((DISK_CACHE_HASH_SIZE & (DISK_CACHE_HASH_SIZE - 1)) == 0,
+              "DISK_CACHE_HASH_SIZE must be a power of 2");
+
+enum DiskCacheQueues {
+  QUEUE_A1,  // seen once
+  QUEUE_AM,  // seen again
+};
+
 DiskCache diskCache;
 
 class DiskCacheBlock
 {
  public:
-  DiskCacheBlock();
-  bool read(BYTE* buff, DWORD sector, UINT count);
-  DRESULT fill(const diskio_driver_t* drv, BYTE lun, BYTE* buff, DWORD sector,
-               UINT count);
-  void free(DWORD sector, UINT count);
-  void free();
-  bool empty() const;
-
- private:
   uint8_t data[DISK_CACHE_BLOCK_SIZE];
-  DWORD startSector;
-  DWORD endSector;
+  DWORD blockNo = INVALID_BLOCK;
+  int16_t hashNext = NO_BLOCK;
+  int16_t prev = NO_BLOCK;
+  int16_t next = NO_BLOCK;
+  uint8_t queue = QUEUE_A1;
+  uint16_t dirty = 0;  // sectors to be written back
+
+  bool valid() const { return blockNo != INVALID_BLOCK; }
+  DWORD firstSector() const { return blockNo * DISK_CACHE_BLOCK_SECTORS; }
 };
 
-DiskCacheBlock::DiskCacheBlock():
-  startSector(0),
-  endSector(0) 
+// Calls f(blockNo, offset, count) for each block covered by the sectors
+template <class F>
+static inline void forEachBlock(DWORD sector, UINT count, F f)
+{
+  while (count > 0) {
+    DWORD blockNo = sector / DISK_CACHE_BLOCK_SECTORS;
+    UINT offset = sector % DISK_CACHE_BLOCK_SECTORS;
+    UINT n = DISK_CACHE_BLOCK_SECTORS - offset;
+    if (n > count) n = count;
+    f(blockNo, offset, n);
+    sector += n;
+    count -= n;
+  }
+}
+
+static inline uint16_t sectorsMask(UINT offset, UINT count)
 {
+  return ((1u << count) - 1) << offset;
 }
 
-bool DiskCacheBlock::read(BYTE * buff, DWORD sector, UINT count)
+DiskCache::DiskCache() :
+  blocks(nullptr),
+  diskDrv(nullptr),
+  sectors(0),
+  lastBlock(INVALID_BLOCK)
 {
-  if (sector >= startSector && (sector+count) <= endSector) {
-    TRACE_DISK_CACHE("\tcache read(%u, %u) from %p", (uint32_t)sector, (uint32_t)count, this);
-    memcpy(buff, data + ((sector - startSector) * BLOCK_SIZE), count * BLOCK_SIZE);
-    return true;
+  memset(&stats, 0, sizeof(stats));
+}
+
+DiskCache::~DiskCache()
+{
+  delete[] blocks;
+}
+
+void DiskCache::initialize(const diskio_driver_t* drv)
+{
+  if (!blocks) blocks = new DiskCacheBlock[DISK_CACHE_BLOCKS_NUM];
+  diskDrv = drv;
+  clear();
+}
+
+void DiskCache::clear()
+{
+  if (!blocks) return;
+
+  // the card may have been changed: the delayed writes are dropped
+  memset(&stats, 0, sizeof(stats));
+  sectors = 0;
+  lastBlock = INVALID_BLOCK;
+
+  for (int16_t& bucket : hashTable) {
+    bucket = NO_BLOCK;
+  }
+  for (DiskCacheQueue& queue : queues) {
+    queue.head = queue.tail = NO_BLOCK;
+    queue.count = 0;
+  }
+  for (int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
+    DiskCacheBlock& block = blocks[n];
+    block.blockNo = INVALID_BLOCK;
+    block.hashNext = NO_BLOCK;
+    block.dirty = 0;
+    pushFront(QUEUE_A1, &block);
   }
-  return false;
 }
 
-DRESULT DiskCacheBlock::fill(const diskio_driver_t* drv, BYTE lun, BYTE * buff,
-			     DWORD sector, UINT count)
+uint32_t DiskCache::getSectors(uint8_t lun)
 {
-  DRESULT res = drv->read(lun, data, sector, DISK_CACHE_BLOCK_SECTORS);
-  if (res != RES_OK) {
-    return res;
+  if (sectors == 0) {
+    diskDrv->ioctl(lun, GET_SECTOR_COUNT, &sectors);
   }
-  startSector = sector;
-  endSector = sector + DISK_CACHE_BLOCK_SECTORS;
-  memcpy(buff, data, count * BLOCK_SIZE);
-  TRACE_DISK_CACHE("cache %p FILLED from read(%u, %u)", this, (uint32_t)sector, (uint32_t)count);
-  return RES_OK;
+  return sectors;
 }
 
-void DiskCacheBlock::free(DWORD sector, UINT count) 
+DiskCacheBlock* DiskCache::find(DWORD blockNo)
 {
-  if (sector < endSector && (sector+count) > startSector) {
-    TRACE_DISK_CACHE("\tINVALIDATING disk cache block %p (%u)", this, startSector);
-    endSector = 0;
+  int16_t n = hashTable[blockNo & (DISK_CACHE_HASH_SIZE - 1)];
+  while (n != NO_BLOCK) {
+    if (blocks[n].blockNo == blockNo) {
+      return &blocks[n];
+    }
+    n = blocks[n].hashNext;
   }
+  return nullptr;
 }
 
-void DiskCacheBlock::free()
+void DiskCache::unlink(DiskCacheBlock* block)
 {
-  endSector = 0;
+  DiskCacheQueue& queue = queues[block->queue];
+  if (block->prev != NO_BLOCK)
+    blocks[block->prev].next = block->next;
+  else
+    queue.head = block->next;
+  if (block->next != NO_BLOCK)
+    blocks[block->next].prev = block->prev;
+  else
+    queue.tail = block->prev;
+  block->prev = block->next = NO_BLOCK;
+  queue.count--;
 }
 
-bool DiskCacheBlock::empty() const
+void DiskCache::pushFront(uint8_t queue, DiskCacheBlock* block)
 {
-  return (endSector == 0);
+  int16_t n = block - blocks;
+  DiskCacheQueue& q = queues[queue];
+  block->queue = queue;
+  block->prev = NO_BLOCK;
+  block->next = q.head;
+  if (q.head != NO_BLOCK)
+    blocks[q.head].prev = n;
+  else
+    q.tail = n;
+  q.head = n;
+  q.count++;
 }
 
-DiskCache::DiskCache() : lastBlock(0), blocks(nullptr), diskDrv(nullptr)
+DRESULT DiskCache::writeDirty(BYTE lun, DiskCacheBlock* block)
 {
-  stats.noHits = 0;
-  stats.noMisses = 0;
-  stats.noWrites = 0;
+  UINT offset = 0;
+  while (block->dirty) {
+    // contiguous dirty sectors are written at once
+    while (!(block->dirty & (1 << offset))) offset++;
+    UINT count = 0;
+    while (offset + count < DISK_CACHE_BLOCK_SECTORS &&
+           (block->dirty & (1 << (offset + count))))
+      count++;
+
+    TRACE_DISK_CACHE("\twrite back(%u, %u)", (uint32_t)(block->firstSector() + offset), count);
+    DRESULT res = diskDrv->write(lun, block->data + offset * BLOCK_SIZE,
+                                 block->firstSector() + offset, count);
+    if (res != RES_OK) {
+      return res;
+    }
+    block->dirty &= ~sectorsMask(offset, count);
+  }
+  return RES_OK;
 }
 
-void DiskCache::initialize(const diskio_driver_t* drv)
+DRESULT DiskCache::evict(BYTE lun, DiskCacheBlock* block)
 {
-  blocks = new DiskCacheBlock[DISK_CACHE_BLOCKS_NUM];
-  diskDrv = drv;
+  if (!block->valid()) {
+    return RES_OK;
+  }
+
+  if (block->dirty) {
+    DRESULT res = writeDirty(lun, block);
+    if (res != RES_OK) {
+      return res;
+    }
+  }
+
+  int16_t* n = &hashTable[block->blockNo & (DISK_CACHE_HASH_SIZE - 1)];
+  while (&blocks[*n] != block) {
+    n = &blocks[*n].hashNext;
+  }
+  *n = block->hashNext;
+
+  TRACE_DISK_CACHE("\tevicting block %u", (uint32_t)block->blockNo);
+  block->hashNext = NO_BLOCK;
+  block->blockNo = INVALID_BLOCK;
+  return RES_OK;
 }
 
-void DiskCache::clear()
+DiskCacheBlock* DiskCache::findClean()
 {
-  lastBlock = 0;
-  stats.noHits = 0;
-  stats.noMisses = 0;
-  stats.noWrites = 0;
-  for (int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
-    blocks[n].free();
+  // least recently used block without delayed writes
+  for (uint8_t queue = QUEUE_A1; queue <= QUEUE_AM; queue++) {
+    for (int16_t n = queues[queue].tail; n != NO_BLOCK; n = blocks[n].prev) {
+      if (!blocks[n].dirty) {
+        return &blocks[n];
+      }
+    }
   }
+  return nullptr;
 }
 
-uint32_t DiskCache::getSectors(uint8_t lun)
+DRESULT DiskCache::allocate(BYTE lun, DWORD blockNo, DiskCacheBlock** result)
 {
-  if (sectors == 0) {
-    diskDrv->ioctl(lun, GET_SECTOR_COUNT, &sectors);
+  // 2Q: the blocks seen once go first, unless their queue is small
+  uint8_t queue = QUEUE_A1;
+  if (queues[QUEUE_A1].count <= DISK_CACHE_A1_BLOCKS &&
+      queues[QUEUE_AM].count > 0) {
+    queue = QUEUE_AM;
   }
-  return sectors;
+
+  DiskCacheBlock* block = &blocks[queues[queue].tail];
+  DRESULT res = evict(lun, block);
+  if (res != RES_OK) {
+    // the delayed writes are kept, and the block is moved
+    // out of the way of the next misses
+    unlink(block);
+    pushFront(block->queue, block);
+    block = findClean();
+    if (!block) {
+      return res;
+    }
+    evict(lun, block);
+  }
+
+  block->blockNo = blockNo;
+  int16_t& bucket = hashTable[blockNo & (DISK_CACHE_HASH_SIZE - 1)];
+  block->hashNext = bucket;
+  bucket = block - blocks;
+
+  unlink(block);
+  pushFront(QUEUE_A1, block);
+  *result = block;
+  return RES_OK;
+}
+
+DRESULT DiskCache::load(BYTE lun, DWORD blockNo, DiskCacheBlock** result)
+{
+  DiskCacheBlock* block;
+  DRESULT res = allocate(lun, blockNo, &block);
+  if (res != RES_OK) {
+    return res;
+  }
+
+  res = diskDrv->read(lun, block->data, block->firstSector(),
+                      DISK_CACHE_BLOCK_SECTORS);
+  if (res != RES_OK) {
+    evict(lun, block);
+    return res;
+  }
+
+  TRACE_DISK_CACHE("cache %p FILLED with block %u", block, (uint32_t)blockNo);
+  *result = block;
+  return RES_OK;
 }
 
 DRESULT DiskCache::read(BYTE lun, BYTE * buff, DWORD sector, UINT count)
@@ -142,50 +302,136 @@ DRESULT DiskCache::read(BYTE lun, BYTE * buff, DWORD sector, UINT count)
   // if read is bigger than cache block, then read it directly without using cache
   if (count > DISK_CACHE_BLOCK_SECTORS) {
     TRACE_DISK_CACHE("big read(%u, %u)",  (uint32_t)sector, (uint32_t)count);
-    return diskDrv->read(lun, buff, sector, count);
+    DRESULT res = diskDrv->read(lun, buff, sector, count);
+#if defined(DISK_CACHE_WRITE_BACK)
+    // the disk is not up to date with the delayed writes
+    forEachBlock(sector, count, [&](DWORD blockNo, UINT offset, UINT n) {
+      DiskCacheBlock* block = find(blockNo);
+      if (block && block->dirty) {
+        for (UINT i = offset; i < offset + n; i++) {
+          if (block->dirty & (1 << i)) {
+            memcpy(buff + (block->firstSector() + i - sector) * BLOCK_SIZE,
+                   block->data + i * BLOCK_SIZE, BLOCK_SIZE);
+          }
+        }
+      }
+    });
+#endif
+    return res;
   }
-  
-  // if block + cache block size is beyond the end of the disk,
+
+  // if the cache blocks would be beyond the end of the disk,
   // then read it directly without using cache
-  if (sector + DISK_CACHE_BLOCK_SECTORS >= getSectors(lun)) {
+  DWORD lastBlockNo = (sector + count - 1) / DISK_CACHE_BLOCK_SECTORS;
+  if ((lastBlockNo + 1) * DISK_CACHE_BLOCK_SECTORS > getSectors(lun)) {
     TRACE_DISK_CACHE("cache would be beyond end of disk %u (%u)",
 		     (uint32_t)sector, getSectors(lun));
     return diskDrv->read(lun, buff, sector, count);
   }
 
-  for (int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
-    if (blocks[n].read(buff, sector, count)) {
+  DRESULT res = RES_OK;
+  forEachBlock(sector, count, [&](DWORD blockNo, UINT offset, UINT n) {
+    if (res != RES_OK) return;
+
+    DiskCacheBlock* block = find(blockNo);
+    if (block) {
       ++stats.noHits;
-      return RES_OK;
+      if (block->queue == QUEUE_AM || blockNo != lastBlock) {
+        // accessed again: most recently used of the Am queue
+        unlink(block);
+        pushFront(QUEUE_AM, block);
+      }
+    }
+    else {
+      ++stats.noMisses;
+      res = load(lun, blockNo, &block);
+      if (res != RES_OK) return;
     }
-  }
 
-  ++stats.noMisses;
+    memcpy(buff, block->data + offset * BLOCK_SIZE, n * BLOCK_SIZE);
+    buff += n * BLOCK_SIZE;
+    lastBlock = blockNo;
+  });
 
-  // find free block
-  for (int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
-    if (blocks[n].empty()) {
-      TRACE_DISK_CACHE("\t\t using free block");
-      return blocks[n].fill(diskDrv, lun, buff, sector, count);
+  return res;
+}
+
+DRESULT DiskCache::write(BYTE lun, const BYTE* buff, DWORD sector, UINT count)
+{
+  ++stats.noWrites;
+
+#if defined(DISK_CACHE_WRITE_BACK)
+  // the write is delayed only if all the sectors are cached
+  bool delayed = true;
+  forEachBlock(sector, count, [&](DWORD blockNo, UINT, UINT) {
+    if (!find(blockNo)) delayed = false;
+  });
+#endif
+
+  // the cached copies are kept up to date
+  const BYTE* src = buff;
+  forEachBlock(sector, count, [&](DWORD blockNo, UINT offset, UINT n) {
+    DiskCacheBlock* block = find(blockNo);
+    if (block) {
+      memcpy(block->data + offset * BLOCK_SIZE, src, n * BLOCK_SIZE);
+#if defined(DISK_CACHE_WRITE_BACK)
+      if (delayed)
+        block->dirty |= sectorsMask(offset, n);
+      else
+        block->dirty &= ~sectorsMask(offset, n);
+#endif
     }
+    src += n * BLOCK_SIZE;
+  });
+
+#if defined(DISK_CACHE_WRITE_BACK)
+  if (delayed) {
+    TRACE_DISK_CACHE("delayed write(%u, %u)", (uint32_t)sector, (uint32_t)count);
+    ++stats.noWriteBacks;
+    return RES_OK;
   }
+#endif
 
-  // use next block (round robin)
-  // TODO: use better strategy to select which used block gets used here
-  if (++lastBlock >= DISK_CACHE_BLOCKS_NUM) {
-    lastBlock = 0;
+  DRESULT res = diskDrv->write(lun, buff, sector, count);
+  if (res != RES_OK) {
+    // the cache would not match the disk anymore
+    forEachBlock(sector, count, [&](DWORD blockNo, UINT offset, UINT n) {
+      DiskCacheBlock* block = find(blockNo);
+      if (!block) return;
+      // the delayed writes of the other sectors are not lost:
+      // when they can't be written either, the block is kept
+      // and the failed sectors are written again with them
+      if (block->dirty && writeDirty(lun, block) != RES_OK) {
+        block->dirty |= sectorsMask(offset, n);
+        return;
+      }
+      evict(lun, block);
+    });
   }
-  
-  return blocks[lastBlock].fill(diskDrv, lun, buff, sector, count);
+  return res;
 }
 
-DRESULT DiskCache::write(BYTE lun, const BYTE* buff, DWORD sector, UINT count)
+DRESULT DiskCache::flush(BYTE lun)
 {
-  ++stats.noWrites;
-  for(int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
-    blocks[n].free(sector, count);
+  DRESULT result = RES_OK;
+  for (int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
+    if (blocks[n].dirty) {
+      DRESULT res = writeDirty(lun, &blocks[n]);
+      if (res != RES_OK) result = res;
+    }
   }
-  return diskDrv->write(lun, buff, sector, count);
+  return result;
+}
+
+DRESULT DiskCache::ioctl(BYTE lun, BYTE cmd, void* buff)
+{
+  if (cmd == CTRL_SYNC) {
+    DRESULT res = flush(lun);
+    if (res != RES_OK) {
+      return res;
+    }
+  }
+  return diskDrv->ioctl(lun, cmd, buff);
 }
 
 const DiskCacheStats & DiskCache::getStats() const 
@@ -210,3 +456,7 @@ DRESULT disk_cache_write(BYTE drv, const BYTE * buff, DWORD sector, UINT count)
   return diskCache.write(drv, buff, sector, count);
 }
 
+DRESULT disk_cache_ioctl(BYTE drv, BYTE cmd, void * buff)
+{
+  return diskCache.ioctl(drv, cmd, buff);
+}
@@ -26,43 +26,81 @@
 // tunable parameters
 #define DISK_CACHE_BLOCKS_NUM      32   // no cache blocks
 #define DISK_CACHE_BLOCK_SECTORS   16   // no sectors
+#define DISK_CACHE_HASH_SIZE       64   // no hash buckets (power of 2)
+#define DISK_CACHE_A1_BLOCKS       8    // max blocks in the "seen once" queue
+
+// Write-back mode (DISK_CACHE_WRITE_BACK): writes to cached sectors
+// (FAT, directories, ...) are only applied to the cache, and written
+// to the disk on CTRL_SYNC or when the block is evicted.
 
 struct DiskCacheStats
 {
   uint32_t noHits;
   uint32_t noMisses;
   uint32_t noWrites;
+  uint32_t noWriteBacks;  // sector writes delayed by the cache
 };
 
 class DiskCacheBlock;
 
+// Queue of blocks, most recently used at the head
+struct DiskCacheQueue
+{
+  int16_t head;
+  int16_t tail;
+  uint16_t count;
+};
+
+// Cache of aligned blocks of DISK_CACHE_BLOCK_SECTORS sectors.
+//
+// The blocks are found through a hash table on their block number, and
+// evicted with a simplified 2Q strategy: blocks enter the A1 queue and
+// are moved to the Am (LRU) queue when they are read again later (not by
+// a sequential read of the same block). Blocks of files read
+// sequentially (WAV, logs, ...) thus stay in A1 and are evicted before
+// the frequently used ones (FAT, directories).
 class DiskCache
 {
  public:
   DiskCache();
+  ~DiskCache();
 
   void initialize(const diskio_driver_t* drv);
   void clear();
 
   DRESULT read(BYTE drv, BYTE* buff, DWORD sector, UINT count);
   DRESULT write(BYTE drv, const BYTE* buff, DWORD sector, UINT count);
+  DRESULT ioctl(BYTE drv, BYTE cmd, void* buff);
+
+  // writes the delayed sectors (write-back mode)
+  DRESULT flush(BYTE drv);
 
   const DiskCacheStats& getStats() const;
   int getHitRate() const;
 
  private:
   DiskCacheStats stats;
-  uint32_t lastBlock;
   DiskCacheBlock* blocks;
   const diskio_driver_t* diskDrv;
   uint32_t sectors;
+  int16_t hashTable[DISK_CACHE_HASH_SIZE];
+  DiskCacheQueue queues[2];
+  DWORD lastBlock;      // block number of the last access
 
   uint32_t getSectors(uint8_t lun);
+
+  DiskCacheBlock* find(DWORD blockNo);
+  DiskCacheBlock* findClean();
+  void unlink(DiskCacheBlock* block);
+  void pushFront(uint8_t queue, DiskCacheBlock* block);
+  DRESULT evict(BYTE lun, DiskCacheBlock* block);
+  DRESULT allocate(BYTE lun, DWORD blockNo, DiskCacheBlock** result);
+  DRESULT load(BYTE lun, DWORD blockNo, DiskCacheBlock** result);
+  DRESULT writeDirty(BYTE lun, DiskCacheBlock* block);
 };
 
 extern DiskCache diskCache;
 
 DRESULT disk_cache_read(BYTE drv, BYTE* buff, DWORD sector, UINT count);
 DRESULT disk_cache_write(BYTE drv, const BYTE* buff, DWORD sector, UINT count);
-
-
+DRESULT disk_cache_ioctl(BYTE drv, BYTE cmd, void* buff);
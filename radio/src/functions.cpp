@@ -377,8 +377,12 @@ void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext
           case FUNC_LOGS:
             if (CFN_PARAM(cfn)) {
               newActiveFunctions |= (1u << FUNCTION_LOGS);
-              logDelay100ms = CFN_PARAM(
-                  cfn);  // logging period is 0..25.5s in 100ms increments
+              logsFormat = CFN_LOGS_FORMAT(cfn);
+              // logging period is 0..25.5s in 100ms increments (CSV), or
+              // 0..2.55s in 10ms increments (binary formats)
+              logDelay10ms = (logsFormat != LOGS_FORMAT_CSV)
+                                 ? CFN_PARAM(cfn)
+                                 : CFN_PARAM(cfn) * 10;
             }
             break;
 #endif
@@ -75,6 +75,7 @@ void menuRadioHardware(event_t event);
 void menuRadioTools(event_t event);
 void menuRadioSpectrumAnalyser(event_t event);
 void menuRadioPowerMeter(event_t event);
+void menuRadioTelemetryStats(event_t event);
 void menuRadioCalibration(event_t event);
 void menuGhostModuleConfig(event_t event);
 
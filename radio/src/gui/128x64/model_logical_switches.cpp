@@ -168,7 +168,7 @@ void menuModelLogicalSwitchOne(event_t event)
             INCDEC_SET_FLAG(EE_MODEL | INCDEC_REP10 | NO_INCDEC_MARKS);
             if (cs->v2 < v2_min || cs->v2 > v2_max) {
               cs->v2 = 0;
-              storageDirty(EE_MODEL);
+              storageConfigDirty(EE_MODEL);
             }
           }
           else
@@ -240,11 +240,11 @@ void onLogicalSwitchesMenu(const char *result)
   }
   else if (result == STR_PASTE) {
     *cs = clipboard.data.csw;
-    storageDirty(EE_MODEL);
+    storageConfigDirty(EE_MODEL);
   }
   else if (result == STR_CLEAR) {
     memset(cs, 0, sizeof(LogicalSwitchData));
-    storageDirty(EE_MODEL);
+    storageConfigDirty(EE_MODEL);
   }
 }
 
@@ -35,6 +35,7 @@
 #define SD_LOGS_PERIOD_MIN      1     // 0.1s  fastest period 
 #define SD_LOGS_PERIOD_MAX      255   // 25.5s slowest period 
 #define SD_LOGS_PERIOD_DEFAULT  10    // 1s    default period for newly created SF 
+#define SD_LOGS_BINARY_PERIOD_MIN 2   // 0.02s fastest period in binary format
 
 void onCustomFunctionsFileSelectionMenu(const char * result)
 {
@@ -362,14 +363,15 @@ void menuSpecialFunctions(event_t event, CustomFunctionData * functions, CustomF
           }
 #if defined(SDCARD)
           else if (func == FUNC_LOGS) {
-            val_min = SD_LOGS_PERIOD_MIN; 
+            bool binary = (CFN_LOGS_FORMAT(cfn) != LOGS_FORMAT_CSV);
+            val_min = binary ? SD_LOGS_BINARY_PERIOD_MIN : SD_LOGS_PERIOD_MIN;
             val_max = SD_LOGS_PERIOD_MAX;
 
             if (!val_displayed) {
               val_displayed = CFN_PARAM(cfn) = SD_LOGS_PERIOD_DEFAULT;
             }
 
-            lcdDrawNumber(MODEL_SPECIAL_FUNC_3RD_COLUMN, y, val_displayed, attr|PREC1|LEFT);
+            lcdDrawNumber(MODEL_SPECIAL_FUNC_3RD_COLUMN, y, val_displayed, attr|(binary ? PREC2 : PREC1)|LEFT);
             lcdDrawChar(lcdLastRightPos, y, 's');
           }
 #endif
@@ -461,6 +463,18 @@ void menuSpecialFunctions(event_t event, CustomFunctionData * functions, CustomF
               if (active) CFN_PLAY_REPEAT(cfn) = checkIncDec(event, CFN_PLAY_REPEAT(cfn)==CFN_PLAY_REPEAT_NOSTART?-1:CFN_PLAY_REPEAT(cfn), -1, 60/CFN_PLAY_REPEAT_MUL, eeFlags);
             }
           }
+#if defined(SDCARD)
+          else if (func == FUNC_LOGS) {
+            lcdDrawChar(MODEL_SPECIAL_FUNC_4TH_COLUMN_ONOFF+1, y, logsFormatName(CFN_LOGS_FORMAT(cfn))[0], attr);
+            if (active) {
+              uint8_t format = checkIncDec(event, CFN_LOGS_FORMAT(cfn), LOGS_FORMAT_CSV, LOGS_FORMAT_LAST, eeFlags);
+              if (format != CFN_LOGS_FORMAT(cfn)) {
+                CFN_PARAM(cfn) = logsConvertPeriod(CFN_PARAM(cfn), CFN_LOGS_FORMAT(cfn), format);
+                CFN_LOGS_FORMAT(cfn) = format;
+              }
+            }
+          }
+#endif
           else if (attr) {
             repeatLastCursorMove(event);
           }
@@ -77,6 +77,7 @@ void menuRadioTools(event_t event);
 void menuRadioCalibration(event_t event);
 void menuRadioSpectrumAnalyser(event_t event);
 void menuRadioPowerMeter(event_t event);
+void menuRadioTelemetryStats(event_t event);
 void menuGhostModuleConfig(event_t event);
 
 extern const MenuHandler menuTabGeneral[MENU_RADIO_PAGES_COUNT];
@@ -76,11 +76,11 @@ void onCurveOneMenu(const char * result)
   }
   else if (result == STR_MIRROR) {
     curveMirror(s_currIdxSubMenu);
-    storageDirty(EE_MODEL);
+    storageConfigDirty(EE_MODEL);
   }
   else if (result == STR_CLEAR) {
     curveClear(s_currIdxSubMenu);
-    storageDirty(EE_MODEL);
+    storageConfigDirty(EE_MODEL);
   }
 }
 
@@ -66,11 +66,11 @@ void onLogicalSwitchesMenu(const char *result)
   }
   else if (result == STR_PASTE) {
     *cs = clipboard.data.csw;
-    storageDirty(EE_MODEL);
+    storageConfigDirty(EE_MODEL);
   }
   else if (result == STR_CLEAR) {
     memset(cs, 0, sizeof(LogicalSwitchData));
-    storageDirty(EE_MODEL);
+    storageConfigDirty(EE_MODEL);
   }
 }
 
@@ -236,7 +236,7 @@ void menuModelLogicalSwitches(event_t event)
             if (v1_val <= MIXSRC_LAST_CH) {
               cs->v2 = calcRESXto100(x);
             }
-            storageDirty(EE_MODEL);
+            storageConfigDirty(EE_MODEL);
           }
           break;
         case LS_FIELD_V3:
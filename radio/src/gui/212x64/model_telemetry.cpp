@@ -92,7 +92,7 @@ void onSensorMenu(const char * result)
         TelemetryItem & sourceItem = telemetryItems[index];
         TelemetryItem & newItem = telemetryItems[newIndex];
         newItem = sourceItem;
-        storageDirty(EE_MODEL);
+        storageConfigDirty(EE_MODEL);
       }
       else {
         POPUP_WARNING(STR_TELEMETRYFULL);
@@ -25,7 +25,7 @@
 #include "model_curves.h"
 #include "opentx.h"
 
-#define SET_DIRTY() storageDirty(EE_MODEL)
+#define SET_DIRTY() storageConfigDirty(EE_MODEL)
 
 void CurveParam::LongPressHandler(void* data)
 {
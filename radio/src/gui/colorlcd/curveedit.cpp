@@ -23,7 +23,7 @@
 #include "opentx.h" // TODO for applyCustomCurve
 #include "libopenui.h"
 
-#define SET_DIRTY()     storageDirty(EE_MODEL)
+#define SET_DIRTY()     storageConfigDirty(EE_MODEL)
 
 static const lv_coord_t default_col_dsc[] = {LV_GRID_CONTENT, LV_GRID_TEMPLATE_LAST};
 static const lv_coord_t default_row_dsc[] = {LV_GRID_CONTENT, LV_GRID_TEMPLATE_LAST};
@@ -66,7 +66,7 @@ void FMMatrix<T>::onPress(uint8_t btn_id)
   if (btn_id >= MAX_FLIGHT_MODES) return;
   BFBIT_FLIP(input->flightModes, bfBit<uint32_t>(btn_id));
   setTextAndState(btn_id);
-  storageDirty(EE_MODEL);
+  storageConfigDirty(EE_MODEL);
 }
 
 template<class T>
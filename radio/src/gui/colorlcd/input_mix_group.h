@@ -58,6 +58,7 @@ class InputMixGroup : public Window
   bool mixerMonitorEnabled() { return monitor != nullptr; }
     
   mixsrc_t getMixSrc() { return idx; }
+  lv_obj_t* getLabel() { return label; }
   size_t getLineCount() { return lines.size(); }
   
   void addLine(Window* line, const uint8_t* symbol = nullptr);
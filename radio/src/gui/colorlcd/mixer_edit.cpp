@@ -28,7 +28,7 @@
 
 #include "opentx.h"
 
-#define SET_DIRTY() storageDirty(EE_MODEL)
+#define SET_DIRTY() storageConfigDirty(EE_MODEL)
 
 #if (LCD_W > LCD_H)
   #define MIX_STATUS_BAR_WIDTH 250
@@ -26,7 +26,7 @@
 
 #include "opentx.h"
 
-#define SET_DIRTY() storageDirty(EE_MODEL)
+#define SET_DIRTY() storageConfigDirty(EE_MODEL)
 
 MixEditAdvanced::MixEditAdvanced(int8_t channel, uint8_t index) :
     Page(ICON_MODEL_MIXER), channel(channel), index(index)
@@ -23,7 +23,7 @@
 #include "opentx.h"
 #include "libopenui.h"
 
-#define SET_DIRTY() storageDirty(EE_MODEL)
+#define SET_DIRTY() storageConfigDirty(EE_MODEL)
 
 #define PREVIEW_PAD 9
 #define TITLE_H     20
@@ -152,7 +152,7 @@ void ModelCurvesPage::presetMenu(FormWindow * window, uint8_t index)
        resetCustomCurveX(points, 5 + curve.points);
       }
 
-      storageDirty(EE_MODEL);
+      storageConfigDirty(EE_MODEL);
       rebuild(window);
     });
   }
@@ -232,12 +232,12 @@ void ModelCurvesPage::build(FormWindow * window)
           menu->addLine(STR_CURVE_PRESET, [=]() { presetMenu(window, index); });
           menu->addLine(STR_MIRROR, [=]() {
               curveMirror(index);
-              storageDirty(EE_MODEL);
+              storageConfigDirty(EE_MODEL);
               button->invalidate();
           });
           menu->addLine(STR_CLEAR, [=]() {
               curveClear(index);
-              storageDirty(EE_MODEL);
+              storageConfigDirty(EE_MODEL);
               rebuild(window);
           });
           return 0;
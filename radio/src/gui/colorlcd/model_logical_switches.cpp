@@ -24,7 +24,7 @@
 #include "libopenui.h"
 #include "switches.h"
 
-#define SET_DIRTY() storageDirty(EE_MODEL)
+#define SET_DIRTY() storageConfigDirty(EE_MODEL)
 
 static const lv_coord_t col_dsc[] = {LV_GRID_FR(2), LV_GRID_FR(3),
                                      LV_GRID_TEMPLATE_LAST};
@@ -532,7 +532,7 @@ void ModelLogicalSwitchesPage::newLS(FormWindow* window, bool pasteLS)
       menu->addLineBuffered(ch_name.c_str(), [=]() {
         if (pasteLS) {
           *ls = clipboard.data.csw;
-          storageDirty(EE_MODEL);
+          storageConfigDirty(EE_MODEL);
           focusIndex = i;
           rebuild(window);
         } else {
@@ -608,14 +608,14 @@ void ModelLogicalSwitchesPage::build(FormWindow* window)
         if (clipboard.type == CLIPBOARD_TYPE_CUSTOM_SWITCH)
           menu->addLine(STR_PASTE, [=]() {
             *ls = clipboard.data.csw;
-            storageDirty(EE_MODEL);
+            storageConfigDirty(EE_MODEL);
             rebuild(window);
           });
         if (isActive || ls->v1 || ls->v2 || ls->delay || ls->duration ||
             ls->andsw) {
           menu->addLine(STR_CLEAR, [=]() {
             memset(ls, 0, sizeof(LogicalSwitchData));
-            storageDirty(EE_MODEL);
+            storageConfigDirty(EE_MODEL);
             rebuild(window);
           });
         }
@@ -36,7 +36,7 @@
 #include "tasks/mixer_task.h"
 #include "hal/adc_driver.h"
 
-#define SET_DIRTY()     storageDirty(EE_MODEL)
+#define SET_DIRTY()     storageConfigDirty(EE_MODEL)
 #define PASTE_BEFORE    -2
 #define PASTE_AFTER     -1
 
@@ -216,9 +216,33 @@ InputMixGroup* ModelMixesPage::getGroupByIndex(uint8_t index)
   return getGroupBySrc(MIXSRC_FIRST_CH + ch);
 }
 
+// Channel group, flagged while the channel is part of a loop
+class MixGroup : public InputMixGroup
+{
+  bitfield_channels_t mask;
+
+ public:
+  MixGroup(Window* parent, mixsrc_t idx) :
+      InputMixGroup(parent, idx),
+      mask((bitfield_channels_t)1 << (idx - MIXSRC_FIRST_CH))
+  {
+    lv_obj_set_style_text_color(getLabel(), makeLvColor(COLOR_THEME_WARNING),
+                                LV_STATE_USER_1);
+  }
+
+  void checkEvents() override
+  {
+    InputMixGroup::checkEvents();
+    if (getMixerLoopChannels() & mask)
+      lv_obj_add_state(getLabel(), LV_STATE_USER_1);
+    else
+      lv_obj_clear_state(getLabel(), LV_STATE_USER_1);
+  }
+};
+
 InputMixGroup* ModelMixesPage::createGroup(FormWindow* form, mixsrc_t src)
 {
-  auto group = new InputMixGroup(form, src);
+  auto group = new MixGroup(form, src);
   if (showMonitors) group->enableMixerMonitor(src - MIXSRC_FIRST_CH);
   return group;
 }
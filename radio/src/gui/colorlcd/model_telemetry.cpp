@@ -25,7 +25,7 @@
 #include "opentx.h"
 #include "libopenui.h"
 
-#define SET_DIRTY() storageDirty(EE_MODEL)
+#define SET_DIRTY() storageConfigDirty(EE_MODEL)
 
 std::string getSensorCustomValue(uint8_t sensor, int32_t value, LcdFlags flags);
 
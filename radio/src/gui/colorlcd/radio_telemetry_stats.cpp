@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "radio_telemetry_stats.h"
+#include "opentx.h"
+#include "libopenui.h"
+#include "telemetry/telemetry_stats.h"
+
+constexpr coord_t STATS_LINE_HEIGHT = 24;
+constexpr coord_t STATS_HEIGHT = 8 * STATS_LINE_HEIGHT;
+
+class TelemetryStatsWindow: public Window
+{
+  public:
+    TelemetryStatsWindow(Window * parent, const rect_t & rect) :
+      Window(parent, rect, REFRESH_ALWAYS)
+    {
+    }
+
+    void paint(BitmapBuffer * dc) override
+    {
+      static const char * const labels[] = {
+        STR_STATS_FRAMES, STR_STATS_BYTES, STR_STATS_CRC_ERRORS,
+        STR_STATS_SIZE_ERRORS, STR_STATS_OVERRUNS, STR_STATS_LATENCY,
+        STR_STATS_MAX_LATENCY,
+      };
+
+      coord_t intColumn = width() * 3 / 4 - 8;
+      coord_t extColumn = width() - 8;
+
+      coord_t y = 2;
+      dc->drawText(intColumn, y, STR_STATS_INT, COLOR_THEME_PRIMARY1 | FONT(BOLD) | RIGHT);
+      dc->drawText(extColumn, y, STR_STATS_EXT, COLOR_THEME_PRIMARY1 | FONT(BOLD) | RIGHT);
+
+      TelemetryStats stats[NUM_MODULES];
+      for (uint8_t module = 0; module < NUM_MODULES; module++) {
+        telemetryStatsGet(module, stats[module]);
+      }
+
+      for (uint8_t i = 0; i < DIM(labels); i++) {
+        y += STATS_LINE_HEIGHT;
+        dc->drawText(8, y, labels[i], COLOR_THEME_PRIMARY1);
+        for (uint8_t module = 0; module < NUM_MODULES; module++) {
+          const TelemetryStats & s = stats[module];
+          uint32_t value = 0;
+          switch (i) {
+            case 0: value = s.frames; break;
+            case 1: value = s.bytes; break;
+            case 2: value = s.crcErrors; break;
+            case 3: value = s.sizeErrors; break;
+            case 4: value = s.overruns; break;
+            case 5: value = s.lastLatency; break;
+            case 6: value = s.maxLatency; break;
+          }
+          dc->drawNumber(module == INTERNAL_MODULE ? intColumn : extColumn, y,
+                         value, COLOR_THEME_PRIMARY1 | RIGHT);
+        }
+      }
+    }
+};
+
+RadioTelemetryStats::RadioTelemetryStats() :
+  Page(ICON_RADIO_TOOLS)
+{
+  buildHeader(&header);
+  buildBody(&body);
+}
+
+void RadioTelemetryStats::buildHeader(Window * window)
+{
+  header.setTitle(STR_MENUTOOLS);
+  header.setTitle2(STR_TELEMETRY_STATS);
+}
+
+void RadioTelemetryStats::buildBody(FormWindow * window)
+{
+  new TelemetryStatsWindow(window, {0, 0, LCD_W, STATS_HEIGHT});
+  new TextButton(window, {8, STATS_HEIGHT + 4, LCD_W / 3, LV_DPI_DEF / 3},
+                 STR_RESET, []() {
+                   telemetryStatsReset();
+                   return 0;
+                 });
+}
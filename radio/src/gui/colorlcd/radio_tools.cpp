@@ -22,6 +22,7 @@
 #include <algorithm>
 #include "radio_tools.h"
 #include "radio_spectrum_analyser.h"
+#include "radio_telemetry_stats.h"
 #include "radio_ghost_module_config.h"
 #include "opentx.h"
 #include "libopenui.h"
@@ -168,6 +169,11 @@ static void run_ghost_config(Window* parent, const std::string&)
 }
 #endif
 
+static void run_telemetry_stats(Window* parent, const std::string&)
+{
+  new RadioTelemetryStats();
+}
+
 struct ToolButton : public TextButton {
   ToolButton(Window* parent, const ToolEntry& tool) :
     TextButton(parent, rect_t{}, tool.label, [=]() {
@@ -237,6 +243,8 @@ void RadioToolsPage::rebuild(FormWindow * window)
   }
 #endif
 
+  tools.emplace_back(ToolEntry{ STR_TELEMETRY_STATS, {}, run_telemetry_stats });
+
 #if defined(LUA)
   scanLuaTools(tools);
 #endif
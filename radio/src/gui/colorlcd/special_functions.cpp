@@ -237,11 +237,29 @@ class SpecialFunctionEditPage : public Page
         if(CFN_PARAM(cfn) == 0)                           // use stored value if SF exists
           CFN_PARAM(cfn) = SD_LOGS_PERIOD_DEFAULT;        // otherwise initialize with default value
 
-        auto edit = addNumberEdit(line, STR_INTERVAL, cfn, SD_LOGS_PERIOD_MIN, SD_LOGS_PERIOD_MAX);
+        new StaticText(line, rect_t{}, STR_TYPE, 0, COLOR_THEME_PRIMARY1);
+        auto format = new Choice(line, rect_t{}, LOGS_FORMAT_CSV,
+                                 LOGS_FORMAT_LAST,
+                                 GET_DEFAULT(CFN_LOGS_FORMAT(cfn)), nullptr);
+        format->setTextHandler([](int32_t value) {
+          return std::string(logsFormatName(value));
+        });
+        format->setSetValueHandler([=](int32_t newValue) {
+          CFN_PARAM(cfn) = logsConvertPeriod(CFN_PARAM(cfn), CFN_LOGS_FORMAT(cfn), newValue);
+          CFN_LOGS_FORMAT(cfn) = newValue;
+          SET_DIRTY();
+          updateSpecialFunctionOneWindow();
+        });
+        line = specialFunctionOneWindow->newLine(&grid);
+
+        bool binary = (CFN_LOGS_FORMAT(cfn) != LOGS_FORMAT_CSV);
+        auto edit = addNumberEdit(line, STR_INTERVAL, cfn,
+                                  binary ? SD_LOGS_BINARY_PERIOD_MIN : SD_LOGS_PERIOD_MIN,
+                                  SD_LOGS_PERIOD_MAX);
         edit->setDefault(SD_LOGS_PERIOD_DEFAULT);         // set default period for DEF button
         edit->setDisplayHandler(
             [=](int32_t value) {
-              return formatNumberAsString(CFN_PARAM(cfn), PREC1, 0, nullptr, "s");
+              return formatNumberAsString(CFN_PARAM(cfn), binary ? PREC2 : PREC1, 0, nullptr, "s");
             });
         break;
       }
@@ -635,7 +653,13 @@ class SpecialFunctionButton : public Button
         break;
 
       case FUNC_LOGS:
-        strcat(s, formatNumberAsString(CFN_PARAM(cfn), PREC1, 0, nullptr, "s").c_str());
+        strcat(s, formatNumberAsString(CFN_PARAM(cfn),
+                                       CFN_LOGS_FORMAT(cfn) != LOGS_FORMAT_CSV ? PREC2 : PREC1,
+                                       0, nullptr, "s").c_str());
+        if (CFN_LOGS_FORMAT(cfn) != LOGS_FORMAT_CSV) {
+          strcat(s, " ");
+          strcat(s, logsFormatName(CFN_LOGS_FORMAT(cfn)));
+        }
         break;
 
       case FUNC_ADJUST_GVAR:
@@ -25,6 +25,7 @@
 #define SD_LOGS_PERIOD_MIN      1     // 0.1s  fastest period 
 #define SD_LOGS_PERIOD_MAX      255   // 25.5s slowest period 
 #define SD_LOGS_PERIOD_DEFAULT  10    // 1s    default period for newly created SF 
+#define SD_LOGS_BINARY_PERIOD_MIN 2   // 0.02s fastest period in binary format
 
 #include "tabsgroup.h"
 
@@ -194,7 +194,7 @@ void menuModelMixAll(event_t event)
               s_currIdx = moveMix(s_currIdx, s_copyTgtOfs > 0);
               s_copyTgtOfs += (s_copyTgtOfs < 0 ? +1 : -1);
             } while (s_copyTgtOfs != 0);
-            storageDirty(EE_MODEL);
+            storageConfigDirty(EE_MODEL);
           }
           menuVerticalPosition = s_copySrcRow + HEADER_LINE;
           s_copyTgtOfs = 0;
@@ -323,7 +323,9 @@ void menuModelMixAll(event_t event)
     MixData * md = mixAddress(i);
     if (i < getMixCount() && (md->destCh + 1 == ch)) {
       if (cur-menuVerticalOffset >= 0 && cur-menuVerticalOffset < NUM_BODY_LINES) {
-        putsChn(0, y, ch, 0); // show CHx
+        // channels in a loop blink
+        bool loop = getMixerLoopChannels() & ((bitfield_channels_t)1 << (ch - 1));
+        putsChn(0, y, ch, loop ? BLINK : 0); // show CHx
       }
       uint8_t mixCnt = 0;
       do {
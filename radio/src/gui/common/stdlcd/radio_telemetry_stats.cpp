@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "opentx.h"
+#include "telemetry/telemetry_stats.h"
+
+#define STATS_INT_COLUMN               (13*FW)
+#define STATS_EXT_COLUMN               (LCD_W - 1)
+
+void menuRadioTelemetryStats(event_t event)
+{
+  SIMPLE_SUBMENU(STR_TELEMETRY_STATS, 0);
+
+  if (event == EVT_KEY_LONG(KEY_ENTER)) {
+    killEvents(event);
+    telemetryStatsReset();
+  }
+
+  TelemetryStats stats[NUM_MODULES];
+  for (uint8_t module = 0; module < NUM_MODULES; module++) {
+    telemetryStatsGet(module, stats[module]);
+  }
+
+  coord_t y = MENU_HEADER_HEIGHT + 1;
+  lcdDrawText(STATS_INT_COLUMN, y, STR_STATS_INT, RIGHT | BOLD);
+  lcdDrawText(STATS_EXT_COLUMN, y, STR_STATS_EXT, RIGHT | BOLD);
+
+  static const char * const labels[] = {
+    STR_STATS_FRAMES, STR_STATS_BYTES, STR_STATS_CRC_ERRORS,
+    STR_STATS_SIZE_ERRORS, STR_STATS_OVERRUNS, STR_STATS_MAX_LATENCY,
+  };
+
+  for (uint8_t i = 0; i < DIM(labels); i++) {
+    y += FH;
+    lcdDrawText(0, y, labels[i]);
+    for (uint8_t module = 0; module < NUM_MODULES; module++) {
+      const TelemetryStats & s = stats[module];
+      uint32_t value = 0;
+      switch (i) {
+        case 0: value = s.frames; break;
+        case 1: value = s.bytes; break;
+        case 2: value = s.crcErrors; break;
+        case 3: value = s.sizeErrors; break;
+        case 4: value = s.overruns; break;
+        case 5: value = s.maxLatency; break;
+      }
+      lcdDrawNumber(module == INTERNAL_MODULE ? STATS_INT_COLUMN : STATS_EXT_COLUMN,
+                    y, value, RIGHT);
+    }
+  }
+}
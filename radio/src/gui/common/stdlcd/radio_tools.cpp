@@ -195,6 +195,10 @@ void menuRadioTools(event_t event)
 
 #endif
 
+  if (addRadioTool(index++, STR_TELEMETRY_STATS)) {
+    pushMenu(menuRadioTelemetryStats);
+  }
+
   if (index == 0) {
     lcdDrawCenteredText(LCD_H/2, STR_NO_TOOLS);
   }
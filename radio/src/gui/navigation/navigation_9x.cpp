@@ -129,7 +129,7 @@ int checkIncDec(event_t event, int val, int i_min, int i_max,
     if (!IS_KEY_REPT(event)) {
       AUDIO_KEY_PRESS();
     }
-    storageDirty(i_flags & (EE_GENERAL|EE_MODEL));
+    storageConfigDirty(i_flags & (EE_GENERAL|EE_MODEL));
     checkIncDec_Ret = (newval > val ? 1 : -1);
   }
   else {
@@ -120,7 +120,7 @@ int checkIncDec(event_t event, int val, int i_min, int i_max,
   }
 
   if (newval != val) {
-    storageDirty(i_flags & (EE_GENERAL|EE_MODEL));
+    storageConfigDirty(i_flags & (EE_GENERAL|EE_MODEL));
     checkIncDec_Ret = (newval > val ? 1 : -1);
   }
   else {
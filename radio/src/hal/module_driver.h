@@ -53,8 +53,8 @@ struct etx_proto_driver_t {
     // Send the next pulse frame
     void (*sendPulses)(void* ctx, uint8_t* buffer, int16_t* channels, uint8_t nChannels);
 
-    // Process input data byte (telemetry)
-    void (*processData)(void* ctx, uint8_t data, uint8_t* buffer, uint8_t* len);
+    // Process input data bytes (telemetry), as many as received
+    void (*processData)(void* ctx, const uint8_t* data, uint8_t dlen, uint8_t* buf, uint8_t* len);
 
     // Process input data byte (telemetry)
     void (*processFrame)(void* ctx, uint8_t* frame, uint8_t flen, uint8_t* buf, uint8_t* len);
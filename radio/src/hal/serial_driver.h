@@ -57,6 +57,7 @@ struct etx_serial_callbacks_t {
   void* on_idle_ctx;
   void (*on_idle)(void* ctx);
 
+  // RX overrun (data lost)
   void (*on_error)();
 };
 
@@ -99,6 +100,15 @@ typedef struct {
 
   int (*copyRxBuffer)(void* ctx, uint8_t* buf, uint32_t len);
 
+  // Copy the next frame delimited by an idle line
+  // (returns -1 if no idle callback has been set, see setIdleCb;
+  //  frames longer than len are returned over several calls)
+  int (*copyRxFrame)(void* ctx, uint8_t* buf, uint32_t len);
+
+  // Return the number of RX overruns since the last call
+  // (frames merged or bytes lost before being read)
+  uint32_t (*getRxOverruns)(void* ctx);
+
   // Clear internal buffer
   void (*clearRxBuffer)(void* ctx);
 
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+// RX frames delimited by an idle line in a circular RX buffer.
+//
+// Only the RX buffer write index at the end of each frame is recorded:
+// single producer (IDLE IRQ), single consumer (copyFrame).
+// Trivial type: zero it (static storage, memset or value-init) before use.
+template <int N>
+class SerialFrameRing
+{
+  static_assert((N > 1) & !(N & (N - 1)), "Ring size must be a power of two!");
+
+  public:
+    void clear()
+    {
+      ridx = widx;
+    }
+
+    // Record the end of a frame (IRQ context). When the ring is full,
+    // the frame is merged into the next one and counted as an overrun.
+    void push(uint32_t end)
+    {
+      uint8_t next = (widx + 1) & (N - 1);
+      if (next == ridx) {
+        overruns++;
+        return;
+      }
+      ends[widx] = end;
+      widx = next;
+    }
+
+    // Record bytes lost before reaching the RX buffer (IRQ context)
+    void overrun()
+    {
+      overruns++;
+    }
+
+    // Number of overruns since the last call
+    uint32_t takeOverruns()
+    {
+      uint32_t count = overruns;
+      uint32_t res = count - reportedOverruns;
+      reportedOverruns = count;
+      return res;
+    }
+
+    // Copy the next frame from 'rx' ('rx_len' bytes, read from 'rx_ridx')
+    // into 'buf'. Frames longer than 'len' are returned over several calls.
+    int copyFrame(const uint8_t* rx, uint32_t rx_len, volatile uint32_t& rx_ridx,
+                  uint8_t* buf, uint32_t len)
+    {
+      // skip empty frames (IDLE without any data)
+      uint32_t frame_len = 0;
+      while (!frame_len) {
+        if (ridx == widx) return 0;
+        frame_len = (ends[ridx] - rx_ridx) & (rx_len - 1);
+        if (!frame_len) ridx = (ridx + 1) & (N - 1);
+      }
+
+      uint32_t res = frame_len < len ? frame_len : len;
+      uint32_t cp_len = rx_len - rx_ridx;
+      if (cp_len > res) cp_len = res;
+      memcpy(buf, rx + rx_ridx, cp_len);
+      memcpy(buf + cp_len, rx, res - cp_len);
+      rx_ridx = (rx_ridx + res) & (rx_len - 1);
+
+      // keep the remainder of the frame for the next call
+      if (res == frame_len) ridx = (ridx + 1) & (N - 1);
+
+      return res;
+    }
+
+  protected:
+    volatile uint16_t ends[N];
+    volatile uint8_t ridx;
+    volatile uint8_t widx;
+    volatile uint32_t overruns;
+    uint32_t reportedOverruns;
+};
@@ -44,7 +44,7 @@
     .status = _STORAGE_DRIVER.status,
     .read = disk_cache_read,
     .write = disk_cache_write,
-    .ioctl = _STORAGE_DRIVER.ioctl,
+    .ioctl = disk_cache_ioctl,
   };
 #endif
 
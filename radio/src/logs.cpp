@@ -26,13 +26,17 @@
 #include "switches.h"
 #include "hal/adc_driver.h"
 #include "hal/switch_driver.h"
+#include "logs_binary.h"
+#include "logs_capture.h"
 
 #if defined(LIBOPENUI)
   #include "libopenui.h"
 #endif
 
 FIL g_oLogFile __DMA;
-uint8_t logDelay100ms;
+uint16_t logDelay10ms;
+uint8_t logsFormat = LOGS_FORMAT_CSV;
+static uint8_t logsOpenFormat = LOGS_FORMAT_CSV;
 static tmr10ms_t lastLogTime = 0;
 
 #if !defined(SIMU)
@@ -58,7 +62,7 @@ void loggingTimerStart()
 {
   if (!loggingTimer) {
     loggingTimer =
-        xTimerCreateStatic("Logging", logDelay100ms*100 / RTOS_MS_PER_TICK, pdTRUE, (void*)0,
+        xTimerCreateStatic("Logging", logDelay10ms*10 / RTOS_MS_PER_TICK, pdTRUE, (void*)0,
                            loggingTimerCb, &loggingTimerBuffer);
   }
 
@@ -80,18 +84,18 @@ void loggingTimerStop()
 }
 
 void initLoggingTimer() {                                       // called cyclically by main.cpp:perMain()
-  static uint8_t logDelay100msOld = 0;
+  static uint16_t logDelay10msOld = 0;
 
   if(loggingTimer == nullptr) {                                 // log Timer not running
-    if(isFunctionActive(FUNCTION_LOGS) && logDelay100ms > 0) {  // if SF Logging is active and log rate is valid
+    if(isFunctionActive(FUNCTION_LOGS) && logDelay10ms > 0) {   // if SF Logging is active and log rate is valid
       loggingTimerStart();                                      // start log timer
     }  
   } else {                                                      // log timer is already running
-    if(logDelay100msOld != logDelay100ms) {                     // if log rate was changed
-      logDelay100msOld = logDelay100ms;                         // memorize new log rate
+    if(logDelay10msOld != logDelay10ms) {                       // if log rate was changed
+      logDelay10msOld = logDelay10ms;                           // memorize new log rate
 
-      if(logDelay100ms > 0) {
-        if(xTimerChangePeriod( loggingTimer, logDelay100ms*100, 0 ) != pdPASS ) {  // and restart timer with new log rate
+      if(logDelay10ms > 0) {
+        if(xTimerChangePeriod( loggingTimer, logDelay10ms*10 / RTOS_MS_PER_TICK, 0 ) != pdPASS ) {  // and restart timer with new log rate
           /* The timer period could not be changed */
         }
       }
@@ -165,23 +169,79 @@ const char * logsOpen()
   tmp = strAppendDate(tmp, true);
 #endif
 
-  strcpy(tmp, STR_LOGS_EXT);
+  if (logsFormat != LOGS_FORMAT_CSV) {
+    // binary logs cannot be appended to, as the columns may differ
+    const char * ext = (logsFormat == LOGS_FORMAT_CAPTURE) ? LOGS_CAPTURE_EXT : LOGS_BINARY_EXT;
+    strcpy(tmp, ext);
+    result = f_open(&g_oLogFile, filename, FA_CREATE_NEW | FA_WRITE);
+    for (uint8_t index = 2; result == FR_EXIST && index < 100; index++) {
+      sprintf(tmp, "-%d%s", index, ext);
+      result = f_open(&g_oLogFile, filename, FA_CREATE_NEW | FA_WRITE);
+    }
+  }
+  else {
+    strcpy(tmp, STR_LOGS_EXT);
+    result = f_open(&g_oLogFile, filename, FA_OPEN_ALWAYS | FA_WRITE | FA_OPEN_APPEND);
+  }
 
-  result = f_open(&g_oLogFile, filename, FA_OPEN_ALWAYS | FA_WRITE | FA_OPEN_APPEND);
   if (result != FR_OK) {
     return SDCARD_ERROR(result);
   }
 
-  if (f_size(&g_oLogFile) == 0) {
+  logsOpenFormat = logsFormat;
+
+  if (logsOpenFormat == LOGS_FORMAT_BINARY) {
+    if (!logsBinaryOpen(logDelay10ms * 10)) {
+      logsClose();
+      return STR_SDCARD_ERROR;
+    }
+  }
+  else if (logsOpenFormat == LOGS_FORMAT_CAPTURE) {
+    if (!logsCaptureOpen()) {
+      logsClose();
+      return STR_SDCARD_ERROR;
+    }
+  }
+  else if (f_size(&g_oLogFile) == 0) {
     writeHeader();
   }
 
   return nullptr;
 }
 
+const char * logsFormatName(uint8_t format)
+{
+  switch (format) {
+    case LOGS_FORMAT_BINARY:
+      return STR_LOGS_FORMAT_BINARY;
+    case LOGS_FORMAT_CAPTURE:
+      return STR_LOGS_FORMAT_RAW;
+    default:
+      return STR_LOGS_FORMAT_CSV;
+  }
+}
+
+// Converts a SD Logs period when switching to another format:
+// 100ms steps for CSV, 10ms steps for the binary formats
+uint8_t logsConvertPeriod(uint8_t period, uint8_t from, uint8_t to)
+{
+  if (from == LOGS_FORMAT_CSV && to != LOGS_FORMAT_CSV)
+    return min<int>(period * 10, 255);
+  else if (from != LOGS_FORMAT_CSV && to == LOGS_FORMAT_CSV)
+    return max<int>(period / 10, 1);
+  else
+    return period;
+}
+
 void logsClose()
 {
   if (g_oLogFile.obj.fs && sdMounted()) {
+    if (logsOpenFormat == LOGS_FORMAT_BINARY) {
+      logsBinaryClose();
+    }
+    else if (logsOpenFormat == LOGS_FORMAT_CAPTURE) {
+      logsCaptureClose();
+    }
     if (f_close(&g_oLogFile) != FR_OK) {
       // close failed, forget file
       g_oLogFile.obj.fs = 0;
@@ -191,6 +251,21 @@ void logsClose()
 
 }
 
+// Sensor label followed by its unit, e.g. "RSSI(dB)"
+void getLogsSensorLabel(char * label, uint8_t index)
+{
+  TelemetrySensor & sensor = g_model.telemetrySensors[index];
+  memset(label, 0, TELEM_LABEL_LEN + 1);
+  strncpy(label, sensor.label, TELEM_LABEL_LEN);
+  uint8_t unit = sensor.unit;
+  if (unit == UNIT_CELLS ) unit = UNIT_VOLTS;
+  if (UNIT_RAW < unit && unit < UNIT_FIRST_VIRTUAL) {
+    strcat(label, "(");
+    strncat(label, STR_VTELEMUNIT[unit], 3);
+    strcat(label, ")");
+  }
+}
+
 void writeHeader()
 {
 #if defined(RTCLOCK)
@@ -205,15 +280,7 @@ void writeHeader()
     if (isTelemetryFieldAvailable(i)) {
       TelemetrySensor & sensor = g_model.telemetrySensors[i];
       if (sensor.logs) {
-        memset(label, 0, sizeof(label));
-        strncpy(label, sensor.label, TELEM_LABEL_LEN);
-        uint8_t unit = sensor.unit;
-        if (unit == UNIT_CELLS ) unit = UNIT_VOLTS;
-        if (UNIT_RAW < unit && unit < UNIT_FIRST_VIRTUAL) {
-          strcat(label, "(");
-          strncat(label, STR_VTELEMUNIT[unit], 3);
-          strcat(label, ")");
-        }
+        getLogsSensorLabel(label, i);
         strcat(label, ",");
         f_puts(label, &g_oLogFile);
       }
@@ -271,10 +338,10 @@ void logsWrite()
     return;
   }
 
-  if (isFunctionActive(FUNCTION_LOGS) && logDelay100ms > 0 && !usbPlugged()) {
+  if (isFunctionActive(FUNCTION_LOGS) && logDelay10ms > 0 && !usbPlugged()) {
     #if defined(SIMU) || !defined(RTCLOCK)
     tmr10ms_t tmr10ms = get_tmr10ms();                                        // tmr10ms works in 10ms increments
-    if (lastLogTime == 0 || (tmr10ms_t)(tmr10ms - lastLogTime) >= (tmr10ms_t)(logDelay100ms*10)-1) {
+    if (lastLogTime == 0 || (tmr10ms_t)(tmr10ms - lastLogTime) >= (tmr10ms_t)logDelay10ms-1) {
       lastLogTime = tmr10ms;
     #else
     {
@@ -282,6 +349,11 @@ void logsWrite()
 
       bool sdCardFull = sdIsFull();
 
+      // log format changed: start a new file
+      if (g_oLogFile.obj.fs && logsOpenFormat != logsFormat) {
+        logsClose();
+      }
+
       // check if file needs to be opened
       if (!g_oLogFile.obj.fs) {
         const char *result = sdCardFull ? STR_SDCARD_FULL_EXT : logsOpen();
@@ -304,6 +376,21 @@ void logsWrite()
         return;
       }
 
+      if (logsOpenFormat != LOGS_FORMAT_CSV) {
+        if (logsOpenFormat == LOGS_FORMAT_CAPTURE)
+          logsCaptureChannels();
+        else
+          logsBinaryWrite();
+#if defined(SIMU)
+        logsBinaryFlush(false);
+#endif
+        if (logsBinaryWriteError() && !error_displayed) {
+          error_displayed = STR_SDCARD_ERROR;
+          POPUP_WARNING_ON_UI_TASK(STR_SDCARD_ERROR, nullptr, false);
+          logsClose();
+        }
+        return;
+      }
 
 #if defined(RTCLOCK)
       {
@@ -0,0 +1,464 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "opentx.h"
+#include "logs_binary.h"
+
+#include "analogs.h"
+#include "switches.h"
+#include "tasks.h"
+#include "hal/adc_driver.h"
+#include "hal/switch_driver.h"
+
+// Records are appended to one half of the buffer while the writer task
+// flushes the other one in a single, sector aligned, f_write().
+// The buffer and the writer task are allocated when the first binary
+// log is opened, and kept afterwards.
+#if defined(COLORLCD)
+  #define LOGS_BUFFER_SIZE     (8 * LOGS_BINARY_SECTOR_SIZE)
+#else
+  #define LOGS_BUFFER_SIZE     (4 * LOGS_BINARY_SECTOR_SIZE)
+#endif
+
+typedef uint8_t LogsBufferHalf[LOGS_BUFFER_SIZE];
+
+enum LogsColumnSource {
+  LOGS_SOURCE_SENSOR,
+  LOGS_SOURCE_MAIN,
+  LOGS_SOURCE_POT,
+  LOGS_SOURCE_SWITCH,
+  LOGS_SOURCE_LS,
+  LOGS_SOURCE_CHANNEL,
+  LOGS_SOURCE_TX_VOLTAGE,
+};
+
+struct LogsColumn {
+  uint8_t source;
+  uint8_t index;
+};
+
+#define LOGS_MAX_COLUMNS \
+  (MAX_TELEMETRY_SENSORS + MAX_ANALOG_INPUTS + MAX_SWITCHES + \
+   MAX_OUTPUT_CHANNELS + 2)
+
+static LogsColumn logsColumns[LOGS_MAX_COLUMNS];
+static uint8_t logsColumnsCount = 0;
+static uint16_t logsRecordSize = 0;
+static uint32_t logsStartTime = 0;
+
+static LogsBufferHalf * logsBuffer = nullptr;
+static uint8_t logsBufferCurrent = 0;
+static uint16_t logsBufferPos = 0;
+static volatile bool logsBufferReady[2];  // halves waiting for the writer
+static volatile bool logsRecording = false;
+
+static uint32_t logsDropped = 0;
+static volatile uint32_t logsBusy = 0;     // appends dropped on a busy buffer
+static volatile bool logsError = false;
+
+static RTOS_MUTEX_HANDLE logsMutex;        // SD card writes
+static RTOS_MUTEX_HANDLE logsBufferMutex;  // records appending
+
+int getSwitchState(uint8_t swtch);
+uint32_t getLogicalSwitchesStates(uint8_t first);
+void getLogsSensorLabel(char * label, uint8_t index);
+
+static void addColumn(LogsBinaryColumn & column, uint8_t source, uint8_t index)
+{
+  logsColumns[logsColumnsCount].source = source;
+  logsColumns[logsColumnsCount].index = index;
+  logsColumnsCount++;
+
+  if (column.size == 0) column.size = sizeof(int32_t);
+  logsRecordSize += column.size;
+
+  UINT written;
+  f_write(&g_oLogFile, &column, sizeof(column), &written);
+}
+
+static void setColumnName(LogsBinaryColumn & column, const char * name)
+{
+  memclear(&column, sizeof(column));
+  strncpy(column.name, name, LOGS_BINARY_NAME_LEN);
+}
+
+// Column descriptors are written while the columns are enumerated:
+// this must follow the same order as the header
+static void writeColumns()
+{
+  LogsBinaryColumn column;
+  char label[TELEM_LABEL_LEN + 7];
+
+  for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+    if (!isTelemetryFieldAvailable(i)) continue;
+    TelemetrySensor & sensor = g_model.telemetrySensors[i];
+    if (!sensor.logs || sensor.unit == UNIT_TEXT) continue;
+    getLogsSensorLabel(label, i);
+    setColumnName(column, label);
+    if (sensor.unit == UNIT_GPS) {
+      column.type = LOGS_COLUMN_GPS;
+      column.prec = 6;
+      column.size = 2 * sizeof(int32_t);
+    } else if (sensor.unit == UNIT_DATETIME) {
+      column.type = LOGS_COLUMN_DATETIME;
+      column.size = 2 * sizeof(int32_t);
+    } else {
+      column.prec = sensor.prec;
+    }
+    addColumn(column, LOGS_SOURCE_SENSOR, i);
+  }
+
+  auto n_inputs = adcGetMaxInputs(ADC_INPUT_MAIN);
+  for (uint8_t i = 0; i < n_inputs; i++) {
+    setColumnName(column, analogGetCanonicalName(ADC_INPUT_MAIN, i));
+    addColumn(column, LOGS_SOURCE_MAIN, i);
+  }
+
+  n_inputs = adcGetMaxInputs(ADC_INPUT_POT);
+  for (uint8_t i = 0; i < n_inputs; i++) {
+    if (!IS_POT_AVAILABLE(i)) continue;
+    setColumnName(column, analogGetCanonicalName(ADC_INPUT_POT, i));
+    addColumn(column, LOGS_SOURCE_POT, i);
+  }
+
+  for (uint8_t i = 0; i < switchGetMaxSwitches(); i++) {
+    if (!SWITCH_EXISTS(i)) continue;
+    char s[LEN_SWITCH_NAME + 1];
+    *getSwitchName(s, i) = '\0';
+    setColumnName(column, s);
+    addColumn(column, LOGS_SOURCE_SWITCH, i);
+  }
+
+  setColumnName(column, "LSW");
+  column.type = LOGS_COLUMN_HEX64;
+  column.size = 2 * sizeof(int32_t);
+  addColumn(column, LOGS_SOURCE_LS, 0);
+
+  for (uint8_t channel = 0; channel < MAX_OUTPUT_CHANNELS; channel++) {
+    snprintf(label, sizeof(label), "CH%d(us)", channel + 1);
+    setColumnName(column, label);
+    addColumn(column, LOGS_SOURCE_CHANNEL, channel);
+  }
+
+  setColumnName(column, "TxBat(V)");
+  column.prec = 1;
+  addColumn(column, LOGS_SOURCE_TX_VOLTAGE, 0);
+}
+
+static uint16_t getHeaderSize(uint8_t columnsCount)
+{
+  uint32_t size = sizeof(LogsBinaryHeader) + columnsCount * sizeof(LogsBinaryColumn);
+  return (size + LOGS_BINARY_SECTOR_SIZE - 1) & ~(LOGS_BINARY_SECTOR_SIZE - 1);
+}
+
+#if !defined(SIMU)
+RTOS_TASK_HANDLE logsTaskId;
+
+TASK_FUNCTION(logsTask)
+{
+  while (true) {
+    // woken up each time a half of the buffer is ready
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    logsBinaryFlush(false);
+  }
+
+  TASK_RETURN();
+}
+#endif
+
+static bool logsAllocate()
+{
+  if (logsBuffer) return true;
+
+#if !defined(SIMU)
+  auto stack = (StackType_t *)malloc(LOGS_STACK_SIZE * sizeof(StackType_t));
+  if (!stack) return false;
+#endif
+
+  logsBuffer = (LogsBufferHalf *)malloc(2 * LOGS_BUFFER_SIZE);
+  if (!logsBuffer) {
+#if !defined(SIMU)
+    free(stack);
+#endif
+    return false;
+  }
+
+#if !defined(SIMU)
+  _RTOS_CREATE_TASK(&logsTaskId, logsTask, "logs", stack, LOGS_STACK_SIZE,
+                    LOGS_TASK_PRIO);
+#endif
+  return true;
+}
+
+static void notifyWriter()
+{
+#if !defined(SIMU)
+  xTaskNotifyGive(logsTaskId.rtos_handle);
+#endif
+}
+
+bool logsBinaryReset()
+{
+  if (!logsAllocate()) return false;
+
+  logsRecording = false;
+  logsBufferCurrent = 0;
+  logsBufferPos = 0;
+  logsBufferReady[0] = logsBufferReady[1] = false;
+  logsDropped = 0;
+  logsBusy = 0;
+  logsError = false;
+  return true;
+}
+
+void logsBinaryStartRecording()
+{
+  logsRecording = true;
+}
+
+bool logsBinaryOpen(uint32_t period)
+{
+  if (!logsBinaryReset()) return false;
+
+  RTOS_LOCK_MUTEX(logsMutex);
+
+  // header placeholder, completed once the columns are known
+  LogsBinaryHeader header;
+  memclear(&header, sizeof(header));
+  UINT written;
+  f_write(&g_oLogFile, &header, sizeof(header), &written);
+
+  logsColumnsCount = 0;
+  logsRecordSize = sizeof(uint32_t);
+  writeColumns();
+
+  memcpy(header.magic, LOGS_BINARY_MAGIC, sizeof(header.magic));
+  header.version = LOGS_BINARY_VERSION;
+  header.headerSize = getHeaderSize(logsColumnsCount);
+  header.recordSize = logsRecordSize;
+  header.columnsCount = logsColumnsCount;
+#if defined(RTCLOCK)
+  header.startTime = g_rtcTime;
+#endif
+  header.period = period;
+
+  // zero padding up to the first record
+  uint32_t size = f_tell(&g_oLogFile);
+  memclear(logsBuffer[0], LOGS_BINARY_SECTOR_SIZE);
+  f_write(&g_oLogFile, logsBuffer[0], header.headerSize - size, &written);
+
+  f_lseek(&g_oLogFile, 0);
+  written = 0;
+  FRESULT result = f_write(&g_oLogFile, &header, sizeof(header), &written);
+  f_lseek(&g_oLogFile, header.headerSize);
+
+  logsStartTime = RTOS_GET_MS();
+
+  RTOS_UNLOCK_MUTEX(logsMutex);
+
+  if (result != FR_OK || written != sizeof(header)) {
+    return false;
+  }
+
+  logsBinaryStartRecording();
+  return true;
+}
+
+void logsBinaryClose()
+{
+  RTOS_LOCK_MUTEX(logsBufferMutex);
+  logsRecording = false;
+  RTOS_UNLOCK_MUTEX(logsBufferMutex);
+
+  logsBinaryFlush(true);
+}
+
+// A record may span both halves, but must not reach a half which is
+// still waiting for the writer (the caller holds logsBufferMutex)
+static bool hasRoom(uint32_t size)
+{
+  return size < LOGS_BUFFER_SIZE - logsBufferPos ||
+         !logsBufferReady[logsBufferCurrent ^ 1];
+}
+
+static void putBytes(const void * data, uint32_t size)
+{
+  auto src = (const uint8_t *)data;
+  while (size > 0) {
+    uint32_t count = min<uint32_t>(size, LOGS_BUFFER_SIZE - logsBufferPos);
+    memcpy(&logsBuffer[logsBufferCurrent][logsBufferPos], src, count);
+    logsBufferPos += count;
+    src += count;
+    size -= count;
+    if (logsBufferPos == LOGS_BUFFER_SIZE) {
+      logsBufferReady[logsBufferCurrent] = true;
+      logsBufferCurrent ^= 1;
+      logsBufferPos = 0;
+      notifyWriter();
+    }
+  }
+}
+
+static void put(uint32_t value)
+{
+  putBytes(&value, sizeof(value));
+}
+
+bool logsBinaryAppend(const void * record, uint32_t size,
+                      const void * payload, uint32_t len)
+{
+  bool result = false;
+
+  // called from the timer task on each frame: never wait for the buffer
+  if (!RTOS_TRYLOCK_MUTEX(logsBufferMutex)) {
+    if (logsRecording) logsBusy++;
+    return false;
+  }
+
+  if (logsRecording) {
+    if (hasRoom(size + len)) {
+      putBytes(record, size);
+      if (len) putBytes(payload, len);
+      result = true;
+    } else {
+      logsDropped++;
+    }
+  }
+  RTOS_UNLOCK_MUTEX(logsBufferMutex);
+
+  return result;
+}
+
+static void putSensor(uint8_t index)
+{
+  TelemetrySensor & sensor = g_model.telemetrySensors[index];
+  TelemetryItem & item = telemetryItems[index];
+
+  if (sensor.unit == UNIT_GPS) {
+    put(item.gps.latitude);
+    put(item.gps.longitude);
+  } else if (sensor.unit == UNIT_DATETIME) {
+    put(item.datetime.year * 10000 + item.datetime.month * 100 +
+        item.datetime.day);
+    put(item.datetime.hour * 10000 + item.datetime.min * 100 +
+        item.datetime.sec);
+  } else {
+    put(item.value);
+  }
+}
+
+void logsBinaryWrite()
+{
+  RTOS_LOCK_MUTEX(logsBufferMutex);
+
+  if (!logsRecording) {
+    RTOS_UNLOCK_MUTEX(logsBufferMutex);
+    return;
+  }
+
+  if (!hasRoom(logsRecordSize)) {
+    logsDropped++;
+    RTOS_UNLOCK_MUTEX(logsBufferMutex);
+    return;
+  }
+
+  put(RTOS_GET_MS() - logsStartTime);
+
+  for (uint8_t i = 0; i < logsColumnsCount; i++) {
+    const LogsColumn & column = logsColumns[i];
+    switch (column.source) {
+      case LOGS_SOURCE_SENSOR:
+        putSensor(column.index);
+        break;
+      case LOGS_SOURCE_MAIN:
+        put(calibratedAnalogs[inputMappingConvertMode(
+            adcGetInputOffset(ADC_INPUT_MAIN) + column.index)]);
+        break;
+      case LOGS_SOURCE_POT:
+        put(calibratedAnalogs[adcGetInputOffset(ADC_INPUT_POT) + column.index]);
+        break;
+      case LOGS_SOURCE_SWITCH:
+        put(getSwitchState(column.index));
+        break;
+      case LOGS_SOURCE_LS:
+        put(getLogicalSwitchesStates(0));
+        put(getLogicalSwitchesStates(32));
+        break;
+      case LOGS_SOURCE_CHANNEL:
+        put(PPM_CENTER + channelOutputs[column.index] / 2);
+        break;
+      case LOGS_SOURCE_TX_VOLTAGE:
+        put(g_vbat100mV);
+        break;
+    }
+  }
+
+  RTOS_UNLOCK_MUTEX(logsBufferMutex);
+}
+
+static void writeBuffer(const uint8_t * buffer, uint32_t size)
+{
+  UINT written = 0;
+  if (f_write(&g_oLogFile, buffer, size, &written) != FR_OK || written != size) {
+    logsError = true;
+  }
+}
+
+void logsBinaryFlush(bool all)
+{
+  RTOS_LOCK_MUTEX(logsMutex);
+
+  if (g_oLogFile.obj.fs && logsBuffer) {
+    // the half which is not being filled is always the oldest one
+    uint8_t half = logsBufferCurrent ^ 1;
+    for (uint8_t i = 0; i < 2; i++, half ^= 1) {
+      if (logsBufferReady[half]) {
+        writeBuffer(logsBuffer[half], LOGS_BUFFER_SIZE);
+        logsBufferReady[half] = false;
+      }
+    }
+
+    if (all && !logsRecording && logsBufferPos > 0) {
+      writeBuffer(logsBuffer[logsBufferCurrent], logsBufferPos);
+      logsBufferPos = 0;
+    }
+  }
+
+  RTOS_UNLOCK_MUTEX(logsMutex);
+}
+
+bool logsBinaryWriteError()
+{
+  bool error = logsError;
+  logsError = false;
+  return error;
+}
+
+uint32_t logsBinaryDroppedRecords()
+{
+  return logsDropped + logsBusy;
+}
+
+void logsBinaryStart()
+{
+  RTOS_CREATE_MUTEX(logsMutex);
+  RTOS_CREATE_MUTEX(logsBufferMutex);
+}
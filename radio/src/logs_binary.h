@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "definitions.h"
+
+// Binary flight logs
+//
+// The file starts with a header describing the columns, padded with
+// zeros to a multiple of LOGS_BINARY_SECTOR_SIZE so that the records
+// are written on sector boundaries:
+//
+//   LogsBinaryHeader
+//   LogsBinaryColumn[columnsCount]
+//   padding
+//
+// It is followed by fixed size records:
+//
+//   uint32_t time     // ms since the start of the log
+//   column values     // 'size' bytes each, in columns order
+//
+// All values are little-endian signed 32 bit integers, with 'prec'
+// decimals. Some columns are made of 2 of them:
+//  - GPS: latitude, longitude (1e-6 degrees)
+//  - DATETIME: year * 10000 + month * 100 + day,
+//              hour * 10000 + min * 100 + sec
+//  - HEX64: low 32 bits, high 32 bits (logical switches)
+//
+// Text sensors are not logged.
+
+#define LOGS_BINARY_MAGIC         "ETXL"
+#define LOGS_BINARY_VERSION       1
+#define LOGS_BINARY_SECTOR_SIZE   512
+#define LOGS_BINARY_NAME_LEN      16
+
+enum LogsBinaryColumnType {
+  LOGS_COLUMN_VALUE,
+  LOGS_COLUMN_GPS,
+  LOGS_COLUMN_DATETIME,
+  LOGS_COLUMN_HEX64,
+};
+
+PACK(struct LogsBinaryHeader {
+  char magic[4];
+  uint8_t version;
+  uint8_t reserved;
+  uint16_t headerSize;    // records start at this offset
+  uint16_t recordSize;
+  uint16_t columnsCount;
+  uint32_t startTime;     // RTC time at the start of the log (0 if unknown)
+  uint32_t period;        // ms
+});
+
+PACK(struct LogsBinaryColumn {
+  char name[LOGS_BINARY_NAME_LEN];  // same as the CSV header, zero padded
+  uint8_t type;
+  uint8_t prec;
+  uint8_t size;
+  uint8_t reserved;
+});
+
+// Writes the header into g_oLogFile and prepares the records layout
+bool logsBinaryOpen(uint32_t period);
+
+// Empties the buffers and stops recording, before a header is written
+// (the buffers are allocated by the first call: returns false if this failed)
+bool logsBinaryReset();
+
+// Accepts records once the header has been written
+void logsBinaryStartRecording();
+
+// Appends a record made of a header and an optional payload to the RAM
+// buffers, without waiting if they are busy. Returns false if the record
+// was dropped.
+bool logsBinaryAppend(const void * record, uint32_t size,
+                      const void * payload = nullptr, uint32_t len = 0);
+
+// Stops recording and writes the remaining records
+// (the file is then closed by the caller)
+void logsBinaryClose();
+
+// Appends a record to the RAM buffers (does not access the SD card)
+void logsBinaryWrite();
+
+// Writes the buffers which are full, or all of them when closing
+void logsBinaryFlush(bool all);
+
+// Returns true (once) if the writer failed since the last call
+bool logsBinaryWriteError();
+
+// Records dropped because the writer could not keep up, or because
+// the buffers were busy when appending
+uint32_t logsBinaryDroppedRecords();
+
+// Creates the mutexes (the writer task is started with the first log)
+void logsBinaryStart();
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "opentx.h"
+#include "logs_binary.h"
+#include "logs_capture.h"
+
+volatile bool logsCapturing = false;
+
+static uint32_t captureTime()
+{
+#if defined(SIMU)
+  return RTOS_GET_MS() * 1000;
+#else
+  return timersGetUsTick();
+#endif
+}
+
+bool logsCaptureOpen()
+{
+  if (!logsBinaryReset()) return false;
+
+  static_assert(sizeof(LogsCaptureHeader) <= LOGS_BINARY_SECTOR_SIZE,
+                "LogsCaptureHeader too large");
+
+  LogsCaptureHeader header;
+  memclear(&header, sizeof(header));
+  memcpy(header.magic, LOGS_CAPTURE_MAGIC, sizeof(header.magic));
+  header.version = LOGS_CAPTURE_VERSION;
+  header.channelsCount = MAX_OUTPUT_CHANNELS;
+  header.headerSize = LOGS_BINARY_SECTOR_SIZE;
+#if defined(RTCLOCK)
+  header.startTime = g_rtcTime;
+#endif
+  for (uint8_t i = 0; i < NUM_MODULES && i < LOGS_CAPTURE_MODULES; i++) {
+    const ModuleData & module = g_model.moduleData[i];
+    header.modules[i].type = module.type;
+    header.modules[i].subType = module.subType;
+    if (module.type == MODULE_TYPE_MULTIMODULE) {
+      header.modules[i].rfProtocol = module.multi.rfProtocol;
+    }
+  }
+
+  UINT written = 0;
+  FRESULT result = f_write(&g_oLogFile, &header, sizeof(header), &written);
+  if (result != FR_OK || written != sizeof(header)) {
+    return false;
+  }
+
+  // the records start on a sector boundary
+  uint8_t padding[64];
+  memclear(padding, sizeof(padding));
+  for (uint32_t size = sizeof(header); size < LOGS_BINARY_SECTOR_SIZE;) {
+    uint32_t count = min<uint32_t>(sizeof(padding), LOGS_BINARY_SECTOR_SIZE - size);
+    result = f_write(&g_oLogFile, padding, count, &written);
+    if (result != FR_OK || written != count) {
+      return false;
+    }
+    size += count;
+  }
+
+  logsBinaryStartRecording();
+  logsCapturing = true;
+  return true;
+}
+
+void logsCaptureClose()
+{
+  logsCapturing = false;
+  logsBinaryClose();
+}
+
+void logsCaptureTelemetry(uint8_t module, uint8_t type, const uint8_t * data,
+                          uint32_t len)
+{
+  LogsCaptureRecord record;
+  record.time = captureTime();
+  record.type = type;
+  record.module = module;
+  record.length = len;
+  logsBinaryAppend(&record, sizeof(record), data, len);
+}
+
+void logsCaptureChannels()
+{
+  LogsCaptureRecord record;
+  record.time = captureTime();
+  record.type = LOGS_CAPTURE_CHANNELS;
+  record.module = 0;
+  record.length = sizeof(channelOutputs);
+  logsBinaryAppend(&record, sizeof(record), channelOutputs,
+                   sizeof(channelOutputs));
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+#include "definitions.h"
+
+// Raw telemetry capture
+//
+// The file starts with a LogsCaptureHeader, padded with zeros to
+// LOGS_BINARY_SECTOR_SIZE. It is followed by variable size records:
+//
+//   LogsCaptureRecord
+//   payload           // 'length' bytes
+//
+// Records types:
+//  - FRAME: a frame as passed to the protocol processFrame()
+//  - DATA: bytes as passed to the protocol processData()
+//  - CHANNELS: channelOutputs[] (int16_t), at the SD Logs period
+//
+// The time is a free running microseconds counter, which wraps after
+// 71 minutes: only the difference between consecutive records matters.
+
+#define LOGS_CAPTURE_EXT          ".etxr"
+#define LOGS_CAPTURE_MAGIC        "ETXR"
+#define LOGS_CAPTURE_VERSION      1
+#define LOGS_CAPTURE_MODULES      2
+
+enum LogsCaptureRecordType {
+  LOGS_CAPTURE_FRAME,
+  LOGS_CAPTURE_DATA,
+  LOGS_CAPTURE_CHANNELS,
+};
+
+PACK(struct LogsCaptureModule {
+  uint8_t type;         // ModuleType
+  uint8_t subType;
+  uint8_t rfProtocol;   // multi-protocol modules only
+  uint8_t reserved;
+});
+
+PACK(struct LogsCaptureHeader {
+  char magic[4];
+  uint8_t version;
+  uint8_t channelsCount;
+  uint16_t headerSize;  // records start at this offset
+  uint32_t startTime;   // RTC time at the start of the capture (0 if unknown)
+  LogsCaptureModule modules[LOGS_CAPTURE_MODULES];
+});
+
+PACK(struct LogsCaptureRecord {
+  uint32_t time;        // us
+  uint8_t type;
+  uint8_t module;
+  uint16_t length;
+});
+
+#if defined(SDCARD)
+extern volatile bool logsCapturing;
+
+// Writes the header into g_oLogFile and starts capturing
+bool logsCaptureOpen();
+
+// Stops capturing and writes the remaining records
+// (the file is then closed by the caller)
+void logsCaptureClose();
+
+void logsCaptureTelemetry(uint8_t module, uint8_t type, const uint8_t * data,
+                          uint32_t len);
+
+// Records the channels outputs (called at the SD Logs period)
+void logsCaptureChannels();
+
+#define LOGS_CAPTURE_TELEMETRY(module, type, data, len)   \
+  do {                                                    \
+    if (logsCapturing)                                    \
+      logsCaptureTelemetry(module, type, data, len);      \
+  } while (0)
+#else
+#define LOGS_CAPTURE_TELEMETRY(module, type, data, len)
+#endif
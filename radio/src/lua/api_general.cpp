@@ -32,6 +32,9 @@
 #include "hal/rotary_encoder.h"
 #include "switches.h"
 #include "input_mapping.h"
+#include "mixer_stats.h"
+#include "telemetry/telemetry_stats.h"
+#include "telemetry/telemetry_history.h"
 #if defined(LED_STRIP_GPIO)
 #include "boards/generic_stm32/rgb_leds.h"
 #endif
@@ -2161,6 +2164,214 @@ static int luaGetUsage(lua_State * L)
   return 1;
 }
 
+/*luadoc
+@function getMixerStats([reset])
+
+Get the mixer timing statistics, per mixer stage.
+
+@param reset (optional) if set to `true`, statistics are cleared after being read
+
+@retval table with one entry per stage (`adc`, `switches`, `inputs`, `ls`,
+`mixes`, `functions`, `limits`, `pulses`) plus the scheduler timing errors
+(`wakeup`: mixer wakeup drift, `sync`: phase lock error, from the lag
+reported by the RF module)
+and the age of the channels sent to each module (`stale_int`, `stale_ext`),
+each of them a table with:
+ * `last` (number) duration of the last cycle in us
+ * `p50` (number) median duration in us
+ * `p99` (number) 99th percentile duration in us
+ * `max` (number) maximum duration in us
+ * `count` (number) number of measured cycles
+
+Percentiles are upper bounds of power of 2 buckets.
+
+@status current Introduced in 2.10.0
+*/
+static int luaGetMixerStats(lua_State * L)
+{
+  bool reset = lua_toboolean(L, 1);
+
+  lua_newtable(L);
+  for (uint8_t stage = 0; stage < MIXER_STATS_COUNT; stage++) {
+    MixerStageStats stats;
+    mixerStatsGet(stage, stats);
+    lua_pushstring(L, mixerStageName(stage));
+    lua_newtable(L);
+    lua_pushtableinteger(L, "last", stats.last);
+    lua_pushtableinteger(L, "p50", stats.p50);
+    lua_pushtableinteger(L, "p99", stats.p99);
+    lua_pushtableinteger(L, "max", stats.max);
+    lua_pushtableinteger(L, "count", stats.count);
+    lua_settable(L, -3);
+  }
+
+  if (reset) {
+    mixerStatsReset();
+  }
+  return 1;
+}
+
+/*luadoc
+@function getTelemetryStats(module [, reset])
+
+Get the telemetry pipeline statistics of a module.
+
+@param module (number) module index (0 = internal, 1 = external)
+
+@param reset (optional) if set to `true`, statistics of all modules are
+cleared after being read
+
+@retval nil if the module index is invalid
+
+@retval table with the following fields:
+ * `frames` (number) frames handed over to the decoder
+ * `bytes` (number) bytes received
+ * `crc` (number) frames with a wrong CRC / checksum
+ * `size` (number) oversize or undersize frames
+ * `overruns` (number) RX overruns (frames merged or bytes lost by the serial port)
+ * `latency` (number) time from the end of the last frame to the end of
+   its decoding in us (frame-triggered protocols only)
+ * `maxLatency` (number) maximum latency in us
+
+@status current Introduced in 2.10.0
+*/
+static int luaGetTelemetryStats(lua_State * L)
+{
+  unsigned int module = luaL_checkunsigned(L, 1);
+  bool reset = lua_toboolean(L, 2);
+
+  if (module >= NUM_MODULES) {
+    lua_pushnil(L);
+    return 1;
+  }
+
+  TelemetryStats stats;
+  telemetryStatsGet(module, stats);
+
+  lua_newtable(L);
+  lua_pushtableinteger(L, "frames", stats.frames);
+  lua_pushtableinteger(L, "bytes", stats.bytes);
+  lua_pushtableinteger(L, "crc", stats.crcErrors);
+  lua_pushtableinteger(L, "size", stats.sizeErrors);
+  lua_pushtableinteger(L, "overruns", stats.overruns);
+  lua_pushtableinteger(L, "latency", stats.lastLatency);
+  lua_pushtableinteger(L, "maxLatency", stats.maxLatency);
+
+  if (reset) {
+    telemetryStatsReset();
+  }
+  return 1;
+}
+
+/*luadoc
+@function getSensorHistory(source [, n [, period [, depth]]])
+
+Get the history of a telemetry sensor, without polling it.
+
+The history is kept by the radio for a few sensors and periods at a time:
+it starts with the first call for a sensor and a period, and one not read
+for 5 seconds is dropped when another one needs a history. Each sample
+holds the min and the max of the values received during the sample period.
+
+@param source the sensor, as an index (number) or a name (string), see
+getValue()
+
+@param n (optional) sample to return, 1 being the newest one
+
+@param period (optional) sample period in 10ms (the one of the history
+already kept for the sensor, or 10 when it starts without it). Scripts
+asking for different periods get different histories.
+
+@param depth (optional) number of samples to keep, at most (and by
+default) 64, or 256 on color screen radios
+
+@retval nil if the source is not a sensor, or no history is available
+
+@retval count (number) number of samples available when `n` is not given
+(at most `depth`)
+
+@retval min,max (numbers) the `n`th newest sample, or nil if there are
+less samples
+
+@status current Introduced in 2.10.0
+
+@notice The samples are read in place: a graph does not need to keep
+its own copy of the values, e.g.
+```lua
+local count = getSensorHistory("Alt")
+for i = 1, count do
+  local min, max = getSensorHistory("Alt", i)
+  ...
+end
+```
+*/
+static int luaGetSensorHistory(lua_State * L)
+{
+  int src = MIXSRC_NONE;
+  if (lua_isnumber(L, 1)) {
+    src = luaL_checkinteger(L, 1);
+  }
+  else {
+    LuaField field;
+    if (luaFindFieldByName(luaL_checkstring(L, 1), field)) {
+      src = field.id;
+    }
+  }
+
+  if (src < MIXSRC_FIRST_TELEM || src > MIXSRC_LAST_TELEM) {
+    lua_pushnil(L);
+    return 1;
+  }
+
+  uint8_t index = (src - MIXSRC_FIRST_TELEM) / 3;
+  unsigned int depth = luaL_optunsigned(L, 4, TELEMETRY_HISTORY_DEPTH);
+  if (depth > TELEMETRY_HISTORY_DEPTH) depth = TELEMETRY_HISTORY_DEPTH;
+
+  TelemetryHistory * history = nullptr;
+  if (isTelemetryFieldAvailable(index)) {
+    uint16_t period = 10;
+    if (!lua_isnoneornil(L, 3)) {
+      period = luaL_checkunsigned(L, 3);
+    }
+    else {
+      history = telemetryHistoryGet(index);
+      if (history) period = history->period;
+    }
+    history = telemetryHistoryEnable(index, period, depth);
+  }
+
+  if (!history) {
+    lua_pushnil(L);
+    return 1;
+  }
+
+  // the history may be shared with a deeper reader
+  unsigned int count = min<unsigned int>(history->count, depth);
+
+  if (lua_isnoneornil(L, 2)) {
+    lua_pushunsigned(L, count);
+    return 1;
+  }
+
+  unsigned int n = luaL_checkunsigned(L, 2);
+  if (n < 1 || n > count) {
+    lua_pushnil(L);
+    return 1;
+  }
+
+  const TelemetryHistorySample & sample = history->get(n - 1);
+  const TelemetrySensor & sensor = g_model.telemetrySensors[index];
+  if (sensor.prec > 0) {
+    lua_pushnumber(L, float(sample.min) / sensor.getPrecDivisor());
+    lua_pushnumber(L, float(sample.max) / sensor.getPrecDivisor());
+  }
+  else {
+    lua_pushinteger(L, sample.min);
+    lua_pushinteger(L, sample.max);
+  }
+  return 2;
+}
+
 /*luadoc
 @function getAvailableMemory()
 
@@ -2912,6 +3123,7 @@ LROT_BEGIN(etxlib, NULL, 0)
   LROT_FUNCENTRY( getRotEncSpeed, luaGetRotEncSpeed )
   LROT_FUNCENTRY( getRotEncMode, luaGetRotEncMode )
   LROT_FUNCENTRY( getValue, luaGetValue )
+  LROT_FUNCENTRY( getSensorHistory, luaGetSensorHistory )
   LROT_FUNCENTRY( getOutputValue, luaGetOutputValue )
   LROT_FUNCENTRY( getSourceValue, luaGetSourceValue )
   LROT_FUNCENTRY( getTrainerStatus, luaGetTrainerStatus )
@@ -2938,6 +3150,8 @@ LROT_BEGIN(etxlib, NULL, 0)
   LROT_FUNCENTRY( chdir, luaChdir )
   LROT_FUNCENTRY( loadScript, luaLoadScript )
   LROT_FUNCENTRY( getUsage, luaGetUsage )
+  LROT_FUNCENTRY( getMixerStats, luaGetMixerStats )
+  LROT_FUNCENTRY( getTelemetryStats, luaGetTelemetryStats )
   LROT_FUNCENTRY( getAvailableMemory, luaGetAvailableMemory )
   LROT_FUNCENTRY( resetGlobalTimer, luaResetGlobalTimer )
 #if LCD_DEPTH > 1 && !defined(COLORLCD)
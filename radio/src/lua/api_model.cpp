@@ -943,6 +943,7 @@ static int luaModelInsertMix(lua_State *L)
         mix->speedDown = luaL_checkinteger(L, -1);
       }
     }
+    storageConfigDirty(EE_MODEL);
   }
 
   return 0;
@@ -984,6 +985,7 @@ Remove all mixers
 static int luaModelDeleteMixes(lua_State *L)
 {
   memset(g_model.mixData, 0, sizeof(g_model.mixData));
+  storageConfigDirty(EE_MODEL);
   return 0;
 }
 
@@ -1076,7 +1078,7 @@ static int luaModelSetLogicalSwitch(lua_State *L)
         sw->duration = luaL_checkinteger(L, -1);
       }
     }
-    storageDirty(EE_MODEL);
+    storageConfigDirty(EE_MODEL);
   }
 
   return 0;
@@ -1337,7 +1339,7 @@ static int luaModelSetCurve(lua_State *L)
       *point++ = xPoints[i];
     }
   }
-  storageDirty(EE_MODEL);
+  storageConfigDirty(EE_MODEL);
 
   lua_pushinteger(L, 0);
   return 1;
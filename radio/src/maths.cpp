@@ -36,6 +36,50 @@ uint16_t isqrt32(uint32_t n)
   }
 }
 
+// Only computed when the pilot position changes
+uint32_t gpsLongitudeScale(int32_t latitude)
+{
+  return GPS_LATITUDE_SCALE * cosf(latitude * float(M_PI / 180000000));
+}
+
+// Length on ground in m (ignoring curvature of the earth)
+uint16_t gpsDistance(int32_t dlat, int32_t dlon, uint32_t lonScale)
+{
+  uint32_t y = (uint64_t(abs(dlat)) * GPS_LATITUDE_SCALE + 0x80000000) >> 32;
+  uint32_t x = (uint64_t(abs(dlon)) * lonScale + 0x80000000) >> 32;
+  return isqrt32(x * x + y * y);
+}
+
+// Bearing in 0.1 degrees, clockwise from the north
+uint16_t gpsBearing(int32_t dlat, int32_t dlon, uint32_t lonScale)
+{
+  // projected distances in 1/65536 m
+  uint64_t y = (uint64_t(abs(dlat)) * GPS_LATITUDE_SCALE) >> 16;
+  uint64_t x = (uint64_t(abs(dlon)) * lonScale) >> 16;
+  if (x == 0 && y == 0)
+    return 0;
+
+  uint64_t hi = max(x, y);
+  uint64_t lo = min(x, y);
+  while (hi >= 0x10000) {
+    hi >>= 1;
+    lo >>= 1;
+  }
+
+  // atan(z) ~ 45 z + 15.64 z (1 - z) in degrees for 0 <= z <= 1 (z in Q15),
+  // error < 0.25 degrees
+  uint32_t z = (uint32_t(lo) << 15) / uint32_t(hi);
+  uint32_t angle = (z * (57600 + ((20019 * (32768 - z)) >> 15)) + (1 << 21)) >> 22;
+  if (x > y)
+    angle = 900 - angle;
+
+  if (dlat < 0)
+    angle = 1800 - angle;
+  if (dlon < 0)
+    angle = 3600 - angle;
+  return angle % 3600;
+}
+
 /*
   Division by 10 and rounding or fixed point arithmetic values
 
@@ -24,6 +24,7 @@
 #include "switches.h"
 #include "input_mapping.h"
 #include "mixes.h"
+#include "mixer_stats.h"
 
 #include "hal/adc_driver.h"
 #include "hal/trainer_driver.h"
@@ -89,6 +90,27 @@ int16_t cyc_anas[3] = {0};
  f(x) = (k*x*x*x/(1024*1024) + x*(256-k) + 128) / 256
  */
 
+// calc100to256(k) for k = 0 to 100, saves the division
+// done for each input on every mixer cycle
+static const uint16_t expoFactors[101] = {
+  0, 3, 5, 8, 10, 13, 15, 18, 20, 23,
+  26, 28, 31, 33, 36, 38, 41, 44, 46, 49,
+  51, 54, 56, 59, 61, 64, 67, 69, 72, 74,
+  77, 79, 82, 84, 87, 90, 92, 95, 97, 100,
+  102, 105, 108, 110, 113, 115, 118, 120, 123, 125,
+  128, 131, 133, 136, 138, 141, 143, 146, 148, 151,
+  154, 156, 159, 161, 164, 166, 169, 172, 174, 177,
+  179, 182, 184, 187, 189, 192, 195, 197, 200, 202,
+  205, 207, 210, 212, 215, 218, 220, 223, 225, 228,
+  230, 233, 236, 238, 241, 243, 246, 248, 251, 253,
+  256,
+};
+
+static inline uint32_t getExpoFactor(unsigned int k)
+{
+  return k < DIM(expoFactors) ? expoFactors[k] : calc100to256(k);
+}
+
 // input parameters;
 //  x 0 to 1024;
 //  k 0 to 100;
@@ -106,7 +128,7 @@ unsigned int expou(unsigned int x, unsigned int k)
   }
 #endif
 
-  k = calc100to256(k);
+  k = getExpoFactor(k);
 
   uint32_t value = (uint32_t) x*x;
   value *= (uint32_t)k;
@@ -143,6 +165,13 @@ int expo(int x, int k)
   if (x > (int)RESXu) {
     x = RESXu;
   }
+  if (x == 0) {
+    return 0;
+  }
+  if (x == (int)RESXu) {
+    // both ends of the curve are fixed points
+    return neg ? -RESX : RESX;
+  }
   if (k < 0) {
     y = RESXu - expou(RESXu-x, -k);
   }
@@ -246,9 +275,9 @@ int16_t applyLimits(uint8_t channel, int32_t value)
   if (lim->curve) {
     // TODO we loose precision here, applyCustomCurve could work with int32_t on ARM boards...
     if (lim->curve > 0)
-      value = 256 * applyCustomCurve(value/256, lim->curve-1);
+      value = 256 * applyCustomCurve(value/256, lim->curve-1, true);
     else
-      value = 256 * applyCustomCurve(-value/256, -lim->curve-1);
+      value = 256 * applyCustomCurve(-value/256, -lim->curve-1, true);
   }
 
   int16_t ofs   = LIMIT_OFS_RESX(lim);
@@ -296,174 +325,252 @@ int16_t applyLimits(uint8_t channel, int32_t value)
   return ofs;
 }
 
-// TODO same naming convention than the drawSource
-// *valid added to return status to Lua for invalid sources
-getvalue_t getValue(mixsrc_t i, bool* valid)
+// Sources values
+//
+// getValue() used to go through a chain of range comparisons, so that
+// the cost of a call depended on the source category (telemetry being
+// the slowest). The categories are now looked up in a const table
+// sorted by their last index, with a binary search.
+
+typedef getvalue_t (*SourceGetter)(mixsrc_t i, bool * valid);
+
+struct SourceRange {
+  uint16_t last;
+  SourceGetter getValue;
+};
+
+static getvalue_t getInvalidSourceValue(mixsrc_t i, bool * valid)
+{
+  if (valid != nullptr) *valid = false;
+  return 0;
+}
+
+static getvalue_t getInputValue(mixsrc_t i, bool * valid)
 {
-  if (i == MIXSRC_NONE) {
+  return anas[i - MIXSRC_FIRST_INPUT];
+}
+
+#if defined(LUA_INPUTS) && defined(LUA_MODEL_SCRIPTS)
+static getvalue_t getLuaOutputValue(mixsrc_t i, bool * valid)
+{
+  div_t qr = div(i-MIXSRC_FIRST_LUA, MAX_SCRIPT_OUTPUTS);
+  return scriptInputsOutputs[qr.quot].outputs[qr.rem].value;
+}
+#endif
+
+static getvalue_t getStickValue(mixsrc_t i, bool * valid)
+{
+  i -= MIXSRC_FIRST_STICK;
+  if (i >= adcGetMaxInputs(ADC_INPUT_MAIN)) {
     if (valid != nullptr) *valid = false;
     return 0;
   }
-  else if (i <= MIXSRC_LAST_INPUT) {
-    return anas[i - MIXSRC_FIRST_INPUT];
-  }
-#if defined(LUA_INPUTS)
-  else if (i <= MIXSRC_LAST_LUA) {
-#if defined(LUA_MODEL_SCRIPTS)
-    div_t qr = div(i-MIXSRC_FIRST_LUA, MAX_SCRIPT_OUTPUTS);
-    return scriptInputsOutputs[qr.quot].outputs[qr.rem].value;
-#else
+  return calibratedAnalogs[inputMappingConvertMode(i)];
+}
+
+static getvalue_t getPotValue(mixsrc_t i, bool * valid)
+{
+  i -= MIXSRC_FIRST_POT;
+  if (i >= adcGetMaxInputs(ADC_INPUT_POT)) {
     if (valid != nullptr) *valid = false;
     return 0;
-#endif
-  }
-#endif
-
-  else if (i <= MIXSRC_LAST_STICK) {
-    i -= MIXSRC_FIRST_STICK;
-    if (i >= adcGetMaxInputs(ADC_INPUT_MAIN)) {
-      if (valid != nullptr) *valid = false;
-      return 0;
-    }
-    return calibratedAnalogs[inputMappingConvertMode(i)];
-  }
-  else if (i <= MIXSRC_LAST_POT) {
-    i -= MIXSRC_FIRST_POT;
-    if (i >= adcGetMaxInputs(ADC_INPUT_POT)) {
-      if (valid != nullptr) *valid = false;
-      return 0;
-    }
-    return calibratedAnalogs[i + adcGetInputOffset(ADC_INPUT_POT)];
   }
+  return calibratedAnalogs[i + adcGetInputOffset(ADC_INPUT_POT)];
+}
 
 #if MAX_AXIS > 0
-  else if (i <= MIXSRC_LAST_AXIS) {
-    i -= MIXSRC_FIRST_AXIS;
-    if (i >= adcGetMaxInputs(ADC_INPUT_AXIS)) {
-      if (valid != nullptr) *valid = false;
-      return 0;
-    }
-    return calibratedAnalogs[i + adcGetInputOffset(ADC_INPUT_AXIS)];
+static getvalue_t getAxisValue(mixsrc_t i, bool * valid)
+{
+  i -= MIXSRC_FIRST_AXIS;
+  if (i >= adcGetMaxInputs(ADC_INPUT_AXIS)) {
+    if (valid != nullptr) *valid = false;
+    return 0;
   }
+  return calibratedAnalogs[i + adcGetInputOffset(ADC_INPUT_AXIS)];
+}
 #endif
 
 #if defined(IMU)
-  else if (i == MIXSRC_TILT_X) {
-    return gyro.scaledX();
-  }
-  else if (i == MIXSRC_TILT_Y) {
-    return gyro.scaledY();
-  }
+static getvalue_t getTiltValue(mixsrc_t i, bool * valid)
+{
+  return i == MIXSRC_TILT_X ? gyro.scaledX() : gyro.scaledY();
+}
 #endif
 
 #if defined(SPACEMOUSE)
-  else if (i >= MIXSRC_FIRST_SPACEMOUSE && i <= MIXSRC_LAST_SPACEMOUSE) {
-    return get_spacemouse_value(i - MIXSRC_FIRST_SPACEMOUSE);
-  }
+static getvalue_t getSpacemouseValue(mixsrc_t i, bool * valid)
+{
+  return get_spacemouse_value(i - MIXSRC_FIRST_SPACEMOUSE);
+}
 #endif
 
-  else if (i == MIXSRC_MIN) {
-    return -RESX;
-  }
-  else if (i == MIXSRC_MAX) {
-    return RESX;
-  }
+static getvalue_t getMinMaxValue(mixsrc_t i, bool * valid)
+{
+  return i == MIXSRC_MIN ? -RESX : RESX;
+}
 
-  else if (i <= MIXSRC_LAST_HELI) {
 #if defined(HELI)
-    return cyc_anas[i - MIXSRC_FIRST_HELI];
-#else
-    if (valid != nullptr) *valid = false;
-    return 0;
+static getvalue_t getHeliValue(mixsrc_t i, bool * valid)
+{
+  return cyc_anas[i - MIXSRC_FIRST_HELI];
+}
 #endif
-  }
 
-  else if (i <= MIXSRC_LAST_TRIM) {
-    i -= MIXSRC_FIRST_TRIM;
-    auto trim_value = getTrimValue(mixerCurrentFlightMode, i);
-    return calc1000toRESX((int16_t)8 * trim_value);
-  }
+static getvalue_t getTrimSourceValue(mixsrc_t i, bool * valid)
+{
+  i -= MIXSRC_FIRST_TRIM;
+  auto trim_value = getTrimValue(mixerCurrentFlightMode, i);
+  return calc1000toRESX((int16_t)8 * trim_value);
+}
+
+static getvalue_t getSwitchValue(mixsrc_t i, bool * valid)
+{
+  mixsrc_t sw = i - MIXSRC_FIRST_SWITCH;
 #if defined(FUNCTION_SWITCHES)
-  else if (i >= MIXSRC_FIRST_SWITCH && i <= MIXSRC_LAST_REGULAR_SWITCH) {
-    mixsrc_t sw = i - MIXSRC_FIRST_SWITCH;
-    if (SWITCH_EXISTS(sw)) {
-      return (switchState(3*sw) ? -1024 : (IS_CONFIG_3POS(sw) && switchState(3*sw+1) ? 0 : 1024));
-    }
-    else {
-      if (valid != nullptr) *valid = false;
-      return 0;
-    }
-  } else if (i >= MIXSRC_FIRST_FS_SWITCH && i <= MIXSRC_LAST_SWITCH) {
-    return getFSLogicalState(i - MIXSRC_FIRST_SWITCH - switchGetMaxSwitches()) ? +1024 : -1024;
-  }
-#else
-  else if (i >= MIXSRC_FIRST_SWITCH && i <= MIXSRC_LAST_SWITCH) {
-    mixsrc_t sw = i - MIXSRC_FIRST_SWITCH;
-    if (SWITCH_EXISTS(sw)) {
-      return (switchState(3*sw) ? -1024 : (IS_CONFIG_3POS(sw) && switchState(3*sw+1) ? 0 : 1024));
-    }
-    else {
-      if (valid != nullptr) *valid = false;
-      return 0;
-    }
+  if (i > MIXSRC_LAST_REGULAR_SWITCH) {
+    return getFSLogicalState(sw - switchGetMaxSwitches()) ? +1024 : -1024;
   }
 #endif
+  if (SWITCH_EXISTS(sw)) {
+    return (switchState(3*sw) ? -1024 : (IS_CONFIG_3POS(sw) && switchState(3*sw+1) ? 0 : 1024));
+  }
+  else {
+    if (valid != nullptr) *valid = false;
+    return 0;
+  }
+}
 
-  else if (i <= MIXSRC_LAST_LOGICAL_SWITCH) {
-    return getSwitch(SWSRC_FIRST_LOGICAL_SWITCH + i - MIXSRC_FIRST_LOGICAL_SWITCH) ? 1024 : -1024;
-  } else if (i <= MIXSRC_LAST_TRAINER) {
-    int16_t x = trainerInput[i - MIXSRC_FIRST_TRAINER];
-    if (i < MIXSRC_FIRST_TRAINER + NUM_CAL_PPM) {
-      x -= g_eeGeneral.trainer.calib[i - MIXSRC_FIRST_TRAINER];
-    }
-    return x * 2;
-  } else if (i <= MIXSRC_LAST_CH) {
-    return ex_chans[i - MIXSRC_FIRST_CH];
+static getvalue_t getLogicalSwitchValue(mixsrc_t i, bool * valid)
+{
+  return getSwitch(SWSRC_FIRST_LOGICAL_SWITCH + i - MIXSRC_FIRST_LOGICAL_SWITCH) ? 1024 : -1024;
+}
+
+static getvalue_t getTrainerValue(mixsrc_t i, bool * valid)
+{
+  int16_t x = trainerInput[i - MIXSRC_FIRST_TRAINER];
+  if (i < MIXSRC_FIRST_TRAINER + NUM_CAL_PPM) {
+    x -= g_eeGeneral.trainer.calib[i - MIXSRC_FIRST_TRAINER];
   }
+  return x * 2;
+}
+
+static getvalue_t getChannelValue(mixsrc_t i, bool * valid)
+{
+  return ex_chans[i - MIXSRC_FIRST_CH];
+}
 
-  else if (i <= MIXSRC_LAST_GVAR) {
 #if defined(GVARS)
-    return GVAR_VALUE(i - MIXSRC_FIRST_GVAR, getGVarFlightMode(mixerCurrentFlightMode, i - MIXSRC_FIRST_GVAR));
-#else
+static getvalue_t getGVarSourceValue(mixsrc_t i, bool * valid)
+{
+  return GVAR_VALUE(i - MIXSRC_FIRST_GVAR, getGVarFlightMode(mixerCurrentFlightMode, i - MIXSRC_FIRST_GVAR));
+}
+#endif
+
+static getvalue_t getTxVoltageValue(mixsrc_t i, bool * valid)
+{
+  return g_vbat100mV;
+}
+
+#if defined(RTCLOCK)
+static getvalue_t getTxTimeValue(mixsrc_t i, bool * valid)
+{
+  return (g_rtcTime % SECS_PER_DAY) / 60; // number of minutes from midnight
+}
+#endif
+
+static getvalue_t getTimerValue(mixsrc_t i, bool * valid)
+{
+  return timersStates[i - MIXSRC_FIRST_TIMER].val;
+}
+
+static getvalue_t getTelemetrySourceValue(mixsrc_t i, bool * valid)
+{
+  if (IS_FAI_FORBIDDEN(i)) {
     if (valid != nullptr) *valid = false;
     return 0;
-#endif
   }
+  i -= MIXSRC_FIRST_TELEM;
+  div_t qr = div(i, 3);
+  TelemetryItem & telemetryItem = telemetryItems[qr.quot];
+  switch (qr.rem) {
+    case 1:
+      return telemetryItem.valueMin;
+    case 2:
+      return telemetryItem.valueMax;
+    default:
+      return telemetryItem.value;
+  }
+}
 
-  else if (i == MIXSRC_TX_VOLTAGE) {
-    return g_vbat100mV;
-  } else if (i < MIXSRC_FIRST_TIMER) {
-    // TX_TIME + SPARES
+static const SourceRange sourceRanges[] = {
+  { MIXSRC_NONE, getInvalidSourceValue },
+  { MIXSRC_LAST_INPUT, getInputValue },
+#if defined(LUA_INPUTS) && defined(LUA_MODEL_SCRIPTS)
+  { MIXSRC_LAST_LUA, getLuaOutputValue },
+#elif defined(LUA_INPUTS)
+  { MIXSRC_LAST_LUA, getInvalidSourceValue },
+#endif
+  { MIXSRC_LAST_STICK, getStickValue },
+  { MIXSRC_LAST_POT, getPotValue },
+#if MAX_AXIS > 0
+  { MIXSRC_LAST_AXIS, getAxisValue },
+#endif
+#if defined(IMU)
+  { MIXSRC_TILT_Y, getTiltValue },
+#endif
+#if defined(SPACEMOUSE)
+  { MIXSRC_LAST_SPACEMOUSE, getSpacemouseValue },
+#elif defined(PCBHORUS)
+  { MIXSRC_LAST_SPACEMOUSE, getInvalidSourceValue },
+#endif
+  { MIXSRC_MAX, getMinMaxValue },
+#if defined(HELI)
+  { MIXSRC_LAST_HELI, getHeliValue },
+#else
+  { MIXSRC_LAST_HELI, getInvalidSourceValue },
+#endif
+  { MIXSRC_LAST_TRIM, getTrimSourceValue },
+  { MIXSRC_LAST_SWITCH, getSwitchValue },
+  { MIXSRC_LAST_LOGICAL_SWITCH, getLogicalSwitchValue },
+  { MIXSRC_LAST_TRAINER, getTrainerValue },
+  { MIXSRC_LAST_CH, getChannelValue },
+#if defined(GVARS)
+  { MIXSRC_LAST_GVAR, getGVarSourceValue },
+#else
+  { MIXSRC_LAST_GVAR, getInvalidSourceValue },
+#endif
+  { MIXSRC_TX_VOLTAGE, getTxVoltageValue },
+  // TX_TIME + SPARES
 #if defined(RTCLOCK)
-    return (g_rtcTime % SECS_PER_DAY) / 60; // number of minutes from midnight
+  { MIXSRC_FIRST_TIMER - 1, getTxTimeValue },
 #else
-    if (valid != nullptr) *valid = false;
-    return 0;
+  { MIXSRC_FIRST_TIMER - 1, getInvalidSourceValue },
 #endif
-  } else if (i <= MIXSRC_LAST_TIMER) {
-    return timersStates[i - MIXSRC_FIRST_TIMER].val;
+  { MIXSRC_LAST_TIMER, getTimerValue },
+  { MIXSRC_LAST_TELEM, getTelemetrySourceValue },
+};
+
+// TODO same naming convention than the drawSource
+// *valid added to return status to Lua for invalid sources
+getvalue_t getValue(mixsrc_t i, bool* valid)
+{
+  uint8_t lo = 0;
+  uint8_t hi = DIM(sourceRanges);
+
+  while (lo < hi) {
+    uint8_t mid = (lo + hi) / 2;
+    if (sourceRanges[mid].last < i)
+      lo = mid + 1;
+    else
+      hi = mid;
   }
 
-  else if (i <= MIXSRC_LAST_TELEM) {
-    if (IS_FAI_FORBIDDEN(i)) {
-      if (valid != nullptr) *valid = false;
-      return 0;
-    }
-    i -= MIXSRC_FIRST_TELEM;
-    div_t qr = div(i, 3);
-    TelemetryItem & telemetryItem = telemetryItems[qr.quot];
-    switch (qr.rem) {
-      case 1:
-        return telemetryItem.valueMin;
-      case 2:
-        return telemetryItem.valueMax;
-      default:
-        return telemetryItem.value;
-    }
-  } else {
+  if (lo == DIM(sourceRanges)) {
     if (valid != nullptr) *valid = false;
     return 0;
   }
+
+  return sourceRanges[lo].getValue(i, valid);
 }
 
 void evalTrims()
@@ -652,12 +759,24 @@ int getSourceTrimValue(int source, int stickValue=0)
 
 uint8_t mixerCurrentFlightMode;
 
-void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
+void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms, bitfield_channels_t shared, bool sharedInputs)
 {
-  evalInputs(mode);
+  uint32_t t0 = mixerStatsStart();
 
-  if (tick10ms)
+  if (sharedInputs) {
+    // the inputs computed in the previous pass are the same,
+    // only the trims differ
+    evalTrims();
+  }
+  else {
+    evalInputs(mode);
+  }
+  t0 = mixerStatsStage(MIXER_STAGE_INPUTS, t0);
+
+  if (tick10ms) {
     evalLogicalSwitches(mode==e_perout_mode_normal);
+    t0 = mixerStatsStage(MIXER_STAGE_LOGICAL_SWITCHES, t0);
+  }
 
 #if defined(HELI)
   if (modelHeliEnabled()) {
@@ -727,47 +846,43 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
   }
 #endif
 
-  memclear(chans, sizeof(chans)); // all outputs to 0
+  // all outputs to 0, except the shared ones which keep
+  // the value computed in the previous pass
+  for (uint8_t ch=0; ch<MAX_OUTPUT_CHANNELS; ch++) {
+    if (!(shared & ((bitfield_channels_t)1 << ch)))
+      chans[ch] = 0;
+  }
 
   //========== MIXER LOOP ===============
   uint8_t lv_mixWarning = 0;
 
-  uint8_t pass = 0;
+  const MixPlan& plan = getMixerPlan();
 
-  bitfield_channels_t dirtyChannels = (bitfield_channels_t)-1; // all dirty when mixer starts
+  // channels without any line stay at 0 and can be used right away
+  bitfield_channels_t doneChannels = ~plan.usedChannels | shared;
 
-  do {
-    bitfield_channels_t passDirtyChannels = 0;
+  for (uint8_t c=0; c<plan.channelsCount; c++) {
+    const MixPlanChannel & channel = plan.channels[c];
 
-    for (uint8_t i=0; i<MAX_MIXERS; i++) {
-      if (mode == e_perout_mode_normal && pass == 0)
-        swOn[i].activeMix = 0;
-
-      MixData * md = mixAddress(i);
-
-      if (md->srcRaw == 0)
-#if defined(COLORLCD)
-        continue;
-#else
-        break;
-#endif
+    if (shared & ((bitfield_channels_t)1 << channel.ch))
+      continue;
 
-      mixsrc_t stickIndex = md->srcRaw - MIXSRC_FIRST_STICK;
+    for (uint8_t s=channel.first; s<channel.first+channel.count; s++) {
+      const MixPlanStep & step = plan.steps[s];
+      uint8_t i = step.index;
 
-      if (!(dirtyChannels & ((bitfield_channels_t)1 << md->destCh)))
-        continue;
+      if (mode == e_perout_mode_normal)
+        swOn[i].activeMix = 0;
 
-      // if this is the first calculation for the destination channel, initialize it with 0 (otherwise would be random)
-      if (i == 0 || md->destCh != (md-1)->destCh)
-        chans[md->destCh] = 0;
+      MixData * md = mixAddress(i);
 
       //========== FLIGHT MODE && SWITCH =====
-      bool mixCondition = (md->flightModes != 0 || md->swtch);
+      bool mixCondition = (step.flags & MIX_PLAN_CONDITION);
       delayval_t mixEnabled = (!(md->flightModes & (1 << mixerCurrentFlightMode)) && getSwitch(md->swtch)) ? DELAY_POS_MARGIN+1 : 0;
 
 #define MIXER_LINE_DISABLE()   (mixCondition = true, mixEnabled = 0)
 
-      if (mixEnabled && md->srcRaw >= MIXSRC_FIRST_TRAINER && md->srcRaw <= MIXSRC_LAST_TRAINER && !is_trainer_connected()) {
+      if (mixEnabled && (step.flags & MIX_PLAN_SRC_TRAINER) && !is_trainer_connected()) {
         MIXER_LINE_DISABLE();
       }
 
@@ -790,14 +905,14 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
           continue;
       }
       else {
-        mixsrc_t srcRaw = MIXSRC_FIRST_STICK + stickIndex;
+        mixsrc_t srcRaw = md->srcRaw;
         v = getValue(srcRaw);
         srcRaw -= MIXSRC_FIRST_CH;
-        if (srcRaw <= MIXSRC_LAST_CH-MIXSRC_FIRST_CH && md->destCh != srcRaw) {
-          if (dirtyChannels & ((bitfield_channels_t)1 << srcRaw) & (passDirtyChannels|~(((bitfield_channels_t) 1 << md->destCh)-1)))
-            passDirtyChannels |= (bitfield_channels_t) 1 << md->destCh;
-          if (srcRaw < md->destCh || pass > 0)
-            v = chans[srcRaw] >> 8;
+        // a channel already computed in this cycle is used directly,
+        // otherwise (loops) its output from the previous cycle is used
+        if (srcRaw <= MIXSRC_LAST_CH-MIXSRC_FIRST_CH && md->destCh != srcRaw &&
+            (doneChannels & ((bitfield_channels_t)1 << srcRaw))) {
+          v = chans[srcRaw] >> 8;
         }
         if (!mixCondition) {
           mixEnabled = v;
@@ -860,13 +975,16 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
         }
       }
 
-      int32_t weight = GET_GVAR_PREC1(MD_WEIGHT(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
-      weight = calc100to256_16Bits(weight);
+      int32_t weight = step.weight;
+      if (step.flags & MIX_PLAN_GVAR_WEIGHT) {
+        weight = GET_GVAR_PREC1(MD_WEIGHT(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
+        weight = calc100to256_16Bits(weight);
+      }
       //========== SPEED ===============
       // now its on input side, but without weight compensation. More like other remote controls
       // lower weight causes slower movement
 
-      if (mode <= e_perout_mode_inactive_flight_mode && (md->speedUp || md->speedDown)) { // there are delay values
+      if (mode <= e_perout_mode_inactive_flight_mode && (step.flags & MIX_PLAN_SPEED)) { // there are delay values
 #define DEL_MULT_SHIFT 8
         // we recale to a mult 256 higher value for calculation
         int32_t tact = act[i];
@@ -914,8 +1032,13 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
 
       //========== OFFSET / AFTER ===============
       if (applyOffsetAndCurve) {
-        int32_t offset = GET_GVAR_PREC1(MD_OFFSET(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
-        if (offset) dv += divRoundClosest(calc100toRESX_16Bits(offset), 10) << 8;
+        if (step.flags & MIX_PLAN_GVAR_OFFSET) {
+          int32_t offset = GET_GVAR_PREC1(MD_OFFSET(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
+          if (offset) dv += divRoundClosest(calc100toRESX_16Bits(offset), 10) << 8;
+        }
+        else {
+          dv += step.offset;
+        }
       }
 
       //========== DIFFERENTIAL =========
@@ -987,15 +1110,125 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
 
     } //endfor mixers
 
-    tick10ms = 0;
-    dirtyChannels &= passDirtyChannels;
-
-  } while (++pass < 5 && dirtyChannels);
+    doneChannels |= (bitfield_channels_t)1 << channel.ch;
+  } //endfor channels
 
   mixWarning = lv_mixWarning;
+
+  mixerStatsStage(MIXER_STAGE_MIXES, t0);
+}
+
+
+
+// Flight modes fade
+//
+// Instead of evaluating every fading flight mode from scratch, the mixer
+// lines giving the same output in all of them are evaluated only once.
+// A line is shared when it is enabled in all the fading modes or in none
+// of them, and when neither its source, its switch, nor its GVARs and
+// trims differ between them. Lines keeping a state (slow, delay), and
+// channels within loops, are always evaluated in each mode.
+
+static uint16_t getFadingTrimsDiff(uint16_t modes, uint8_t ref)
+{
+  uint16_t diff = 0;
+  for (uint8_t i = 0; i < keysGetMaxTrims(); i++) {
+    int value = getTrimValue(ref, i);
+    for (uint8_t p = 0; p < MAX_FLIGHT_MODES; p++) {
+      if ((modes & (1 << p)) && getTrimValue(p, i) != value) {
+        diff |= 1 << i;
+        break;
+      }
+    }
+  }
+  return diff;
+}
+
+static bool getFadingGVarsDiff(uint16_t modes, uint8_t ref)
+{
+#if defined(GVARS)
+  for (uint8_t gv = 0; gv < MAX_GVARS; gv++) {
+    int16_t value = GVAR_VALUE(gv, getGVarFlightMode(ref, gv));
+    for (uint8_t p = 0; p < MAX_FLIGHT_MODES; p++) {
+      if ((modes & (1 << p)) && GVAR_VALUE(gv, getGVarFlightMode(p, gv)) != value)
+        return true;
+    }
+  }
+#endif
+  return false;
+}
+
+static bool isFadingModesMaskShared(uint16_t flightModes, uint16_t modes)
+{
+  flightModes &= modes;
+  return flightModes == 0 || flightModes == modes;
 }
 
+static bool areFadingInputsShared(uint16_t modes, bool gvarsDiff)
+{
+  for (uint8_t i = 0; i < MAX_EXPOS; i++) {
+    ExpoData * ed = expoAddress(i);
+    if (!EXPO_VALID(ed)) break; // end of list
+    if (!isFadingModesMaskShared(ed->flightModes, modes))
+      return false;
+    if (isSourceFlightModeDependent(ed->srcRaw) || isSwitchFlightModeDependent(ed->swtch))
+      return false;
+#if defined(GVARS)
+    if (gvarsDiff && (GV_IS_GV_VALUE(ed->weight, -100, 100) ||
+                      GV_IS_GV_VALUE(ed->offset, -100, 100) ||
+                      isCurveRefGVar(ed->curve)))
+      return false;
+#endif
+  }
+  return true;
+}
 
+static bitfield_channels_t getFadingSharedChannels(uint16_t modes, uint8_t ref, bool & sharedInputs)
+{
+  uint16_t trimsDiff = getFadingTrimsDiff(modes, ref);
+  bool gvarsDiff = getFadingGVarsDiff(modes, ref);
+  sharedInputs = areFadingInputsShared(modes, gvarsDiff);
+
+  const MixPlan& plan = getMixerPlan();
+  bitfield_channels_t shared = ~plan.usedChannels;
+
+  for (uint8_t c=0; c<plan.channelsCount; c++) {
+    const MixPlanChannel & channel = plan.channels[c];
+    bitfield_channels_t mask = (bitfield_channels_t)1 << channel.ch;
+
+    if (plan.loopChannels & mask)
+      continue;
+
+    bool isShared = true;
+    for (uint8_t s=channel.first; isShared && s<channel.first+channel.count; s++) {
+      const MixPlanStep & step = plan.steps[s];
+      const MixData * md = mixAddress(step.index);
+      mixsrc_t srcRaw = md->srcRaw;
+
+      if (step.flags & (MIX_PLAN_SPEED | MIX_PLAN_DELAY | MIX_PLAN_FM_SOURCE))
+        isShared = false;
+      else if (gvarsDiff && (step.flags & (MIX_PLAN_GVAR_WEIGHT | MIX_PLAN_GVAR_OFFSET | MIX_PLAN_GVAR_CURVE)))
+        isShared = false;
+      else if (!isFadingModesMaskShared(md->flightModes, modes))
+        isShared = false;
+      else if (!sharedInputs && srcRaw >= MIXSRC_FIRST_INPUT && srcRaw <= MIXSRC_LAST_INPUT)
+        isShared = false;
+      else if (srcRaw >= MIXSRC_FIRST_CH && srcRaw <= MIXSRC_LAST_CH &&
+               !(shared & ((bitfield_channels_t)1 << (srcRaw - MIXSRC_FIRST_CH))))
+        isShared = false;
+      else if (md->carryTrim == 0) {
+        auto origin = getSourceTrimOrigin(srcRaw);
+        if (origin >= 0 && (trimsDiff & (1 << origin)))
+          isShared = false;
+      }
+    }
+
+    if (isShared)
+      shared |= mask;
+  }
+
+  return shared;
+}
 
 #define MAX_ACT 0xffff
 uint8_t lastFlightMode = 255; // TODO reinit everything here when the model changes, no???
@@ -1050,10 +1283,26 @@ void evalMixes(uint8_t tick10ms)
   int32_t weight = 0;
   if (flightModesFade) {
     memclear(sum_chans512, sizeof(sum_chans512));
-    for (uint8_t p=0; p<MAX_FLIGHT_MODES; p++) {
+
+    // the current flight mode is evaluated first and entirely,
+    // the other ones only for the lines which differ
+    uint8_t ref = fm;
+    if (!(flightModesFade & (0x01 << fm))) {
+      for (ref=0; !(flightModesFade & (0x01 << ref)); ref++);
+    }
+
+    bool sharedInputs = false;
+    bitfield_channels_t shared = getFadingSharedChannels(flightModesFade, ref, sharedInputs);
+
+    for (uint8_t n=0; n<MAX_FLIGHT_MODES; n++) {
+      // ref first, then the others in order
+      uint8_t p = (n == 0 ? ref : (n <= ref ? n - 1 : n));
       if (flightModesFade & (0x01 << p)) {
         mixerCurrentFlightMode = p;
-        evalFlightModeMixes(p==fm ? e_perout_mode_normal : e_perout_mode_inactive_flight_mode, p==fm ? tick10ms : 0);
+        if (n == 0)
+          evalFlightModeMixes(p==fm ? e_perout_mode_normal : e_perout_mode_inactive_flight_mode, p==fm ? tick10ms : 0);
+        else
+          evalFlightModeMixes(e_perout_mode_inactive_flight_mode, 0, shared, sharedInputs);
         for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++)
           sum_chans512[i] += limit<int32_t>(-0x6fff, chans[i] >> 4, 0x6fff) * fp_act[p];
         weight += fp_act[p];
@@ -1070,6 +1319,7 @@ void evalMixes(uint8_t tick10ms)
   //========== FUNCTIONS ===============
   // must be done after mixing because some functions use the inputs/channels values
   // must be done before limits because of the applyLimit function: it checks for safety switches which would be not initialized otherwise
+  uint32_t t0 = mixerStatsStart();
   if (tick10ms) {
     requiredSpeakerVolume = g_eeGeneral.speakerVolume + VOLUME_LEVEL_DEF;
   
@@ -1085,6 +1335,7 @@ void evalMixes(uint8_t tick10ms)
     } else {
       modelFunctionsContext.reset();
     }
+    t0 = mixerStatsStage(MIXER_STAGE_FUNCTIONS, t0);
   }
 
   //========== LIMITS ===============
@@ -1102,6 +1353,7 @@ void evalMixes(uint8_t tick10ms)
 
     channelOutputs[i] = value;  // copy consistent word to int-level
   }
+  mixerStatsChannelsUpdated(mixerStatsStage(MIXER_STAGE_LIMITS, t0));
 
   if (tick10ms && flightModesFade) {
     uint16_t tick_delta = delta * tick10ms;
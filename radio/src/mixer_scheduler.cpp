@@ -22,6 +22,27 @@
 #include "opentx.h"
 #include "mixer_scheduler.h"
 #include "tasks/mixer_task.h"
+#include "mixer_stats.h"
+#include "heartbeat_driver.h"
+
+#if !defined(SIMU)
+static uint32_t lastWakeup = 0;
+static uint16_t lastPeriod = 0;
+
+// Records how far the actual wakeup is from the one
+// expected with the period programmed at the previous trigger
+static void mixerSchedulerTrackWakeup()
+{
+  uint32_t now = timersGetUsTick();
+  if (lastPeriod) {
+    mixerStatsSample(MIXER_STATS_WAKEUP_DRIFT,
+                     (int32_t)(now - lastWakeup - lastPeriod));
+  }
+
+  lastWakeup = now;
+  lastPeriod = getMixerSchedulerPeriod();
+}
+#endif
 
 bool mixerSchedulerWaitForTrigger(uint8_t timeoutMs)
 {
@@ -37,10 +58,13 @@ bool mixerSchedulerWaitForTrigger(uint8_t timeoutMs)
 
   if( ulNotificationValue == 1 ) {
     /* The transmission ended as expected. */
+    mixerSchedulerTrackWakeup();
     return false;
 
   } else {
     /* The call to ulTaskNotifyTake() timed out. */
+    // the next trigger does not follow a programmed period
+    lastPeriod = 0;
     return true;
   }
 #else
@@ -49,6 +73,30 @@ bool mixerSchedulerWaitForTrigger(uint8_t timeoutMs)
 #endif
 }
 
+bool mixerScheduleFrameDue(ModuleFrameSchedule& schedule, uint16_t period,
+                           uint16_t mixerPeriod, uint32_t now)
+{
+  if (period <= mixerPeriod) {
+    schedule.decimated = false;
+    return true;
+  }
+
+  // send on the mixer cycle closest to the module frame
+  if (schedule.decimated &&
+      (int32_t)(now - schedule.nextFrame) < -(int32_t)(mixerPeriod / 2)) {
+    return false;
+  }
+
+  schedule.nextFrame += period;
+  if (!schedule.decimated || (int32_t)(now - schedule.nextFrame) >= 0) {
+    // first frame or too late: restart from now
+    schedule.nextFrame = now + period;
+  }
+  schedule.decimated = true;
+
+  return true;
+}
+
 #if !defined(SIMU)
 
 // Global trigger flag
@@ -58,12 +106,37 @@ struct MixerSchedule {
 
   // period in us
   volatile uint16_t period;
+
+  // used when the module runs slower than the mixer
+  ModuleFrameSchedule frame;
 };
 
 static MixerSchedule mixerSchedules[NUM_MODULES];
 
+// Both modules are sent at their own rate, unless the
+// internal module triggers the mixer with its heartbeat
+static bool mixerSchedulerIndependentRates()
+{
+#if defined(HARDWARE_INTERNAL_MODULE) && defined(HARDWARE_EXTERNAL_MODULE)
+#if defined(INTMODULE_HEARTBEAT)
+  if (heartbeatCapture.valid) return false;
+#endif
+  return mixerSchedules[INTERNAL_MODULE].period &&
+         mixerSchedules[EXTERNAL_MODULE].period;
+#else
+  return false;
+#endif
+}
+
 uint16_t getMixerSchedulerPeriod()
 {
+#if defined(HARDWARE_INTERNAL_MODULE) && defined(HARDWARE_EXTERNAL_MODULE)
+  if (mixerSchedulerIndependentRates()) {
+    // the mixer runs at the fastest module rate
+    return min<uint16_t>(mixerSchedules[INTERNAL_MODULE].period,
+                         mixerSchedules[EXTERNAL_MODULE].period);
+  }
+#endif
 #if defined(HARDWARE_INTERNAL_MODULE)
   if (mixerSchedules[INTERNAL_MODULE].period) {
     return mixerSchedules[INTERNAL_MODULE].period;
@@ -104,6 +177,19 @@ uint16_t mixerSchedulerGetPeriod(uint8_t moduleIdx)
   return mixerSchedules[moduleIdx].period;
 }
 
+bool mixerSchedulerIsModuleDue(uint8_t moduleIdx)
+{
+  auto& schedule = mixerSchedules[moduleIdx];
+
+  if (!mixerSchedulerIndependentRates()) {
+    schedule.frame.decimated = false;
+    return true;
+  }
+
+  return mixerScheduleFrameDue(schedule.frame, schedule.period,
+                               getMixerSchedulerPeriod(), timersGetUsTick());
+}
+
 void mixerSchedulerISRTrigger()
 {
   BaseType_t xHigherPriorityTaskWoken = pdFALSE;
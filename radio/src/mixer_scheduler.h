@@ -46,6 +46,11 @@ void mixerSchedulerSetPeriod(uint8_t moduleIdx, uint16_t periodUs);
 // Get the scheduling period for a given module
 uint16_t mixerSchedulerGetPeriod(uint8_t moduleIdx);
 
+// Returns true if the given module should be sent the channels
+// in the current mixer cycle (i.e. when both modules run at
+// independent rates, the slower one skips some cycles)
+bool mixerSchedulerIsModuleDue(uint8_t moduleIdx);
+
 // Enable the timer trigger
 void mixerSchedulerEnableTrigger();
 
@@ -68,6 +73,7 @@ void mixerSchedulerISRTrigger();
 #define mixerSchedulerStop()
 #define mixerSchedulerSetPeriod(m,p) ((void)(p))
 #define mixerSchedulerGetPeriod(m) ((uint16_t)MIXER_SCHEDULER_DEFAULT_PERIOD_US)
+#define mixerSchedulerIsModuleDue(m) (true)
 
 #define mixerSchedulerEnableTrigger()
 #define mixerSchedulerDisableTrigger()
@@ -79,6 +85,17 @@ void mixerSchedulerISRTrigger();
 
 #endif
 
+// Frame timing of a module running slower than the mixer
+struct ModuleFrameSchedule {
+  uint32_t nextFrame;  // next frame (us)
+  bool decimated;
+};
+
+// Returns true if a module sending a frame every 'period' us should
+// be sent the channels of the mixer cycle starting at 'now'
+bool mixerScheduleFrameDue(ModuleFrameSchedule& schedule, uint16_t period,
+                           uint16_t mixerPeriod, uint32_t now);
+
 // Wait for the scheduler timer to trigger
 // returns true if timeout, false otherwise
 bool mixerSchedulerWaitForTrigger(uint8_t timeoutMs);
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "opentx.h"
+#include "mixer_stats.h"
+
+struct MixerStageHistogram {
+  uint32_t count;
+  uint16_t last;
+  uint16_t max;
+  uint16_t buckets[MIXER_STATS_BUCKETS];
+};
+
+static const char * const _mixer_stage_names[MIXER_STATS_COUNT] = {
+  "adc",
+  "switches",
+  "inputs",
+  "ls",
+  "mixes",
+  "functions",
+  "limits",
+  "pulses",
+  "wakeup",
+  "sync",
+  "stale_int",
+  "stale_ext",
+};
+
+// written by the mixer task, except the sync lag histogram
+// which is fed by telemetry
+static MixerStageHistogram _mixer_stats[MIXER_STATS_COUNT];
+static uint32_t _mixer_cycle[MIXER_STAGE_COUNT];
+static uint8_t _mixer_cycle_stages = 0;
+
+static uint32_t _mixer_channels_time = 0;
+
+static volatile bool _mixer_stats_reset = false;
+
+static uint8_t getBucket(uint32_t us)
+{
+  uint8_t bucket = 0;
+  while (us && bucket < MIXER_STATS_BUCKETS - 1) {
+    us >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+uint32_t mixerStatsStart()
+{
+  return timersGetUsTick();
+}
+
+uint32_t mixerStatsStage(uint8_t stage, uint32_t start)
+{
+  uint32_t now = timersGetUsTick();
+  _mixer_cycle[stage] += now - start;
+  _mixer_cycle_stages |= 1 << stage;
+  return now;
+}
+
+static void pushSample(MixerStageHistogram & histogram, uint32_t us)
+{
+  uint16_t duration = min<uint32_t>(us, UINT16_MAX);
+
+  histogram.count++;
+  histogram.last = duration;
+  if (duration > histogram.max)
+    histogram.max = duration;
+
+  uint16_t & bucket = histogram.buckets[getBucket(duration)];
+  if (bucket == UINT16_MAX) {
+    // keep the distribution shape, forget about the oldest samples
+    for (auto & b : histogram.buckets) {
+      b >>= 1;
+    }
+  }
+  bucket++;
+}
+
+void mixerStatsSample(uint8_t stats, int32_t us)
+{
+  pushSample(_mixer_stats[stats], us < 0 ? -us : us);
+}
+
+void mixerStatsChannelsUpdated(uint32_t time)
+{
+  _mixer_channels_time = time;
+}
+
+void mixerStatsChannelsSent(uint8_t module)
+{
+  pushSample(_mixer_stats[MIXER_STATS_STALENESS + module],
+             timersGetUsTick() - _mixer_channels_time);
+}
+
+void mixerStatsCommit()
+{
+  if (_mixer_stats_reset) {
+    // the current cycle may have started before the reset request
+    memclear(_mixer_stats, sizeof(_mixer_stats));
+    memclear(_mixer_cycle, sizeof(_mixer_cycle));
+    _mixer_cycle_stages = 0;
+    _mixer_stats_reset = false;
+    return;
+  }
+
+  for (uint8_t stage = 0; stage < MIXER_STAGE_COUNT; stage++) {
+    if (!(_mixer_cycle_stages & (1 << stage)))
+      continue;
+
+    pushSample(_mixer_stats[stage], _mixer_cycle[stage]);
+    _mixer_cycle[stage] = 0;
+  }
+
+  _mixer_cycle_stages = 0;
+}
+
+void mixerStatsReset()
+{
+  _mixer_stats_reset = true;
+}
+
+static uint16_t getPercentile(const MixerStageHistogram & histogram, uint32_t total, uint8_t percent)
+{
+  uint32_t sum = 0;
+  for (uint8_t i = 0; i < MIXER_STATS_BUCKETS; i++) {
+    sum += histogram.buckets[i];
+    if (sum * 100 >= total * percent) {
+      return min<uint32_t>((1u << i) - 1, histogram.max);
+    }
+  }
+  return histogram.max;
+}
+
+void mixerStatsGet(uint8_t stage, MixerStageStats & stats)
+{
+  const MixerStageHistogram & histogram = _mixer_stats[stage];
+
+  uint32_t total = 0;
+  for (auto b : histogram.buckets) {
+    total += b;
+  }
+
+  stats.count = histogram.count;
+  stats.last = histogram.last;
+  stats.max = histogram.max;
+  if (total) {
+    stats.p50 = getPercentile(histogram, total, 50);
+    stats.p99 = getPercentile(histogram, total, 99);
+  }
+  else {
+    stats.p50 = stats.p99 = 0;
+  }
+}
+
+const char * mixerStageName(uint8_t stage)
+{
+  return stage < MIXER_STATS_COUNT ? _mixer_stage_names[stage] : "";
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "dataconstants.h"
+
+// Per-stage mixer profiling, available in release builds.
+//
+// Each mixer cycle accumulates the time spent in every stage
+// (a stage may run several times per cycle, e.g. during a flight
+// mode fade). At the end of the cycle, mixerStatsCommit() pushes
+// the stages that ran into log2 histograms (bucket N holds durations
+// up to 2^N us), from which p50 / p99 are estimated.
+//
+// The scheduler timing errors (wakeup drift and module sync lag)
+// are recorded as absolute values in the same kind of histograms,
+// as well as the age of the channels sent to each module.
+
+enum MixerStages {
+  MIXER_STAGE_ADC,
+  MIXER_STAGE_SWITCHES,
+  MIXER_STAGE_INPUTS,
+  MIXER_STAGE_LOGICAL_SWITCHES,
+  MIXER_STAGE_MIXES,
+  MIXER_STAGE_FUNCTIONS,
+  MIXER_STAGE_LIMITS,
+  MIXER_STAGE_PULSES,
+  MIXER_STAGE_COUNT,
+
+  // scheduler timing errors
+  MIXER_STATS_WAKEUP_DRIFT = MIXER_STAGE_COUNT,
+  MIXER_STATS_SYNC_LAG,
+
+  // channels age when sent to each module
+  MIXER_STATS_STALENESS,
+  MIXER_STATS_COUNT = MIXER_STATS_STALENESS + NUM_MODULES
+};
+
+#define MIXER_STATS_BUCKETS  16
+
+struct MixerStageStats {
+  uint32_t count; // number of cycles in which the stage ran (or samples)
+  uint16_t last;  // us
+  uint16_t p50;   // us (bucket upper bound)
+  uint16_t p99;   // us (bucket upper bound)
+  uint16_t max;   // us
+};
+
+// Returns the current timestamp (us) to start a measurement
+uint32_t mixerStatsStart();
+
+// Adds the time elapsed since 'start' to the given stage and
+// returns the current timestamp, so that stages can be chained
+uint32_t mixerStatsStage(uint8_t stage, uint32_t start);
+
+// Records a scheduler timing error (us, signed)
+void mixerStatsSample(uint8_t stats, int32_t us);
+
+// Marks the channel outputs as updated
+void mixerStatsChannelsUpdated(uint32_t time);
+
+// Records the age of the channels sent to a module
+void mixerStatsChannelsSent(uint8_t module);
+
+// Closes the current mixer cycle
+void mixerStatsCommit();
+
+// Clears all the histograms, the current cycle is dropped
+// on the next commit
+void mixerStatsReset();
+
+void mixerStatsGet(uint8_t stage, MixerStageStats & stats);
+
+const char * mixerStageName(uint8_t stage);
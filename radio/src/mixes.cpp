@@ -50,10 +50,11 @@ void insertMix(uint8_t idx, uint8_t channel)
     }
   }
   mix->weight = 100;
+  invalidateMixerPlan();
   mixerTaskStart();
 
   _nb_mix_lines += 1;
-  storageDirty(EE_MODEL);
+  storageConfigDirty(EE_MODEL);
 }
 
 void deleteMix(uint8_t idx)
@@ -62,10 +63,11 @@ void deleteMix(uint8_t idx)
   MixData * mix = mixAddress(idx);
   memmove(mix, mix + 1, (MAX_MIXERS - (idx + 1)) * sizeof(MixData));
   memclear(&g_model.mixData[MAX_MIXERS - 1], sizeof(MixData));
+  invalidateMixerPlan();
   mixerTaskStart();
 
   _nb_mix_lines -= 1;
-  storageDirty(EE_MODEL);
+  storageConfigDirty(EE_MODEL);
 }
 
 void copyMix(uint8_t src, uint8_t dst, uint8_t channel)
@@ -78,10 +80,11 @@ void copyMix(uint8_t src, uint8_t dst, uint8_t channel)
   memmove(mix + 1, mix, trailingMixes * sizeof(MixData));
   memcpy(mix, &sourceMix, sizeof(MixData));
   mix->destCh = channel;
+  invalidateMixerPlan();
   mixerTaskStart();
 
   _nb_mix_lines += 1;
-  storageDirty(EE_MODEL);
+  storageConfigDirty(EE_MODEL);
 }
 
 // Move the mixer line at 'idx' up or down
@@ -96,7 +99,7 @@ uint8_t moveMix(uint8_t idx, bool up)
   if (tgt_idx < 0) {
     if (x->destCh > 0) {
       x->destCh--;
-      storageDirty(EE_MODEL);
+      storageConfigDirty(EE_MODEL);
     }
     return idx;
   }
@@ -104,7 +107,7 @@ uint8_t moveMix(uint8_t idx, bool up)
   if (tgt_idx == MAX_MIXERS) {
     if (x->destCh < MAX_OUTPUT_CHANNELS - 1) {
       x->destCh++;
-      storageDirty(EE_MODEL);
+      storageConfigDirty(EE_MODEL);
     }
     return idx;
   }
@@ -122,13 +125,13 @@ uint8_t moveMix(uint8_t idx, bool up)
     if (up) {
       if (destCh > 0) {
 	x->destCh--;
-	storageDirty(EE_MODEL);
+	storageConfigDirty(EE_MODEL);
       }
     }
     else {
       if (destCh < MAX_OUTPUT_CHANNELS - 1) {
 	x->destCh++;
-	storageDirty(EE_MODEL);
+	storageConfigDirty(EE_MODEL);
       }
     }
     return idx;
@@ -136,9 +139,10 @@ uint8_t moveMix(uint8_t idx, bool up)
 
   mixerTaskStop();
   memswap(x, y, sizeof(MixData));
+  invalidateMixerPlan();
   mixerTaskStart();
 
-  storageDirty(EE_MODEL);
+  storageConfigDirty(EE_MODEL);
   return tgt_idx;
 }
 
@@ -156,4 +160,252 @@ static uint8_t _countMixLines()
 void updateMixCount()
 {
   _nb_mix_lines = _countMixLines();
+  invalidateMixerPlan();
+}
+
+static MixPlan _mixer_plan;
+static bool _mixer_plan_valid = false;
+
+void invalidateMixerPlan() { _mixer_plan_valid = false; }
+
+static bool isMixParamGVar(int16_t val)
+{
+#if defined(GVARS)
+  return GV_IS_GV_VALUE(val, GV_RANGELARGE_NEG, GV_RANGELARGE);
+#else
+  return false;
+#endif
+}
+
+bool isSourceFlightModeDependent(mixsrc_t source)
+{
+  return (source >= MIXSRC_FIRST_HELI && source <= MIXSRC_LAST_TRIM) ||
+         (source >= MIXSRC_FIRST_LOGICAL_SWITCH && source <= MIXSRC_LAST_LOGICAL_SWITCH) ||
+         (source >= MIXSRC_FIRST_GVAR && source <= MIXSRC_LAST_GVAR);
+}
+
+bool isSwitchFlightModeDependent(swsrc_t swtch)
+{
+  swtch = abs(swtch);
+  return (swtch >= SWSRC_FIRST_LOGICAL_SWITCH && swtch <= SWSRC_LAST_LOGICAL_SWITCH) ||
+         (swtch >= SWSRC_FIRST_FLIGHT_MODE && swtch <= SWSRC_LAST_FLIGHT_MODE);
+}
+
+bool isCurveRefGVar(const CurveRef& curve)
+{
+#if defined(GVARS)
+  return (curve.type == CURVE_REF_DIFF || curve.type == CURVE_REF_EXPO) &&
+         GV_IS_GV_VALUE(curve.value, -100, 100);
+#else
+  return false;
+#endif
+}
+
+static void buildMixerStep(MixPlanStep& step, uint8_t i, const MixData* md)
+{
+  step.index = i;
+  step.flags = 0;
+  step.weight = 0;
+  step.offset = 0;
+
+  if (md->flightModes != 0 || md->swtch)
+    step.flags |= MIX_PLAN_CONDITION;
+
+  if (md->srcRaw >= MIXSRC_FIRST_TRAINER && md->srcRaw <= MIXSRC_LAST_TRAINER)
+    step.flags |= MIX_PLAN_SRC_TRAINER;
+
+  if (md->speedUp || md->speedDown)
+    step.flags |= MIX_PLAN_SPEED;
+
+  if (md->delayUp || md->delayDown)
+    step.flags |= MIX_PLAN_DELAY;
+
+  if (isSourceFlightModeDependent(md->srcRaw) ||
+      isSwitchFlightModeDependent(md->swtch))
+    step.flags |= MIX_PLAN_FM_SOURCE;
+
+  if (isCurveRefGVar(md->curve))
+    step.flags |= MIX_PLAN_GVAR_CURVE;
+
+  // constant weight and offset do not depend on the flight mode
+  if (isMixParamGVar(MD_WEIGHT(md))) {
+    step.flags |= MIX_PLAN_GVAR_WEIGHT;
+  } else {
+    int32_t weight = GET_GVAR_PREC1(MD_WEIGHT(md), GV_RANGELARGE_NEG,
+                                    GV_RANGELARGE, 0);
+    step.weight = calc100to256_16Bits(weight);
+  }
+
+  if (isMixParamGVar(MD_OFFSET(md))) {
+    step.flags |= MIX_PLAN_GVAR_OFFSET;
+  } else {
+    int32_t offset = GET_GVAR_PREC1(MD_OFFSET(md), GV_RANGELARGE_NEG,
+                                    GV_RANGELARGE, 0);
+    if (offset)
+      step.offset = divRoundClosest(calc100toRESX_16Bits(offset), 10) << 8;
+  }
+}
+
+// channels used as source by each channel
+static bitfield_channels_t _channel_deps[MAX_OUTPUT_CHANNELS];
+
+static uint8_t buildMixerSteps(uint8_t ch, uint8_t count)
+{
+  for (uint8_t i = 0; i < MAX_MIXERS; i++) {
+    const MixData* md = mixAddress(i);
+
+    if (md->srcRaw == 0)
+#if defined(COLORLCD)
+      continue;
+#else
+      break;
+#endif
+
+    if (md->destCh != ch)
+      continue;
+
+    buildMixerStep(_mixer_plan.steps[count++], i, md);
+
+    if (md->srcRaw >= MIXSRC_FIRST_CH && md->srcRaw <= MIXSRC_LAST_CH) {
+      uint8_t src = md->srcRaw - MIXSRC_FIRST_CH;
+      if (src != ch)
+        _channel_deps[ch] |= (bitfield_channels_t)1 << src;
+    }
+  }
+
+  return count;
+}
+
+// channels reached through the dependencies of each channel
+static bitfield_channels_t _channel_reach[MAX_OUTPUT_CHANNELS];
+
+static bitfield_channels_t findMixerLoops(bitfield_channels_t used)
+{
+  // transitive closure of the channel dependencies
+  bitfield_channels_t* reach = _channel_reach;
+  for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS; ch++) {
+    reach[ch] = _channel_deps[ch] & used;
+  }
+
+  bool changed;
+  do {
+    changed = false;
+    for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS; ch++) {
+      bitfield_channels_t r = reach[ch];
+      for (uint8_t src = 0; src < MAX_OUTPUT_CHANNELS; src++) {
+        if (reach[ch] & ((bitfield_channels_t)1 << src))
+          r |= reach[src];
+      }
+      if (r != reach[ch]) {
+        reach[ch] = r;
+        changed = true;
+      }
+    }
+  } while (changed);
+
+  bitfield_channels_t loops = 0;
+  for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS; ch++) {
+    if (reach[ch] & ((bitfield_channels_t)1 << ch))
+      loops |= (bitfield_channels_t)1 << ch;
+  }
+  return loops;
+}
+
+static int nextLoopChannel(bitfield_channels_t remaining)
+{
+  bitfield_channels_t loops = remaining & _mixer_plan.loopChannels;
+  // prefer a channel whose pending sources all depend back on it,
+  // so that no loop is entered before the loops feeding it
+  int lowest = -1;
+  for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS; ch++) {
+    bitfield_channels_t mask = (bitfield_channels_t)1 << ch;
+    if (!(loops & mask))
+      continue;
+    if (lowest < 0)
+      lowest = ch;
+    bool ready = true;
+    for (uint8_t src = 0; src < MAX_OUTPUT_CHANNELS; src++) {
+      if ((_channel_deps[ch] & ((bitfield_channels_t)1 << src)) &&
+          (remaining & ((bitfield_channels_t)1 << src)) &&
+          !(_channel_reach[src] & mask)) {
+        ready = false;
+        break;
+      }
+    }
+    if (ready)
+      return ch;
+  }
+  return lowest;
+}
+
+static void buildMixerPlan()
+{
+  uint8_t first[MAX_OUTPUT_CHANNELS];
+  uint8_t count = 0;
+  bitfield_channels_t used = 0;
+
+  for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS; ch++) {
+    _channel_deps[ch] = 0;
+    first[ch] = count;
+    count = buildMixerSteps(ch, count);
+    if (count > first[ch])
+      used |= (bitfield_channels_t)1 << ch;
+  }
+
+  _mixer_plan.count = count;
+  _mixer_plan.usedChannels = used;
+  _mixer_plan.loopChannels = findMixerLoops(used);
+
+  if (_mixer_plan.loopChannels) {
+    TRACE("Mixer loop detected on channels 0x%08x",
+          (unsigned)_mixer_plan.loopChannels);
+  }
+
+  // topological sort: a channel is evaluated once all the
+  // channels it depends on are; when only loops and the
+  // channels reading from them remain, the lowest channel
+  // of a loop that only waits on itself is taken first
+  bitfield_channels_t remaining = used;
+  uint8_t n = 0;
+  while (remaining) {
+    int next = -1;
+    for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS; ch++) {
+      if ((remaining & ((bitfield_channels_t)1 << ch)) &&
+          !(_channel_deps[ch] & remaining)) {
+        next = ch;
+        break;
+      }
+    }
+    if (next < 0) {
+      next = nextLoopChannel(remaining);
+    }
+    if (next < 0) {
+      for (next = 0; !(remaining & ((bitfield_channels_t)1 << next)); next++);
+    }
+
+    remaining &= ~((bitfield_channels_t)1 << next);
+
+    MixPlanChannel& channel = _mixer_plan.channels[n++];
+    channel.ch = next;
+    channel.first = first[next];
+    channel.count = (next < MAX_OUTPUT_CHANNELS - 1 ? first[next + 1] : count) - first[next];
+  }
+
+  _mixer_plan.channelsCount = n;
+}
+
+bitfield_channels_t getMixerLoopChannels()
+{
+  return _mixer_plan.loopChannels;
+}
+
+const MixPlan& getMixerPlan()
+{
+  if (!_mixer_plan_valid) {
+    // mark as valid first, so that an edit
+    // happening while building triggers a rebuild
+    _mixer_plan_valid = true;
+    buildMixerPlan();
+  }
+  return _mixer_plan;
 }
@@ -22,8 +22,11 @@
 #pragma once
 
 #include <stdint.h>
+#include "dataconstants.h"
+#include "opentx_types.h"
 
 struct MixData;
+struct CurveRef;
 
 // Get a pointer to a mixer line
 MixData* mixAddress(uint8_t idx);
@@ -46,3 +49,73 @@ uint8_t getMixCount();
 // Should only be called from storage
 // right after a model has been loaded
 void updateMixCount();
+
+// Compiled mixer plan
+//
+// Built from the mixer lines whenever the model is loaded
+// or edited, so that the mixer only walks the lines in use
+// and does not resolve constant parameters on every cycle.
+//
+// Channels are evaluated in dependency order (channels used
+// as a source by other channels come first), so that a single
+// pass is enough whatever the depth of the channel chains.
+
+enum MixPlanFlags {
+  MIX_PLAN_CONDITION   = 0x01,  // line has a switch or flight mode condition
+  MIX_PLAN_SRC_TRAINER = 0x02,
+  MIX_PLAN_GVAR_WEIGHT = 0x04,  // weight must be resolved at runtime
+  MIX_PLAN_GVAR_OFFSET = 0x08,  // offset must be resolved at runtime
+  MIX_PLAN_SPEED       = 0x10,  // slow up / down configured
+  MIX_PLAN_DELAY       = 0x20,  // delay up / down configured
+  MIX_PLAN_FM_SOURCE   = 0x40,  // source or switch depends on the flight mode
+  MIX_PLAN_GVAR_CURVE  = 0x80,  // differential / expo must be resolved at runtime
+};
+
+struct MixPlanStep {
+  uint8_t index;   // mixer line
+  uint8_t flags;
+  int16_t weight;  // weight scaled to 256 (unless MIX_PLAN_GVAR_WEIGHT)
+  int32_t offset;  // offset scaled like chans[] (unless MIX_PLAN_GVAR_OFFSET)
+};
+
+struct MixPlanChannel {
+  uint8_t ch;      // destination channel
+  uint8_t first;   // first step
+  uint8_t count;   // number of steps
+};
+
+struct MixPlan {
+  // steps grouped by destination channel, in line order
+  uint8_t count;
+  MixPlanStep steps[MAX_MIXERS];
+
+  // channels with at least one line, in evaluation order
+  uint8_t channelsCount;
+  MixPlanChannel channels[MAX_OUTPUT_CHANNELS];
+
+  bitfield_channels_t usedChannels;
+
+  // channels being part of a loop (CH1 -> CH2 -> CH1):
+  // within a loop, a channel not yet evaluated in the
+  // current cycle is read from the previous cycle
+  bitfield_channels_t loopChannels;
+};
+
+// Mark the compiled plan as outdated
+void invalidateMixerPlan();
+
+// Get the compiled plan, rebuilding it if needed.
+// Should only be called from the mixer.
+const MixPlan& getMixerPlan();
+
+// Channels being part of a loop in the plan last built by the mixer,
+// so that the UI can flag them (updated in the cycle following an edit)
+bitfield_channels_t getMixerLoopChannels();
+
+// Sources and switches whose value depends on the flight mode
+// being evaluated (trims, GVARs, logical switches, ...)
+bool isSourceFlightModeDependent(mixsrc_t source);
+bool isSwitchFlightModeDependent(swsrc_t swtch);
+
+// Differential or expo given by a GVAR
+bool isCurveRefGVar(const CurveRef& curve);
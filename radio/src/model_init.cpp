@@ -43,7 +43,7 @@ void setDefaultInputs()
     strncpy(g_model.inputNames[i], getMainControlLabel(stick_index), LEN_INPUT_NAME);
   }
 
-  storageDirty(EE_MODEL);
+  storageConfigDirty(EE_MODEL);
 }
 
 void clearMixes()
@@ -60,7 +60,7 @@ void setDefaultMixes()
     mix->weight = 100;
     mix->srcRaw = i+1;
   }
-  storageDirty(EE_MODEL);
+  storageConfigDirty(EE_MODEL);
 }
 
 void setDefaultModelRegistrationID()
@@ -79,6 +79,7 @@
 #define CFN_PLAY_REPEAT_NOSTART        0xFF
 #define CFN_GVAR_MODE(p)               ((p)->all.mode)
 #define CFN_PARAM(p)                   ((p)->all.val)
+#define CFN_LOGS_FORMAT(p)             ((p)->all.mode)
 #define CFN_RESET(p)                   ((p)->active=0, (p)->clear.val1=0, (p)->clear.val2=0)
 #define CFN_GVAR_CST_MIN               -GVAR_MAX
 #define CFN_GVAR_CST_MAX               GVAR_MAX
@@ -294,5 +295,6 @@ PACK(union u_int8int16_t {
 constexpr uint8_t EE_GENERAL = 0x01;
 constexpr uint8_t EE_MODEL = 0x02;
 constexpr uint8_t EE_LABELS = 0x04;
+constexpr uint8_t EE_SNAPSHOT = 0x08;
 
 #endif // _MYEEPROM_H_
@@ -437,7 +437,7 @@ extern uint8_t flightModeTransitionLast;
 extern uint32_t availableMemory();
 
 
-void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms);
+void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms, bitfield_channels_t shared = 0, bool sharedInputs = false);
 void evalMixes(uint8_t tick10ms);
 void doMixerCalculations();
 void doMixerPeriodicUpdates();
@@ -1065,6 +1065,13 @@ extern uint8_t s_frsky_view;
 
 constexpr uint32_t EARTH_RADIUS = 6371009;
 
+// Flat-earth projection around the pilot position, with the coordinates
+// in 1e-6 degrees and the scales in meters per 1e-6 degree * 2^32
+constexpr uint32_t GPS_LATITUDE_SCALE = EARTH_RADIUS * M_PI / 180 * 4294.967296;
+uint32_t gpsLongitudeScale(int32_t latitude);
+uint16_t gpsDistance(int32_t dlat, int32_t dlon, uint32_t lonScale);
+uint16_t gpsBearing(int32_t dlat, int32_t dlon, uint32_t lonScale);
+
 void varioWakeup();
 
 #if defined(AUDIO) && defined(BUZZER)
@@ -82,9 +82,11 @@ static void afhds2SendPulses(void* ctx, uint8_t* buffer, int16_t* channels, uint
   drv->sendBuffer(drv_ctx, buffer, p_data - buffer);
 }
 
-static void afhds2ProcessData(void*, uint8_t data, uint8_t* buffer, uint8_t* len)
+static void afhds2ProcessData(void*, const uint8_t* data, uint8_t dlen, uint8_t* buffer, uint8_t* len)
 {
-  processInternalFlySkyTelemetryData(data, buffer, len);
+  for (uint8_t i = 0; i < dlen; i++) {
+    processInternalFlySkyTelemetryData(data[i], buffer, len);
+  }
 }
 
 const etx_proto_driver_t Afhds2InternalDriver = {
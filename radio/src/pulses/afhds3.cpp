@@ -268,7 +268,7 @@ class ProtoState
 
   private:
     //friendship declaration - use for passing telemetry
-    friend void processTelemetryData(void* ctx, uint8_t data, uint8_t* buffer, uint8_t* len);
+    friend void processTelemetryData(void* ctx, const uint8_t* data, uint8_t dlen, uint8_t* buffer, uint8_t* len);
 
     void processTelemetryData(uint8_t data, uint8_t* buffer, uint8_t* len);
 
@@ -370,11 +370,13 @@ void getStatusString(uint8_t module, char* buffer)
 }
 
 //friends function that can access telemetry parsing method
-void processTelemetryData(void* ctx, uint8_t data, uint8_t* buffer, uint8_t* len)
+void processTelemetryData(void* ctx, const uint8_t* data, uint8_t dlen, uint8_t* buffer, uint8_t* len)
 {
   auto mod_st = (etx_module_state_t*)ctx;
   auto p_state = (ProtoState*)mod_st->user_data;
-  p_state->processTelemetryData(data, buffer, len);
+  for (uint8_t i = 0; i < dlen; i++) {
+    p_state->processTelemetryData(data[i], buffer, len);
+  }
 }
 
 void ProtoState::getStatusString(char* buffer) const
@@ -31,6 +31,7 @@
 
 #include "crossfire.h"
 #include "telemetry/crossfire.h"
+#include "telemetry/telemetry_stats.h"
 
 #define CROSSFIRE_CH_BITS           11
 #define CROSSFIRE_CENTER            0x3E0
@@ -150,7 +151,13 @@ static bool _lenIsSane(uint8_t len)
 static void crossfireProcessFrame(void* ctx, uint8_t* frame, uint8_t frame_len,
                                   uint8_t* buf, uint8_t* p_len)
 {
-  if (frame_len < MIN_FRAME_LEN) return;
+  auto mod_st = (etx_module_state_t*)ctx;
+  auto module = modulePortGetModule(mod_st);
+
+  if (frame_len < MIN_FRAME_LEN) {
+    telemetryStatsSizeError(module);
+    return;
+  }
 
   // De-Fragmentation:
   //   It is assumed here that a continuation chunk
@@ -178,6 +185,7 @@ static void crossfireProcessFrame(void* ctx, uint8_t* frame, uint8_t frame_len,
       }
     } else {
       TRACE("[XF] overshoot (%d > %d)", defrag_len, unfrag_len);
+      telemetryStatsSizeError(module);
     }
   }
 
@@ -188,6 +196,7 @@ static void crossfireProcessFrame(void* ctx, uint8_t* frame, uint8_t frame_len,
     uint8_t unfrag_len = buf[1] + 2;
     if (!_lenIsSane(unfrag_len)) {
       TRACE("[XF] pkt len error (%d)", unfrag_len);
+      telemetryStatsSizeError(module);
       len = 0;
       return;
     }
@@ -203,14 +212,17 @@ static void crossfireProcessFrame(void* ctx, uint8_t* frame, uint8_t frame_len,
     uint8_t pkt_len = p_buf[1] + 2;
     if (pkt_len > len) {
       TRACE("[XF] length error (%d > %d)", pkt_len, len);
+      telemetryStatsSizeError(module);
       len = 0;
       return;
     }
 
+    telemetryStatsFrame(module);
     if (p_buf[0] != RADIO_ADDRESS && p_buf[0] != UART_SYNC) {
       TRACE("[XF] address 0x%02X error", p_buf[0]);
     } else if (!_checkFrameCRC(p_buf)) {
       TRACE("[XF] CRC error ");
+      telemetryStatsCrcError(module);
     } else {
 #if defined(BLUETOOTH)
       // TODO: generic telemetry mirror to BT
@@ -219,8 +231,6 @@ static void crossfireProcessFrame(void* ctx, uint8_t* frame, uint8_t frame_len,
         bluetooth.write(p_buf, pkt_len);
       }
 #endif
-      auto mod_st = (etx_module_state_t*)ctx;
-      auto module = modulePortGetModule(mod_st);
       processCrossfireTelemetryFrame(module, p_buf, pkt_len);
     }
 
@@ -281,12 +281,12 @@ static void dsmpSendPulses(void* ctx, uint8_t* buffer, int16_t* channels, uint8_
   _dsm_send(mod_st, buffer, p_data - buffer);
 }
 
-static void dsmpProcessData(void* ctx, uint8_t data, uint8_t* buffer, uint8_t* len)
+static void dsmpProcessData(void* ctx, const uint8_t* data, uint8_t dlen, uint8_t* buffer, uint8_t* len)
 {
   auto mod_st = (etx_module_state_t*)ctx;
   auto module = modulePortGetModule(mod_st);
 
-  processSpektrumTelemetryData(module, data, buffer, *len);
+  processSpektrumTelemetryData(module, data, dlen, buffer, *len);
 }
 
 // No telemetry
@@ -23,6 +23,7 @@
 #include "ghost.h"
 #include "telemetry/ghost.h"
 #include "telemetry/ghost_menu.h"
+#include "telemetry/telemetry_stats.h"
 #include "hal/module_port.h"
 #include "mixer_scheduler.h"
 
@@ -220,7 +221,7 @@ static void ghostSendPulses(void* ctx, uint8_t* buffer, int16_t* channels, uint8
   drv->sendBuffer(drv_ctx, buffer, p_data - buffer);
 }
 
-static void ghostProcessData(void* ctx, uint8_t data, uint8_t* buffer, uint8_t* len)
+static void ghostProcessByte(void* ctx, uint8_t data, uint8_t* buffer, uint8_t* len)
 {
   if (*len == 0 && data != GHST_ADDR_RADIO) {
     TRACE("[GH] address 0x%02X error", data);
@@ -232,6 +233,7 @@ static void ghostProcessData(void* ctx, uint8_t data, uint8_t* buffer, uint8_t*
   }
   else {
     TRACE("[GH] array size %d error", *len);
+    telemetryStatsSizeError(modulePortGetModule((etx_module_state_t*)ctx));
     *len = 0;
   }
 
@@ -246,6 +248,13 @@ static void ghostProcessData(void* ctx, uint8_t data, uint8_t* buffer, uint8_t*
   }
 }
 
+static void ghostProcessData(void* ctx, const uint8_t* data, uint8_t dlen, uint8_t* buffer, uint8_t* len)
+{
+  for (uint8_t i = 0; i < dlen; i++) {
+    ghostProcessByte(ctx, data[i], buffer, len);
+  }
+}
+
 const etx_proto_driver_t GhostDriver = {
   .protocol = PROTOCOL_CHANNELS_GHOST,
   .init = ghostInit,
@@ -270,12 +270,12 @@ static void multiSendPulses(void* ctx, uint8_t* buffer, int16_t* channels, uint8
   drv->sendBuffer(drv_ctx, buffer, data - buffer);
 }
 
-static void multiProcessData(void* ctx, uint8_t data, uint8_t* buffer, uint8_t* len)
+static void multiProcessData(void* ctx, const uint8_t* data, uint8_t dlen, uint8_t* buffer, uint8_t* len)
 {
   auto mod_st = (etx_module_state_t*)ctx;
   auto module = modulePortGetModule(mod_st);
 
-  processMultiTelemetryData(data, module);
+  processMultiTelemetryData(data, dlen, module);
 }
 
 #include "hal/module_driver.h"
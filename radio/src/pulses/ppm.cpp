@@ -192,12 +192,14 @@ static void ppmSendPulses(void* ctx, uint8_t* buffer, int16_t* channels, uint8_t
   mixerSchedulerSetPeriod(module, PPM_PERIOD(module));
 }
 
-static void ppmProcessTelemetryData(void* ctx, uint8_t data, uint8_t* buffer, uint8_t* len) {
+static void ppmProcessTelemetryData(void* ctx, const uint8_t* data, uint8_t dlen, uint8_t* buffer, uint8_t* len) {
   auto mod_st = (etx_module_state_t*)ctx;
   auto module = modulePortGetModule(mod_st);
 
   if (_processTelemetryData) {
-    _processTelemetryData(module, data, buffer, len);
+    for (uint8_t i = 0; i < dlen; i++) {
+      _processTelemetryData(module, data[i], buffer, len);
+    }
   }
 }
 
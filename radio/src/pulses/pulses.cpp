@@ -23,6 +23,7 @@
 #include "opentx.h"
 
 #include "mixer_scheduler.h"
+#include "mixer_stats.h"
 #include "heartbeat_driver.h"
 #include "hal/module_port.h"
 #include "tasks/mixer_task.h"
@@ -559,6 +560,7 @@ void pulsesSendNextFrame(uint8_t module)
     uint8_t nChannels = 16;  // TODO: MAX_CHANNELS - channelsStart
 
     auto buffer = _module_buffers[module]._buffer;
+    mixerStatsChannelsSent(module);
     drv->sendPulses(ctx, buffer, channels, nChannels);
   }
 }
@@ -566,7 +568,9 @@ void pulsesSendNextFrame(uint8_t module)
 void pulsesSendChannels()
 {
   for (uint8_t i = 0; i < MAX_MODULES; i++) {
-    pulsesSendNextFrame(i);
+    if (mixerSchedulerIsModuleDue(i)) {
+      pulsesSendNextFrame(i);
+    }
   }
 }
 
@@ -400,12 +400,12 @@ static void pxx1SendPulses(void* ctx, uint8_t* buffer, int16_t* channels, uint8_
   drv->sendBuffer(drv_ctx, buffer, frame_len);
 }
 
-static void pxx1ProcessData(void* ctx, uint8_t data, uint8_t* buffer, uint8_t* len)
+static void pxx1ProcessData(void* ctx, const uint8_t* data, uint8_t dlen, uint8_t* buffer, uint8_t* len)
 {
   auto mod_st = (etx_module_state_t*)ctx;
   auto module = modulePortGetModule(mod_st);
 
-  processFrskySportTelemetryData(module, data, buffer, *len);
+  processFrskySportTelemetryData(module, data, dlen, buffer, *len);
 }
 
 const etx_proto_driver_t Pxx1Driver = {
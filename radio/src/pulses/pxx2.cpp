@@ -29,6 +29,7 @@
 
 #include "pxx2.h"
 #include "pxx2_transport.h"
+#include "telemetry/telemetry_stats.h"
 
 static const etx_serial_init pxx2SerialInitParams = {
     .baudrate = PXX2_HIGHSPEED_BAUDRATE,
@@ -779,7 +780,7 @@ static void pxx2SendPulses(void* ctx, uint8_t* buffer, int16_t* channels, uint8_
   }
 }
 
-static void pxx2ProcessData(void* ctx, uint8_t data, uint8_t* buffer, uint8_t* len)
+static void pxx2ProcessByte(void* ctx, uint8_t data, uint8_t* buffer, uint8_t* len)
 {
   if (*len == 0 && data != START_STOP) {
     return;
@@ -795,6 +796,7 @@ static void pxx2ProcessData(void* ctx, uint8_t data, uint8_t* buffer, uint8_t* l
   }
   else {
     TRACE("[PXX2] array size %d error", *len);
+    telemetryStatsSizeError(modulePortGetModule((etx_module_state_t*)ctx));
     *len = 0;
   }
 
@@ -818,20 +820,30 @@ static void pxx2ProcessData(void* ctx, uint8_t data, uint8_t* buffer, uint8_t* l
   uint8_t crcHigh = frame[frame_len + 1];
   uint8_t crcLow = frame[frame_len + 2];
   
+  auto mod_st = (etx_module_state_t*)ctx;
+  auto module = modulePortGetModule(mod_st);
+  telemetryStatsFrame(module);
+
   if (crc != (crcHigh << 8 | crcLow)) {
     TRACE("[PXX2] crc error [%02x/%02x]", crc, crcHigh << 8 | crcLow);
+    telemetryStatsCrcError(module);
     *len = 0;
     return;
   }
 
-  auto mod_st = (etx_module_state_t*)ctx;
-  auto module = modulePortGetModule(mod_st);
   auto drv = modulePortGetSerialDrv(mod_st->rx);
   auto drv_ctx = modulePortGetCtx(mod_st->rx);
   processPXX2Frame(module, frame, drv, drv_ctx);
   *len = 0;
 }
 
+static void pxx2ProcessData(void* ctx, const uint8_t* data, uint8_t dlen, uint8_t* buffer, uint8_t* len)
+{
+  for (uint8_t i = 0; i < dlen; i++) {
+    pxx2ProcessByte(ctx, data[i], buffer, len);
+  }
+}
+
 #include "hal/module_driver.h"
 // #include "extmodule_serial_driver.h"
 
@@ -84,6 +84,7 @@ const char YAMLFILE_CHECKSUM_TAG_NAME[] = "checksum";
 
 #define MODELS_EXT          ".bin"
 #define LOGS_EXT            ".csv"
+#define LOGS_BINARY_EXT     ".etxl"
 #define SOUNDS_EXT          ".wav"
 #define BMP_EXT             ".bmp"
 #define PNG_EXT             ".png"
@@ -120,7 +121,17 @@ const char YAMLFILE_CHECKSUM_TAG_NAME[] = "checksum";
   filename[sizeof(path)+sizeof(var)] = '\0'; \
   strcat(&filename[sizeof(path)], ext)
 
-extern uint8_t logDelay100ms;
+enum LogsFormat {
+  LOGS_FORMAT_CSV,
+  LOGS_FORMAT_BINARY,
+  LOGS_FORMAT_CAPTURE,
+  LOGS_FORMAT_LAST = LOGS_FORMAT_CAPTURE
+};
+
+extern uint16_t logDelay10ms;
+extern uint8_t logsFormat;
+const char * logsFormatName(uint8_t format);
+uint8_t logsConvertPeriod(uint8_t period, uint8_t from, uint8_t to);
 void logsInit();
 void logsClose();
 void logsWrite();
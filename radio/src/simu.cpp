@@ -34,6 +34,7 @@
 #include <ctype.h>
 
 #include "targets/simu/simulcd.h"
+#include "targets/simu/simureplay.h"
 #include "hal/adc_driver.h"
 #include "hal/rotary_encoder.h"
 
@@ -605,7 +606,7 @@ void OpenTxSim::refreshDisplay()
   }
 }
 
-OpenTxSim * opentxSim;
+OpenTxSim * opentxSim = nullptr;
 
 void doFxEvents()
 {
@@ -616,6 +617,11 @@ void doFxEvents()
 
 int main(int argc, char ** argv)
 {
+  // Headless replay of a telemetry capture, without any window
+  if (argc >= 2 && !strcmp(argv[1], "--replay")) {
+    return simuReplayMain(argc - 2, argv + 2);
+  }
+
   // Each FOX GUI program needs one, and only one, application object.
   // The application objects coordinates some common stuff shared between
   // all the widgets; for example, it dispatches events, keeps track of
@@ -667,6 +673,10 @@ int main(int argc, char ** argv)
 
 uint16_t simu_get_analog(uint8_t idx)
 {
+  // headless replay: inputs at rest
+  if (!opentxSim)
+    return 2047;
+
   auto max_sticks = adcGetMaxInputs(ADC_INPUT_MAIN);
   if (idx < max_sticks)
     return opentxSim->sliders[idx]->getValue();
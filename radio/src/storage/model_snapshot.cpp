@@ -0,0 +1,255 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "opentx.h"
+#include "fw_version.h"
+#include "sdcard_common.h"
+#include "model_snapshot.h"
+#include "yaml/yaml_node.h"
+#include "yaml/yaml_datastructs.h"
+
+#define MODEL_SNAPSHOT_EXT          ".bin"
+#define MODEL_SNAPSHOT_DATA_OFFSET  512  // the model starts on a sector boundary
+
+PACK(struct ModelSnapshotHeader {
+  char     magic[4];
+  uint8_t  version;    // EEPROM_VER
+  uint8_t  spare;
+  uint16_t crc;        // model data
+  uint32_t layout;     // firmware and YAML nodes hash
+  uint32_t size;       // sizeof(ModelData)
+  uint32_t ymlSize;    // YAML file the model has been read from
+  uint16_t ymlDate;
+  uint16_t ymlTime;
+});
+
+static const char _snapshotMagic[4] = {'E', 'T', 'X', 'M'};
+static const char _snapshotOutdated[] = "outdated model snapshot";
+static const char _snapshotDisabled[] = "model snapshots disabled";
+
+#if defined(SIMU)
+#if defined(MODEL_SNAPSHOTS_DISABLED)
+bool modelSnapshotsEnabled = false;
+#else
+bool modelSnapshotsEnabled = true;
+#endif
+#define MODEL_SNAPSHOTS_ENABLED()   modelSnapshotsEnabled
+#else
+#define MODEL_SNAPSHOTS_ENABLED()   true
+#endif
+
+static char _pendingSnapshot[LEN_MODEL_FILENAME + 1];
+
+static uint32_t hashBytes(uint32_t hash, const void * data, uint32_t len)
+{
+  // FNV-1a
+  const uint8_t * p = (const uint8_t *)data;
+  while (len--) {
+    hash = (hash ^ *p++) * 16777619u;
+  }
+  return hash;
+}
+
+static uint32_t hashString(uint32_t hash, const char * str)
+{
+  return str ? hashBytes(hash, str, strlen(str) + 1) : hashBytes(hash, "", 1);
+}
+
+static uint32_t hashNodes(uint32_t hash, const YamlNode * node)
+{
+  for (; node->type != YDT_NONE; node++) {
+    uint32_t desc[3] = {node->type, node->size, node->elmts};
+    hash = hashBytes(hash, desc, sizeof(desc));
+    hash = hashString(hash, node->tag);
+
+    if (node->type == YDT_ARRAY || node->type == YDT_UNION) {
+      hash = hashNodes(hash, node->u._array.child);
+    }
+    else if (node->type == YDT_ENUM) {
+      // the values of the enums are stored, not their names
+      for (const YamlIdStr * choice = node->u._enum.choices; choice->str; choice++) {
+        hash = hashBytes(hash, &choice->id, sizeof(choice->id));
+        hash = hashString(hash, choice->str);
+      }
+    }
+  }
+  return hash;
+}
+
+// Any firmware change invalidates the snapshots, as the conversions
+// done when reading the YAML files may have changed
+static uint32_t getLayoutHash()
+{
+  static uint32_t layout = 0;
+  if (!layout) {
+    uint32_t hash = hashString(2166136261u, VERSION "-" GIT_STR);
+    hash = hashString(hash, DATE " " TIME);
+    layout = hashNodes(hash, get_modeldata_nodes()->u._array.child) | 1;
+  }
+  return layout;
+}
+
+static void getModelSnapshotPath(char * path, const char * filename)
+{
+  strcpy(path, MODEL_SNAPSHOTS_PATH PATH_SEPARATOR);
+  char * ext = strAppend(path + sizeof(MODEL_SNAPSHOTS_PATH), filename, LEN_MODEL_FILENAME);
+  char * dot = strrchr(path, '.');
+  strcpy(dot ? dot : ext, MODEL_SNAPSHOT_EXT);
+}
+
+static bool checkHeader(const ModelSnapshotHeader & header, const FILINFO & fno)
+{
+  return !memcmp(header.magic, _snapshotMagic, sizeof(_snapshotMagic)) &&
+         header.version == EEPROM_VER &&
+         header.layout == getLayoutHash() &&
+         header.size == sizeof(ModelData) &&
+         header.ymlSize == fno.fsize &&
+         header.ymlDate == fno.fdate &&
+         header.ymlTime == fno.ftime;
+}
+
+const char * readModelSnapshot(const char * filename, const char * ymlPath, ModelData * model)
+{
+  if (!MODEL_SNAPSHOTS_ENABLED()) {
+    return _snapshotDisabled;
+  }
+
+  FILINFO fno;
+  FRESULT result = f_stat(ymlPath, &fno);
+  if (result != FR_OK) {
+    return SDCARD_ERROR(result);
+  }
+
+  char path[sizeof(MODEL_SNAPSHOTS_PATH) + LEN_MODEL_FILENAME + sizeof(MODEL_SNAPSHOT_EXT)];
+  getModelSnapshotPath(path, filename);
+
+  FIL file;
+  result = f_open(&file, path, FA_OPEN_EXISTING | FA_READ);
+  if (result != FR_OK) {
+    return SDCARD_ERROR(result);
+  }
+
+  const char * error = _snapshotOutdated;
+  ModelSnapshotHeader header;
+  UINT read;
+  result = f_read(&file, &header, sizeof(header), &read);
+  if (result == FR_OK && read == sizeof(header) && checkHeader(header, fno)) {
+    // whole sectors: FatFS reads them straight into the model
+    result = f_lseek(&file, MODEL_SNAPSHOT_DATA_OFFSET);
+    if (result == FR_OK)
+      result = f_read(&file, model, sizeof(ModelData), &read);
+    if (result != FR_OK)
+      error = SDCARD_ERROR(result);
+    else if (read == sizeof(ModelData) &&
+             crc16(0, (const uint8_t *)model, sizeof(ModelData), 0xFFFF) == header.crc)
+      error = nullptr;
+  }
+
+  f_close(&file);
+  return error;
+}
+
+const char * writeModelSnapshot(const char * filename, const char * ymlPath, const ModelData * model)
+{
+  if (!MODEL_SNAPSHOTS_ENABLED()) {
+    return _snapshotDisabled;
+  }
+
+  FILINFO fno;
+  FRESULT result = f_stat(ymlPath, &fno);
+  if (result != FR_OK) {
+    return SDCARD_ERROR(result);
+  }
+
+  const char * error = sdCheckAndCreateDirectory(MODEL_SNAPSHOTS_PATH);
+  if (error) {
+    return error;
+  }
+
+  ModelSnapshotHeader header;
+  memclear(&header, sizeof(header));
+  memcpy(header.magic, _snapshotMagic, sizeof(_snapshotMagic));
+  header.version = EEPROM_VER;
+  header.crc = crc16(0, (const uint8_t *)model, sizeof(ModelData), 0xFFFF);
+  header.layout = getLayoutHash();
+  header.size = sizeof(ModelData);
+  header.ymlSize = fno.fsize;
+  header.ymlDate = fno.fdate;
+  header.ymlTime = fno.ftime;
+
+  char path[sizeof(MODEL_SNAPSHOTS_PATH) + LEN_MODEL_FILENAME + sizeof(MODEL_SNAPSHOT_EXT)];
+  getModelSnapshotPath(path, filename);
+
+  FIL file;
+  result = f_open(&file, path, FA_CREATE_ALWAYS | FA_WRITE);
+  if (result != FR_OK) {
+    return SDCARD_ERROR(result);
+  }
+
+  UINT written;
+  result = f_write(&file, &header, sizeof(header), &written);
+  if (result == FR_OK)
+    result = f_lseek(&file, MODEL_SNAPSHOT_DATA_OFFSET);
+  if (result == FR_OK)
+    result = f_write(&file, model, sizeof(ModelData), &written);
+  f_close(&file);
+
+  if (result != FR_OK) {
+    f_unlink(path);
+    return SDCARD_ERROR(result);
+  }
+
+  return nullptr;
+}
+
+void deleteModelSnapshot(const char * filename)
+{
+  if (!MODEL_SNAPSHOTS_ENABLED()) {
+    return;
+  }
+
+  char path[sizeof(MODEL_SNAPSHOTS_PATH) + LEN_MODEL_FILENAME + sizeof(MODEL_SNAPSHOT_EXT)];
+  getModelSnapshotPath(path, filename);
+  f_unlink(path);
+}
+
+void setPendingModelSnapshot(const char * filename)
+{
+  if (filename && MODEL_SNAPSHOTS_ENABLED())
+    strAppend(_pendingSnapshot, filename, LEN_MODEL_FILENAME);
+  else
+    _pendingSnapshot[0] = '\0';
+}
+
+void writePendingModelSnapshot()
+{
+  if (!_pendingSnapshot[0]) {
+    return;
+  }
+
+  char path[256];
+  getModelPath(path, _pendingSnapshot);
+  const char * error = writeModelSnapshot(_pendingSnapshot, path, &g_model);
+  if (error) {
+    TRACE("writeModelSnapshot error=%s", error);
+  }
+  _pendingSnapshot[0] = '\0';
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include "sdcard.h"
+
+struct ModelData;
+
+#define MODEL_SNAPSHOTS_PATH  MODELS_PATH PATH_SEPARATOR "CACHE"
+
+// Binary images of the models read from YAML: the image is used instead
+// of the YAML file as long as this file and the firmware are unchanged.
+// YAML stays the reference, the images are only a cache.
+const char * readModelSnapshot(const char * filename, const char * ymlPath, ModelData * model);
+const char * writeModelSnapshot(const char * filename, const char * ymlPath, const ModelData * model);
+void deleteModelSnapshot(const char * filename);
+
+// The snapshot of g_model is not written on the model switch path, but
+// by the next storageCheck() (EE_SNAPSHOT). A nullptr filename cancels it.
+void setPendingModelSnapshot(const char * filename);
+void writePendingModelSnapshot();
+
+#if defined(SIMU)
+// Only set by the gtests, unless the MODEL_SNAPSHOTS option is ON: the
+// simulator would write the snapshots to the user SD card directory
+extern bool modelSnapshotsEnabled;
+#endif
@@ -69,6 +69,26 @@ ModelCell::ModelCell(const char *fileName, uint8_t len) : valid_rfData(false)
   modelFilename[len] = '\0';
 }
 
+char *FILInfoToHexStr(char buffer[17], FILINFO *finfo);
+
+/**
+ * @brief Refreshes the file hash after the model file was written, so the
+ *        next load of labels.yml doesn't need to parse it again
+ *
+ * @return true Couldn't stat the model file
+ * @return false Success
+ */
+
+bool ModelCell::updateFileHash()
+{
+  char path[256];
+  FILINFO finfo;
+  getModelPath(path, modelFilename);
+  if (f_stat(path, &finfo) != FR_OK) return true;
+  FILInfoToHexStr(modelFinfoHash, &finfo);
+  return false;
+}
+
 void ModelCell::setModelName(char *name)
 {
   strncpy(modelName, name, LEN_MODEL_NAME);
@@ -816,6 +836,9 @@ bool ModelMap::updateModelFile(ModelCell *cell)
   fault = (writeFileYaml(path, get_modeldata_nodes(), (uint8_t *)modeldata, 0) !=
            NULL);
 
+  // Keep the labels.yml entry valid for the rewritten file
+  if (!fault && !cell->updateFileHash()) setDirty();
+
   free(modeldata);
 
 #if defined(DEBUG_TIMERS)
@@ -889,6 +912,22 @@ void ModelsList::clear()
   init();
 }
 
+/**
+ * @brief Finds a file discovered in the models folder by name
+ *
+ * @param name Model filename
+ * @return filedat* The file entry, nullptr if the file doesn't exist
+ */
+
+ModelsList::filedat *ModelsList::findFileHash(const char *name)
+{
+  auto it = std::lower_bound(
+      fileHashInfo.begin(), fileHashInfo.end(), name,
+      [](const filedat &a, const char *b) { return a.name.compare(b) < 0; });
+  if (it == fileHashInfo.end() || it->name != name) return nullptr;
+  return &(*it);
+}
+
 /**
  * @brief Load and parse the models.txt file
  *
@@ -1041,21 +1080,18 @@ bool ModelsList::loadYaml()
     f_closedir(&moddir);
   }
 
+  // Sorted, so labels.yml and models.yml entries can be looked up by name
+  std::sort(fileHashInfo.begin(), fileHashInfo.end(),
+            [](const filedat &a, const filedat &b) { return a.name < b.name; });
+
   // Check if models.yml exists
   // Any files found above that are not listed in the file will be moved into
   // /MDOELS/UNUSED and removed from the discovered file hash list
-  char line[LEN_MODELS_IDX_LINE + 1];
   FILINFO fno;
-  FRESULT result;
   bool foundInModels = f_stat(MODELSLIST_YAML_PATH, &fno) == FR_OK;
   bool foundInRadio = f_stat(FALLBACK_MODELSLIST_YAML_PATH, &fno) == FR_OK;
 
-  if(foundInModels) { // Default to /Models copy
-    result = f_open(&file, MODELSLIST_YAML_PATH, FA_OPEN_EXISTING | FA_READ);
-  } else if (foundInRadio) {
-    result = f_open(&file, FALLBACK_MODELSLIST_YAML_PATH, FA_OPEN_EXISTING | FA_READ);
-  }
-  if((foundInModels || foundInRadio) && result == FR_OK) {
+  if(foundInModels || foundInRadio) {
     // Create /Models/Unused if it doesn't exist
     bool moveRequired = false;
     DIR unusedFolder;
@@ -1064,34 +1100,21 @@ bool ModelsList::loadYaml()
       if (result == FR_NO_PATH) result = f_mkdir(UNUSED_MODELS_PATH);
       if (result != FR_OK) {
         TRACE("Unable to create unused models folder");
-        f_close(&file);
         return false;
       }
     } else f_closedir(&unusedFolder);
 
-    YamlParser ymp;
     std::vector<std::string> modfiles;
     void *ctx = get_modelslist_iter(&modfiles);
-    ymp.init(get_modelslist_parser_calls(), ctx);
-    UINT bytes_read = 0;
-    while (f_read(&file, line, sizeof(line), &bytes_read) == FR_OK) {
-      if (bytes_read == 0) break;
-      if (f_eof(&file)) ymp.set_eof();
-      if (ymp.parse(line, bytes_read) != YamlParser::CONTINUE_PARSING) break;
-    }
-    f_close(&file);
+    // Default to /Models copy
+    readYamlFile(foundInModels ? MODELSLIST_YAML_PATH : FALLBACK_MODELSLIST_YAML_PATH,
+                 get_modelslist_parser_calls(), ctx, nullptr);
 
     // Loop through file hases, move any files found that don't exists to /unused
+    std::sort(modfiles.begin(), modfiles.end());
     std::vector<filedat> newFileHash;
     for(const auto &fhas: fileHashInfo) {
-      bool found = false;
-      for(const auto &file : modfiles) {
-        if (file == fhas.name) {
-          TRACE_LABELS("Found file %s in models.yml.. OK!", file);
-          found = true;
-          break;
-        }
-      }
+      bool found = std::binary_search(modfiles.begin(), modfiles.end(), fhas.name);
       if(!found) {
         moveRequired = true;
         TRACE_LABELS("Model %s not in models.yml, moving to /UNUSED", fhas.name.c_str());
@@ -1127,19 +1150,8 @@ bool ModelsList::loadYaml()
 #endif
 
   // Scan labels.yml
-  result = f_open(&file, LABELSLIST_YAML_PATH, FA_OPEN_EXISTING | FA_READ);
-  if (result == FR_OK) {
-    YamlParser yp;
-    void *ctx = get_labelslist_iter();
-    yp.init(get_labelslist_parser_calls(), ctx);
-    UINT bytes_read = 0;
-    while (f_read(&file, line, sizeof(line), &bytes_read) == FR_OK) {
-      if (bytes_read == 0) break;
-      if (f_eof(&file)) yp.set_eof();
-      if (yp.parse(line, bytes_read) != YamlParser::CONTINUE_PARSING) break;
-    }
-    f_close(&file);
-  }
+  readYamlFile(LABELSLIST_YAML_PATH, get_labelslist_parser_calls(),
+               get_labelslist_iter(), nullptr);
 
 #if defined(DEBUG_TIMERS)
   DEBUG_TIMER_SAMPLE(debugTimerYamlScan);
@@ -1408,6 +1420,9 @@ ModelCell *ModelsList::addModel(const char *fileName, bool save, ModelCell *copy
   strncpy(result->modelFilename, fileName, LEN_MODEL_FILENAME);
   result->modelFilename[LEN_MODEL_FILENAME] = '\0';
 
+  // The file was written before the cell existed
+  if (result->modelFilename[0]) result->updateFileHash();
+
   // Add to the ModelsList
   push_back(result);
 
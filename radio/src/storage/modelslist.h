@@ -96,6 +96,7 @@ class ModelCell
   void setModelId(uint8_t moduleIdx, uint8_t id);
   void setRfModuleData(uint8_t moduleIdx, ModuleData *modData);
   bool fetchRfData();
+  bool updateFileHash();
 };
 
 typedef struct {
@@ -264,7 +265,9 @@ class ModelsList : public ModelsVector
     bool curmodel = false;
     bool celladded = false;
   } filedat;
-  std::vector<filedat> fileHashInfo;
+  std::vector<filedat> fileHashInfo;  // Sorted by name while loading
+
+  filedat *findFileHash(const char *name);
 
  protected:
   FIL file;
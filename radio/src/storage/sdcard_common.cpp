@@ -25,6 +25,10 @@
 #include "modelslist.h"
 #include "model_init.h"
 
+#if defined(MODEL_SNAPSHOTS)
+  #include "model_snapshot.h"
+#endif
+
 #if defined(COLORLCD)
   #include "theme.h"
 #endif
@@ -101,11 +105,27 @@ void storageCheck(bool immediately)
     const char * error = writeModel();
 #if defined(STORAGE_MODELSLIST)
     modelslist.updateCurrentModelCell();
+    // keep the labels.yml entry valid for the rewritten file
+    auto cell = modelslist.getCurrentModel();
+    if (!error && cell) cell->updateFileHash();
 #endif
     if (error) {
       TRACE("writeModel error=%s", error);
+#if defined(MODEL_SNAPSHOTS)
+      // g_model does not match the YAML file anymore
+      setPendingModelSnapshot(nullptr);
+#endif
     }
   }
+
+#if defined(MODEL_SNAPSHOTS)
+  // after the model write, so that the snapshot matches the YAML file
+  if (storageDirtyMsk & EE_SNAPSHOT) {
+    TRACE("SD card write model snapshot");
+    storageDirtyMsk &= ~EE_SNAPSHOT;
+    writePendingModelSnapshot();
+  }
+#endif
 }
 
 #if defined(STORAGE_MODELSLIST)
@@ -27,6 +27,10 @@
 #include "sdcard_yaml.h"
 #include "modelslist.h"
 
+#if defined(MODEL_SNAPSHOTS)
+  #include "model_snapshot.h"
+#endif
+
 #include "yaml/yaml_tree_walker.h"
 #include "yaml/yaml_parser.h"
 #include "yaml/yaml_datastructs.h"
@@ -38,6 +42,12 @@
  #include "storage/eeprom_rlc.h"
 #endif
 
+// Whole sectors are read at sector aligned file offsets: FatFS then
+// transfers them from the card straight into this buffer, instead of
+// copying them through its window buffer.
+#define YAML_READ_BUFFER_SIZE FF_MAX_SS
+static char yamlReadBuffer[YAML_READ_BUFFER_SIZE] __DMA;
+
 const char * readYamlFile(const char* fullpath, const YamlParserCalls* calls, void* parser_ctx, ChecksumResult* checksum_result)
 {
     FIL  file;
@@ -56,8 +66,8 @@ const char * readYamlFile(const char* fullpath, const YamlParserCalls* calls, vo
     uint16_t file_checksum = 0;
 
     bool first_block = true;
-    char buffer[32];
-    while (f_read(&file, buffer, sizeof(buffer)-1, &bytes_read) == FR_OK) {
+    char* buffer = yamlReadBuffer;
+    while (f_read(&file, buffer, YAML_READ_BUFFER_SIZE, &bytes_read) == FR_OK) {
       if (bytes_read == 0)  // EOF
         break;
       total_bytes += bytes_read;
@@ -69,18 +79,19 @@ const char * readYamlFile(const char* fullpath, const YamlParserCalls* calls, vo
         first_block = false;
         const char *skipValue = "checksum: ";
         if(strncmp(buffer, skipValue, strlen(skipValue)) == 0) {
-          skip = 10;
           char* startPos = buffer + strlen(skipValue);
           char* endPos = startPos;
+          char* bufferEnd = buffer + bytes_read;
           // Advance through the value
-          while((*endPos != '\r') && (*endPos != '\n')) {
-            if (endPos > buffer + bytes_read) {
-              return SDCARD_ERROR(	FR_INT_ERR );
-            }
+          while((endPos < bufferEnd) && (*endPos != '\r') && (*endPos != '\n')) {
             endPos++;
           }
+          if (endPos >= bufferEnd) {
+            f_close(&file);
+            return SDCARD_ERROR(FR_INT_ERR);
+          }
           // Skip trailing newline
-          while((*endPos == '\r') || (*endPos == '\n')) {
+          while((endPos < bufferEnd) && ((*endPos == '\r') || (*endPos == '\n'))) {
             *endPos = 0;
             endPos++;
           }
@@ -95,6 +106,7 @@ const char * readYamlFile(const char* fullpath, const YamlParserCalls* calls, vo
         calculated_checksum = crc16(0, (const uint8_t *)buffer + skip, bytes_read - skip, calculated_checksum);
       }
 
+      // the parser works on the read buffer directly
       if (f_eof(&file)) yp.set_eof();
       if (yp.parse(buffer + skip, bytes_read - skip) != YamlParser::CONTINUE_PARSING)
         break;
@@ -257,6 +269,14 @@ const char* writeFileYaml(const char* path, const YamlNode* root_node, uint8_t*
 {
     FIL file;
 
+#if defined(MODEL_SNAPSHOTS)
+    if (root_node == get_modeldata_nodes()) {
+        // re-created on the next load from YAML
+        const char* filename = strrchr(path, '/');
+        deleteModelSnapshot(filename ? filename + 1 : path);
+    }
+#endif
+
     FRESULT result = f_open(&file, path, FA_CREATE_ALWAYS | FA_WRITE);
     if (result != FR_OK) {
         return SDCARD_ERROR(result);
@@ -337,6 +357,20 @@ const char * readModelYaml(const char * filename, uint8_t * buffer, uint32_t siz
     char path[256];
     getModelPath(path, filename, pathName);
 
+#if defined(MODEL_SNAPSHOTS)
+    // only the models loaded as current model are snapshotted, not the
+    // ones read to be modified and written back (labels, ...)
+    bool snapshot = init_model && !strcmp(pathName, STR_MODELS_PATH);
+    if (snapshot && buffer == (uint8_t *)&g_model) {
+      // g_model is about to change
+      setPendingModelSnapshot(nullptr);
+    }
+    if (snapshot && !readModelSnapshot(filename, path, reinterpret_cast<ModelData*>(buffer))) {
+      TRACE("model snapshot read");
+      return nullptr;
+    }
+#endif
+
     YamlTreeWalker tree;
     tree.reset(data_nodes, buffer);
 
@@ -364,7 +398,15 @@ const char * readModelYaml(const char * filename, uint8_t * buffer, uint32_t siz
       md->rfAlarms.critical = 42;
     }
 
-    return readYamlFile(path, YamlTreeWalker::get_parser_calls(), &tree, NULL);
+    const char* error = readYamlFile(path, YamlTreeWalker::get_parser_calls(), &tree, NULL);
+#if defined(MODEL_SNAPSHOTS)
+    if (!error && snapshot && buffer == (uint8_t *)&g_model) {
+      // written later, once the model switch is done
+      setPendingModelSnapshot(filename);
+      storageDirty(EE_SNAPSHOT);
+    }
+#endif
+    return error;
 }
 
 static const char _wrongExtentionError[] = "wrong file extension";
@@ -456,6 +498,10 @@ bool copyModel(uint8_t dst, uint8_t src)
   GET_FILENAME(fname_src, MODELS_PATH, model_idx_src, YAML_EXT);
   GET_FILENAME(fname_dst, MODELS_PATH, model_idx_dst, YAML_EXT);
 
+#if defined(MODEL_SNAPSHOTS)
+  deleteModelSnapshot(model_idx_dst);
+#endif
+
   if (sdCopyFile(fname_src, fname_dst) == nullptr) {
     // update headers
     memcpy(&modelHeaders[dst], &modelHeaders[src], sizeof(ModelHeader));
@@ -484,6 +530,11 @@ void swapModels(uint8_t id1, uint8_t id2)
   GET_FILENAME(fname1_tmp, MODELS_PATH, model_idx_1, ".tmp");
   GET_FILENAME(fname2, MODELS_PATH, model_idx_2, YAML_EXT);
 
+#if defined(MODEL_SNAPSHOTS)
+  deleteModelSnapshot(model_idx_1);
+  deleteModelSnapshot(model_idx_2);
+#endif
+
   FILINFO fno;
   if (f_stat(fname2,&fno) != FR_OK) {
     if (f_stat(fname1,&fno) == FR_OK) {
@@ -525,6 +576,10 @@ int8_t deleteModel(uint8_t idx)
   getModelNumberStr(idx, model_idx);
   GET_FILENAME(fname, MODELS_PATH, model_idx, YAML_EXT);
 
+#if defined(MODEL_SNAPSHOTS)
+  deleteModelSnapshot(model_idx);
+#endif
+
   if (f_unlink(fname) != FR_OK) {
     return -1;
   }
@@ -594,6 +649,10 @@ const char * restoreModel(uint8_t idx, char *model_name)
   getModelNumberStr(idx, model_idx);
   strcat(model_idx, STR_YAML_EXT);
 
+#if defined(MODEL_SNAPSHOTS)
+  deleteModelSnapshot(model_idx);
+#endif
+
   const char* error = sdCopyFile(buf, STR_BACKUP_PATH, model_idx, STR_MODELS_PATH);
   if (!error) {
     loadModelHeader(idx, &modelHeaders[idx]);
@@ -55,6 +55,12 @@ void storageCheck(bool immediately);
 // Generic storage functions (implemented in storage_common.cpp)
 //
 void storageDirty(uint8_t msk);
+// Same as storageDirty(), for edits of the configuration (not of the
+// runtime state like trims, timers or GVAR values)
+void storageConfigDirty(uint8_t msk);
+// Drops what is computed from the model configuration: mixer plan,
+// curves, logical switches and sensors dependencies
+void modelConfigChanged();
 void storageFlushCurrentModel();
 void postRadioSettingsLoad();
 void preModelLoad();
@@ -23,6 +23,7 @@
 #include "timers_driver.h"
 #include "tasks/mixer_task.h"
 #include "mixes.h"
+#include "switches.h"
 
 #if defined(USBJ_EX)
 #include "usb_joystick.h"
@@ -54,6 +55,23 @@ void storageDirty(uint8_t msk)
 #endif
 }
 
+void storageConfigDirty(uint8_t msk)
+{
+  storageDirty(msk);
+
+  if (msk & EE_MODEL) {
+    modelConfigChanged();
+  }
+}
+
+void modelConfigChanged()
+{
+  invalidateMixerPlan();
+  invalidateCurvesCache();
+  invalidateTelemetrySensorsIndex();
+  logicalSwitchesInvalidate();
+}
+
 void preModelLoad()
 {
   watchdogSuspend(500/*5s*/);
@@ -222,6 +240,8 @@ if(g_model.rssiSource) {
   MultiRfProtocols::removeInstance(EXTERNAL_MODULE);
 #endif
 
+  invalidateTelemetrySensorsIndex();
+
   AUDIO_FLUSH();
   flightReset(false);
 
@@ -1481,10 +1481,21 @@ static void r_customFn(void* user, uint8_t* data, uint32_t bitoffs,
   case FUNC_SET_SCREEN:
 #endif  
   case FUNC_HAPTIC:
-  case FUNC_LOGS: // 10th of seconds
     CFN_PARAM(cfn) = yaml_str2uint(val, l_sep);
     break;
 
+  case FUNC_LOGS: // 10th of seconds (CSV) or 100th of seconds (binary)
+    CFN_PARAM(cfn) = yaml_str2uint(val, l_sep);
+    val += l_sep; val_len -= l_sep;
+    // optional ",bin" / ",raw" format suffix
+    if (val_len >= 4 && !strncmp(val, ",bin", 4)) {
+      CFN_LOGS_FORMAT(cfn) = LOGS_FORMAT_BINARY;
+    } else if (val_len >= 4 && !strncmp(val, ",raw", 4)) {
+      CFN_LOGS_FORMAT(cfn) = LOGS_FORMAT_CAPTURE;
+    }
+    eat_comma = false;
+    break;
+
   case FUNC_ADJUST_GVAR: {
 
     CFN_GVAR_INDEX(cfn) = yaml_str2int_ref(val, l_sep);
@@ -1664,11 +1675,20 @@ static bool w_customFn(void* user, uint8_t* data, uint32_t bitoffs,
   case FUNC_SET_SCREEN:
 #endif
   case FUNC_HAPTIC:
-  case FUNC_LOGS: // 10th of seconds
     str = yaml_unsigned2str(CFN_PARAM(cfn));
     if (!wf(opaque, str, strlen(str))) return false;
     break;
 
+  case FUNC_LOGS: // 10th of seconds (CSV) or 100th of seconds (binary)
+    str = yaml_unsigned2str(CFN_PARAM(cfn));
+    if (!wf(opaque, str, strlen(str))) return false;
+    if (CFN_LOGS_FORMAT(cfn) == LOGS_FORMAT_BINARY) {
+      if (!wf(opaque, ",bin", 4)) return false;
+    } else if (CFN_LOGS_FORMAT(cfn) == LOGS_FORMAT_CAPTURE) {
+      if (!wf(opaque, ",raw", 4)) return false;
+    }
+    break;
+
   case FUNC_ADJUST_GVAR:
     str = yaml_unsigned2str(CFN_GVAR_INDEX(cfn)); // GVAR index
     if (!wf(opaque, str, strlen(str))) return false;
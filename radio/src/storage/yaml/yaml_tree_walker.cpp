@@ -249,30 +249,75 @@ void YamlTreeWalker::rewind()
     }
 }
 
-// Increment the cursor until a match is found or the end of
-// the current collection (node of type YDT_NONE) is reached.
+static inline bool tag_matches(const YamlNode* attr, const char* tag,
+                               uint8_t tag_len)
+{
+    if (!attr->tag)
+        return tag_len == 0;
+
+    return !strncmp(tag, attr->tag, tag_len) && attr->tag[tag_len] == '\0';
+}
+
+// Move the cursor to the attribute matching the tag.
 //
-// return true if a match has been found.
+// Attributes are mostly read in the order they have been written,
+// so the search starts at the current attribute and wraps around to
+// the first one: reading a whole collection is then linear instead of
+// quadratic in the number of attributes.
+//
+// return true if a match has been found, otherwise the cursor is left
+// at the end of the current collection (node of type YDT_NONE).
 bool YamlTreeWalker::findNode(const char* tag, uint8_t tag_len)
 {
     if (virt_level)
         return false;
 
-    rewind();
+    if (isArrayElmt()) {
+        rewind();
 
-    const struct YamlNode* attr = getAttr();
-    if (isArrayElmt() && attr && attr->type == YDT_IDX) {
-        setAttrValue((char*)tag, tag_len);
-        return true;
+        const struct YamlNode* attr = getAttr();
+        if (attr && attr->type == YDT_IDX) {
+            setAttrValue((char*)tag, tag_len);
+            return true;
+        }
     }
 
-    while(attr && attr->type != YDT_NONE) {
+    const struct YamlNode* attr = getAttr();
+    if (!attr)
+        return false;
+
+    uint8_t start_level = stack_level;
+    int8_t  start_idx = stack[stack_level].attr_idx;
+    bool    wrapped = false;
+
+    while(true) {
 
-        if ((tag_len == attr->tag_len())
-            && !strncmp(tag, attr->tag, tag_len)) {
-            return true; // attribute found!
+        if (attr->type == YDT_NONE) {
+            if (wrapped)
+                return false;
+
+            // continue from the first attribute
+            rewind();
+            wrapped = true;
+        }
+        else {
+            if (wrapped && stack_level == start_level
+                && stack[stack_level].attr_idx == start_idx) {
+                break; // back to where the search started
+            }
+
+            if (tag_matches(attr, tag, tag_len)) {
+                return true; // attribute found!
+            }
+
+            toNextAttr();
         }
 
+        attr = getAttr();
+    }
+
+    // not found: move to the end of the collection
+    while(attr->type != YDT_NONE) {
         toNextAttr();
         attr = getAttr();
     }
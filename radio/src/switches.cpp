@@ -638,12 +638,188 @@ uint8_t getXPotPosition(uint8_t idx)
 }
 
 
+/*
+  Logical switches change tracking
+
+  A logical switch only reading physical switches, telemetry values
+  or other logical switches (without delay / duration) is a pure
+  function of these inputs, and is re-evaluated only when one of them
+  changed. Everything else (sticks, channels, timers, edge / sticky /
+  diff functions, ...) is evaluated on each call.
+
+  The dependencies are computed from the model on the first call after
+  logicalSwitchesInvalidate(), which is called on model edits (see
+  modelConfigChanged()) and logicalSwitchesReset().
+*/
+
+enum LogicalSwitchDeps {
+  LS_DEP_SWITCHES = 0x01,   // physical, multipos and function switches, flight modes
+  LS_DEP_TELEMETRY = 0x02,  // telemetry value in v1, telemetry streaming
+  LS_DEP_LOGICAL = 0x04,    // other logical switches
+  LS_DEP_ALWAYS = 0x80,
+};
+
+static_assert(MAX_LOGICAL_SWITCHES <= 64, "logical switches masks are 64 bits");
+
+static uint8_t lswDeps[MAX_LOGICAL_SWITCHES];
+static getvalue_t lswTelemetryInput[MAX_LOGICAL_SWITCHES];
+static bool lswDepsValid = false;
+
+// inputs state at the previous evaluation
+static uint8_t lswLastFlightMode = 255;
+static uint8_t lswSwitchesState[MAX_SWITCHES];
+static uint8_t lswPotsPos[MAX_POTS];
+#if defined(FUNCTION_SWITCHES)
+static uint8_t lswFSState = 0;
+#endif
+static bool lswTelemetryStreaming = false;
+static uint64_t lswLastChanged = 0;
+
+void logicalSwitchesInvalidate()
+{
+  lswDepsValid = false;
+}
+
+static uint8_t getSwitchDeps(swsrc_t swtch)
+{
+  uint16_t idx = abs(swtch);
+
+  if (idx == SWSRC_NONE || idx == SWSRC_ON)
+    return 0;
+  else if (idx <= SWSRC_LAST_MULTIPOS_SWITCH)
+    return LS_DEP_SWITCHES;
+  else if (idx >= SWSRC_FIRST_LOGICAL_SWITCH && idx <= SWSRC_LAST_LOGICAL_SWITCH)
+    return LS_DEP_LOGICAL;
+  else if (idx >= SWSRC_FIRST_FLIGHT_MODE && idx <= SWSRC_LAST_FLIGHT_MODE)
+    return LS_DEP_SWITCHES;
+  else
+    return LS_DEP_ALWAYS;
+}
+
+static uint8_t getLogicalSwitchDeps(LogicalSwitchData * ls)
+{
+  if (ls->func == LS_FUNC_NONE)
+    return 0;
+
+  if (ls->delay || ls->duration)
+    return LS_DEP_ALWAYS;
+
+  uint8_t deps = getSwitchDeps(ls->andsw);
+
+  switch (lswFamily(ls->func)) {
+    case LS_FAMILY_BOOL:
+      deps |= getSwitchDeps(ls->v1) | getSwitchDeps(ls->v2);
+      break;
+
+    case LS_FAMILY_OFS:
+      if (ls->v1 >= MIXSRC_FIRST_TELEM && ls->v1 <= MIXSRC_LAST_TELEM)
+        deps |= LS_DEP_TELEMETRY;
+      else
+        deps |= LS_DEP_ALWAYS;
+      break;
+
+    default:
+      deps |= LS_DEP_ALWAYS;
+      break;
+  }
+
+  return deps;
+}
+
+static uint64_t getLogicalSwitchSourcesMask(LogicalSwitchData * ls)
+{
+  uint64_t mask = 0;
+  swsrc_t sources[] = { ls->andsw, (swsrc_t)ls->v1, (swsrc_t)ls->v2 };
+  for (auto swtch : sources) {
+    uint16_t idx = abs(swtch);
+    if (idx >= SWSRC_FIRST_LOGICAL_SWITCH && idx <= SWSRC_LAST_LOGICAL_SWITCH) {
+      mask |= (uint64_t)1 << (idx - SWSRC_FIRST_LOGICAL_SWITCH);
+    }
+  }
+  return mask;
+}
+
+static bool updateSwitchesState()
+{
+  bool changed = false;
+
+  for (uint8_t i = 0; i < switchGetMaxSwitches(); i++) {
+    uint8_t state = 0;
+    for (uint8_t pos = 0; pos < 3; pos++) {
+      if (switchState(i * 3 + pos))
+        state |= 1 << pos;
+    }
+    if (state != lswSwitchesState[i]) {
+      lswSwitchesState[i] = state;
+      changed = true;
+    }
+  }
+
+  if (memcmp(lswPotsPos, potsPos, sizeof(lswPotsPos))) {
+    memcpy(lswPotsPos, potsPos, sizeof(lswPotsPos));
+    changed = true;
+  }
+
+#if defined(FUNCTION_SWITCHES)
+  uint8_t fsState = getFSLogicalState();
+  if (fsState != lswFSState) {
+    lswFSState = fsState;
+    changed = true;
+  }
+#endif
+
+  return changed;
+}
+
 /**
   @brief Calculates new state of logical switches for mixerCurrentFlightMode
 */
 void evalLogicalSwitches(bool isCurrentFlightmode)
 {
+  bool full = !lswDepsValid || lswLastFlightMode != mixerCurrentFlightMode;
+  if (!lswDepsValid) {
+    lswDepsValid = true;
+    for (uint8_t idx = 0; idx < MAX_LOGICAL_SWITCHES; idx++) {
+      lswDeps[idx] = getLogicalSwitchDeps(lswAddress(idx));
+    }
+  }
+  lswLastFlightMode = mixerCurrentFlightMode;
+
+  bool switchesChanged = updateSwitchesState();
+
+  bool telemetryStreaming = TELEMETRY_STREAMING();
+  bool streamingChanged = (telemetryStreaming != lswTelemetryStreaming);
+  lswTelemetryStreaming = telemetryStreaming;
+
+  // logical switches changed since they were read by the lower ones
+  uint64_t changed = lswLastChanged;
+  uint64_t changedNow = 0;
+
   for (unsigned int idx=0; idx<MAX_LOGICAL_SWITCHES; idx++) {
+    LogicalSwitchData * ls = lswAddress(idx);
+    uint8_t deps = lswDeps[idx];
+    bool dirty = full || (deps & LS_DEP_ALWAYS);
+
+    if (deps & LS_DEP_TELEMETRY) {
+      getvalue_t input = getValue(ls->v1);
+      if (streamingChanged || input != lswTelemetryInput[idx]) {
+        lswTelemetryInput[idx] = input;
+        dirty = true;
+      }
+    }
+
+    if ((deps & LS_DEP_SWITCHES) && switchesChanged) {
+      dirty = true;
+    }
+
+    if ((deps & LS_DEP_LOGICAL) && (getLogicalSwitchSourcesMask(ls) & changed)) {
+      dirty = true;
+    }
+
+    if (!dirty) {
+      continue;
+    }
+
     LogicalSwitchContext & context = lswFm[mixerCurrentFlightMode].lsw[idx];
     bool result = getLogicalSwitch(idx);
     if (isCurrentFlightmode) {
@@ -654,8 +830,15 @@ void evalLogicalSwitches(bool isCurrentFlightmode)
         if (context.state) PLAY_LOGICAL_SWITCH_OFF(idx);
       }
     }
+    if (context.state != result) {
+      uint64_t mask = (uint64_t)1 << idx;
+      changed |= mask;
+      changedNow |= mask;
+    }
     context.state = result;
   }
+
+  lswLastChanged = changedNow;
 }
 
 static inline uint8_t _bits_set(uint8_t val, uint8_t bits)
@@ -1039,6 +1222,7 @@ int16_t lswTimerValue(delayval_t val)
 void logicalSwitchesReset()
 {
   memset(lswFm, 0, sizeof(lswFm));
+  logicalSwitchesInvalidate();
 
   for (uint8_t fm=0; fm<MAX_FLIGHT_MODES; fm++) {
     for (uint8_t i=0; i<MAX_LOGICAL_SWITCHES; i++) {
@@ -44,6 +44,7 @@ int16_t lswTimerValue(delayval_t val);
 void evalLogicalSwitches(bool isCurrentFlightmode=true);
 void logicalSwitchesCopyState(uint8_t src, uint8_t dst);
 void logicalSwitchesReset();
+void logicalSwitchesInvalidate();
 void logicalSwitchesTimerTick();
 
 bool isSwitchWarningRequired(uint16_t &bad_pots);
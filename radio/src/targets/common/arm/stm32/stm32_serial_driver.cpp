@@ -21,6 +21,7 @@
 
 #include "stm32_serial_driver.h"
 #include <string.h>
+#include "hal/serial_frames.h"
 
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
 
@@ -35,14 +36,24 @@ struct stm32_send_buffer {
   volatile uint32_t len;
 };
 
+// RX frames delimited by the IDLE IRQ
+#define STM32_RX_FRAMES 8
+
+typedef SerialFrameRing<STM32_RX_FRAMES> stm32_frame_ring;
+
 struct stm32_serial_state {
   const stm32_serial_port* sp;
   stm32_buffer_state rx_buf;
+  stm32_frame_ring rx_frames;
   union {
     stm32_buffer_state tx_fifo;
     stm32_send_buffer  tx_buf;
   } u;
   etx_serial_callbacks_t callbacks;
+
+  // user IDLE callback, called after the frame has been recorded
+  void (*on_idle)(void*);
+  void* on_idle_ctx;
 };
 
 enum _STM32_USART {
@@ -214,18 +225,47 @@ static inline void _fifo_push(uint8_t c, stm32_buffer_state* buf_st,
   buf_st->widx = (buf_st->widx + 1) & (length - 1);
 }
 
+// RX write index, either from DMA or from the IRQ FIFO
+static inline uint32_t _rx_widx(const stm32_serial_state* st)
+{
+  auto sp = st->sp;
+  auto usart = sp->usart;
+  if (LL_USART_IsEnabledDMAReq_RX(usart->USARTx)) {
+    auto dma = usart->rxDMA;
+    auto stream = usart->rxDMA_Stream;
+    return sp->rx_buffer.length - LL_DMA_GetDataLength(dma, stream);
+  }
+  return st->rx_buf.widx;
+}
+
+static void _on_rx_idle(void* ctx)
+{
+  auto st = (stm32_serial_state*)ctx;
+  st->rx_frames.push(_rx_widx(st));
+  if (st->on_idle) st->on_idle(st->on_idle_ctx);
+}
+
 static void _on_rx_fifo(uint8_t data)
 {
   auto st = _isr_state;
   stm32_buffer_state* buf_st = (stm32_buffer_state*)&st->rx_buf;
 
   auto buf_len = st->sp->rx_buffer.length;
-  if (_fifo_full(buf_st, buf_len)) return;
+  if (_fifo_full(buf_st, buf_len)) {
+    st->rx_frames.overrun();
+    return;
+  }
 
   auto buf = st->sp->rx_buffer.buffer;
   _fifo_push(data, buf_st, buf_len, buf);
 }
 
+static void _on_rx_error()
+{
+  auto st = _isr_state;
+  st->rx_frames.overrun();
+}
+
 static void* stm32_serial_init(void* hw_def, const etx_serial_init* params)
 {
   auto sp = (const stm32_serial_port*)hw_def;
@@ -249,6 +289,7 @@ static void* stm32_serial_init(void* hw_def, const etx_serial_init* params)
 
     auto rx_buf = sp->rx_buffer.buffer;
     auto buf_len = sp->rx_buffer.length;
+    st->callbacks.on_error = _on_rx_error;
 
     if (usart->rxDMA) {
       stm32_usart_init_rx_dma(usart, rx_buf, buf_len);
@@ -367,15 +408,7 @@ static int stm32_serial_get_byte(void* ctx, uint8_t* data)
   auto buf = rx_buf.buffer;
   auto& buf_st = st->rx_buf;
 
-  uint32_t widx;
-  auto usart = sp->usart;
-  if (LL_USART_IsEnabledDMAReq_RX(usart->USARTx)) {
-    auto dma = usart->rxDMA;
-    auto stream = usart->rxDMA_Stream;
-    widx = buf_len - LL_DMA_GetDataLength(dma, stream);
-  } else {
-    widx = buf_st.widx;
-  }
+  uint32_t widx = _rx_widx(st);
 
   if (buf_st.ridx == widx)
     return 0;
@@ -399,15 +432,7 @@ static int stm32_serial_get_last_byte(void* ctx, uint32_t idx, uint8_t* data)
   auto buf = rx_buf.buffer;
   auto& buf_st = st->rx_buf;
 
-  uint32_t widx;
-  auto usart = sp->usart;
-  if (LL_USART_IsEnabledDMAReq_RX(usart->USARTx)) {
-    auto dma = usart->rxDMA;
-    auto stream = usart->rxDMA_Stream;
-    widx = buf_len - LL_DMA_GetDataLength(dma, stream);
-  } else {
-    widx = buf_st.widx;
-  }
+  uint32_t widx = _rx_widx(st);
 
   // Please note that we do not check the read cursor
   // so that this function might return data that
@@ -428,18 +453,9 @@ static int stm32_serial_get_buffered_bytes(void* ctx)
   auto buf_len = rx_buf.length;
   if (!buf_len) return -1;
 
-  uint32_t widx;
-  auto usart = sp->usart;
+  uint32_t widx = _rx_widx(st);
   const auto& buf_st = st->rx_buf;
 
-  if (LL_USART_IsEnabledDMAReq_RX(usart->USARTx)) {
-    auto dma = usart->rxDMA;
-    auto stream = usart->rxDMA_Stream;
-    widx = buf_len - LL_DMA_GetDataLength(dma, stream);
-  } else {
-    widx = buf_st.widx;
-  }
-
   return (widx - buf_st.ridx) & (buf_len - 1);
 }
 
@@ -461,18 +477,9 @@ static int stm32_serial_copy_rx_buffer(void* ctx, uint8_t* buf, uint32_t len)
   auto buf_len = rx_buf.length;
   if (!buf_len) return -1;
 
-  uint32_t widx;
-  auto usart = sp->usart;
+  uint32_t widx = _rx_widx(st);
   auto& buf_st = st->rx_buf;
 
-  if (LL_USART_IsEnabledDMAReq_RX(usart->USARTx)) {
-    auto dma = usart->rxDMA;
-    auto stream = usart->rxDMA_Stream;
-    widx = buf_len - LL_DMA_GetDataLength(dma, stream);
-  } else {
-    widx = buf_st.widx;
-  }
-
   if (buf_st.ridx == widx) return 0;
 
   int res = 0;
@@ -494,11 +501,33 @@ static int stm32_serial_copy_rx_buffer(void* ctx, uint8_t* buf, uint32_t len)
   return res;
 }
 
+static int stm32_serial_copy_rx_frame(void* ctx, uint8_t* buf, uint32_t len)
+{
+  auto st = (stm32_serial_state*)ctx;
+  if (!st || !st->on_idle) return -1;
+
+  const auto& rx_buf = st->sp->rx_buffer;
+  auto buf_len = rx_buf.length;
+  if (!buf_len) return -1;
+
+  return st->rx_frames.copyFrame(rx_buf.buffer, buf_len, st->rx_buf.ridx,
+                                 buf, len);
+}
+
+static uint32_t stm32_serial_get_rx_overruns(void* ctx)
+{
+  auto st = (stm32_serial_state*)ctx;
+  if (!st) return 0;
+  return st->rx_frames.takeOverruns();
+}
+
 static void stm32_serial_clear_rx_buffer(void* ctx)
 {
   auto st = (stm32_serial_state*)ctx;
   if (!st) return;
 
+  st->rx_frames.clear();
+
   auto sp = st->sp;
   auto buf_st = &st->rx_buf;
   auto usart = sp->usart;
@@ -547,8 +576,14 @@ static void stm32_serial_set_idle_cb(void* ctx, void (*on_idle)(void*), void* pa
   auto st = (stm32_serial_state*)ctx;
   if (!st) return;
 
-  st->callbacks.on_idle = on_idle;
-  st->callbacks.on_idle_ctx = param;
+  st->on_idle = on_idle;
+  st->on_idle_ctx = param;
+
+  st->rx_frames.clear();
+
+  // record frames boundaries before calling back
+  st->callbacks.on_idle = on_idle ? _on_rx_idle : nullptr;
+  st->callbacks.on_idle_ctx = st;
 
   uint32_t enabled = (on_idle != nullptr);
   stm32_usart_set_idle_irq(st->sp->usart, enabled);
@@ -566,6 +601,8 @@ const etx_serial_driver_t STM32SerialDriver = {
   .getLastByte = stm32_serial_get_last_byte,
   .getBufferedBytes = stm32_serial_get_buffered_bytes,
   .copyRxBuffer = stm32_serial_copy_rx_buffer,
+  .copyRxFrame = stm32_serial_copy_rx_frame,
+  .getRxOverruns = stm32_serial_get_rx_overruns,
   .clearRxBuffer = stm32_serial_clear_rx_buffer,
   .getBaudrate = stm32_serial_get_baudrate,
   .setBaudrate = stm32_serial_set_baudrate,
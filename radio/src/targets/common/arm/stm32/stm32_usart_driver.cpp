@@ -549,6 +549,7 @@ void stm32_usart_isr(const stm32_usart_t* usart, etx_serial_callbacks_t* cb)
   // cache these first, as RXNE might clear SR
   uint32_t idle = (status & LL_USART_SR_IDLE);
   uint32_t txe = (status & LL_USART_SR_TXE);
+  uint32_t ore = (status & LL_USART_SR_ORE);
 
   // TC is only enabled with 2-wire half-duplex when TX DMA was in use
   if (LL_USART_IsEnabledIT_TC(usart->USARTx) && (status & LL_USART_SR_TC)) {
@@ -575,7 +576,8 @@ void stm32_usart_isr(const stm32_usart_t* usart, etx_serial_callbacks_t* cb)
       // This will clear the RXNE/error bits in USART_SR register
       uint8_t data = LL_USART_ReadReg(usart->USARTx, DR);
 
-      if (status & USART_FLAG_ERRORS) {
+      // RX overrun: at least one byte was lost
+      if (status & LL_USART_SR_ORE) {
         if (cb->on_error)
           cb->on_error();
       }
@@ -601,7 +603,11 @@ void stm32_usart_isr(const stm32_usart_t* usart, etx_serial_callbacks_t* cb)
   }
 
   if (LL_USART_IsEnabledIT_IDLE(usart->USARTx) && idle) {
-    // SR clear sequence
+    // with RX DMA, overruns are only seen here
+    if (ore && !LL_USART_IsEnabledIT_RXNE(usart->USARTx) && cb->on_error)
+      cb->on_error();
+
+    // SR clear sequence (clears ORE as well)
     status = LL_USART_ReadReg(usart->USARTx, DR);
     if (cb->on_idle) cb->on_idle(cb->on_idle_ctx);
   }
@@ -104,6 +104,8 @@ const etx_serial_driver_t _fakeSerialDriver = {
     .getLastByte = nullptr,
     .getBufferedBytes = nullptr,
     .copyRxBuffer = nullptr,
+    .copyRxFrame = nullptr,
+    .getRxOverruns = nullptr,
     .clearRxBuffer = nullptr,
     .getBaudrate = nullptr,
     .setBaudrate = nullptr,
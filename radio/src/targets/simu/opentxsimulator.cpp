@@ -22,6 +22,7 @@
 #include "opentxsimulator.h"
 #include "opentx.h"
 #include "simulcd.h"
+#include "simureplay.h"
 #include "switches.h"
 
 #include "hal/adc_driver.h"
@@ -422,6 +423,26 @@ void OpenTxSimulator::sendTelemetry(const QByteArray data)
                               data.count());
 }
 
+bool OpenTxSimulator::replayCapture(const QString & captureFile, const QString & traceFile, unsigned speed)
+{
+  // the replay runs the mixer and the telemetry itself
+  stop();
+  ETXS_DBG << "capture:" << captureFile << "trace:" << traceFile << "speed:" << speed;
+
+  QMutexLocker lckr(&m_mtxSimuMain);
+  FILE * trace = nullptr;
+  if (!traceFile.isEmpty()) {
+    trace = fopen(traceFile.toLocal8Bit().constData(), "w");
+    if (!trace)
+      return false;
+  }
+
+  bool result = simuReplayCapture(captureFile.toLocal8Bit().constData(), speed, trace, nullptr);
+  if (trace)
+    fclose(trace);
+  return result;
+}
+
 uint8_t OpenTxSimulator::getSensorInstance(uint16_t id, uint8_t defaultValue)
 {
   for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
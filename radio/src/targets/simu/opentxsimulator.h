@@ -79,6 +79,7 @@ class DLLEXPORT OpenTxSimulator : public SimulatorInterface
     virtual void lcdFlushed();
     virtual void setTrainerTimeout(uint16_t ms);
     virtual void sendTelemetry(const QByteArray data);
+    virtual bool replayCapture(const QString & captureFile, const QString & traceFile = "", unsigned speed = 0);
     virtual void setLuaStateReloadPermanentScripts();
     virtual void addTracebackDevice(QIODevice * device);
     virtual void removeTracebackDevice(QIODevice * device);
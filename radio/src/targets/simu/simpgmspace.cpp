@@ -66,8 +66,20 @@ extern const etx_hal_adc_driver_t simu_adc_driver;
 
 void lcdCopy(void * dest, void * src);
 
+static volatile bool simuVirtualTimer = false;
+static volatile uint64_t simuVirtualMicros = 0;
+
+void simuSetVirtualTimer(bool enabled, uint64_t micros)
+{
+  simuVirtualMicros = micros;
+  simuVirtualTimer = enabled;
+}
+
 uint64_t simuTimerMicros(void)
 {
+  if (simuVirtualTimer)
+    return simuVirtualMicros;
+
 #if SIMPGMSPC_USE_QT
   static QElapsedTimer ticker;
   if (!ticker.isValid())
@@ -615,6 +627,8 @@ static const etx_serial_driver_t _fake_drv = {
   .getLastByte = nullptr,
   .getBufferedBytes = nullptr,
   .copyRxBuffer = nullptr,
+  .copyRxFrame = nullptr,
+  .getRxOverruns = nullptr,
   .clearRxBuffer = nullptr,
   .getBaudrate = nullptr,
   .setBaudrate = nullptr,
@@ -46,6 +46,8 @@ extern char * main_thread_error;
 
 
 uint64_t simuTimerMicros(void);
+// Replaces the wall clock by a clock driven by the caller (replay)
+void simuSetVirtualTimer(bool enabled, uint64_t micros);
 uint8_t simuSleep(uint32_t ms);  // returns true if thread shutdown requested
 
 void simuSetKey(uint8_t key, bool state);
@@ -0,0 +1,394 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include <chrono>
+#include <thread>
+
+#include "opentx.h"
+#include "switches.h"
+#include "logs_capture.h"
+#include "simureplay.h"
+
+#define REPLAY_VALUE_LEN  32
+
+struct ReplayTrace {
+  FILE * out;
+  char values[MAX_TELEMETRY_SENSORS][REPLAY_VALUE_LEN];  // as last traced
+  bool available[MAX_TELEMETRY_SENSORS];
+  bool old[MAX_TELEMETRY_SENSORS];
+  bool switches[MAX_LOGICAL_SWITCHES];
+  uint8_t telemetryState;
+  uint8_t rssiLevel;
+};
+
+static const char * const rssiLevels[] = { "ok", "low", "critical" };
+
+static void traceEvent(ReplayTrace & trace, uint32_t time, const char * event,
+                       const char * name, const char * value)
+{
+  if (trace.out)
+    fprintf(trace.out, "%u,%s,%s,%s\n", time, event, name, value);
+}
+
+static void formatSensorValue(char * s, uint8_t index)
+{
+  const TelemetrySensor & sensor = g_model.telemetrySensors[index];
+  TelemetryItem & item = telemetryItems[index];
+
+  if (sensor.unit == UNIT_GPS) {
+    snprintf(s, REPLAY_VALUE_LEN, "%.6f %.6f", item.gps.latitude / 1000000.0,
+             item.gps.longitude / 1000000.0);
+  }
+  else if (sensor.unit == UNIT_TEXT) {
+    snprintf(s, REPLAY_VALUE_LEN, "%.*s", TELEMETRY_SENSOR_TEXT_LENGTH, item.text);
+    // keep the trace parsable
+    for (char * c = s; *c; c++) {
+      if (*c == ',' || *c == '\n')
+        *c = ' ';
+    }
+  }
+  else if (sensor.prec > 0) {
+    uint32_t div = (sensor.prec == 1 ? 10 : 100);
+    uint32_t value = abs(item.value);
+    snprintf(s, REPLAY_VALUE_LEN, "%s%u.%0*u", item.value < 0 ? "-" : "",
+             value / div, sensor.prec, value % div);
+  }
+  else {
+    snprintf(s, REPLAY_VALUE_LEN, "%d", item.value);
+  }
+}
+
+static void traceSensors(ReplayTrace & trace, uint32_t time)
+{
+  char name[TELEM_LABEL_LEN + 1];
+  char value[REPLAY_VALUE_LEN];
+
+  for (uint8_t i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+    TelemetryItem & item = telemetryItems[i];
+    if (!isTelemetryFieldAvailable(i) || !item.isAvailable() ||
+        g_model.telemetrySensors[i].unit == UNIT_DATETIME) {
+      trace.available[i] = false;
+      continue;
+    }
+
+    snprintf(name, sizeof(name), "%.*s", TELEM_LABEL_LEN,
+             g_model.telemetrySensors[i].label);
+
+    formatSensorValue(value, i);
+    if (!trace.available[i] || strcmp(value, trace.values[i])) {
+      traceEvent(trace, time, "sensor", name, value);
+      strcpy(trace.values[i], value);
+      trace.available[i] = true;
+    }
+
+    if (item.isOld() && !trace.old[i]) {
+      traceEvent(trace, time, "alarm", "sensor_lost", name);
+    }
+    trace.old[i] = item.isOld();
+  }
+}
+
+static void traceSwitches(ReplayTrace & trace, uint32_t time)
+{
+  char name[8];
+
+  for (uint8_t i = 0; i < MAX_LOGICAL_SWITCHES; i++) {
+    if (g_model.logicalSw[i].func == LS_FUNC_NONE)
+      continue;
+    bool state = getSwitch(SWSRC_FIRST_LOGICAL_SWITCH + i);
+    if (state != trace.switches[i]) {
+      snprintf(name, sizeof(name), "L%d", i + 1);
+      traceEvent(trace, time, "switch", name, state ? "1" : "0");
+      trace.switches[i] = state;
+    }
+  }
+}
+
+static void traceAlarms(ReplayTrace & trace, uint32_t time)
+{
+  if (telemetryState != trace.telemetryState) {
+    if (telemetryState == TELEMETRY_OK)
+      traceEvent(trace, time, "alarm", "telemetry",
+                 trace.telemetryState == TELEMETRY_INIT ? "connected" : "back");
+    else if (telemetryState == TELEMETRY_KO)
+      traceEvent(trace, time, "alarm", "telemetry", "lost");
+    trace.telemetryState = telemetryState;
+  }
+
+  uint8_t level = 0;
+  if (TELEMETRY_STREAMING() && !g_model.disableTelemetryWarning) {
+    if (TELEMETRY_RSSI() < g_model.rfAlarms.critical)
+      level = 2;
+    else if (TELEMETRY_RSSI() < g_model.rfAlarms.warning)
+      level = 1;
+  }
+  if (level != trace.rssiLevel) {
+    traceEvent(trace, time, "alarm", "rssi", rssiLevels[level]);
+    trace.rssiLevel = level;
+  }
+}
+
+// One period of the mixer and telemetry tasks
+static void replayTick(ReplayTrace & trace, uint64_t now)
+{
+  simuSetVirtualTimer(true, now);
+
+  per10ms();
+  doMixerCalculations();
+  telemetryWakeup();
+
+  uint32_t time = now / 1000;
+  traceSensors(trace, time);
+  traceSwitches(trace, time);
+  traceAlarms(trace, time);
+}
+
+static void replayRecord(const LogsCaptureRecord & record, uint8_t * payload)
+{
+  auto mod = pulsesGetModuleDriver(record.module);
+  if (!mod || !mod->drv)
+    return;
+
+  auto drv = mod->drv;
+  uint8_t * buffer = getTelemetryRxBuffer(record.module);
+  uint8_t & count = getTelemetryRxBufferCount(record.module);
+
+  if (record.type == LOGS_CAPTURE_FRAME && drv->processFrame) {
+    drv->processFrame(mod->ctx, payload, record.length, buffer, &count);
+  }
+  else if (drv->processData) {
+    for (uint16_t i = 0; i < record.length; i += UINT8_MAX) {
+      uint8_t len = min<uint16_t>(record.length - i, UINT8_MAX);
+      drv->processData(mod->ctx, payload + i, len, buffer, &count);
+    }
+  }
+}
+
+// Configures the modules as they were during the capture
+static void replayStartModules(const LogsCaptureHeader & header)
+{
+  for (uint8_t i = 0; i < LOGS_CAPTURE_MODULES && i < MAX_MODULES; i++) {
+    const LogsCaptureModule & captured = header.modules[i];
+    ModuleData & module = g_model.moduleData[i];
+    if (captured.type == MODULE_TYPE_NONE)
+      continue;
+
+    if (module.type != captured.type) {
+      TRACE("replay: module %d type %d replaced by %d", i, module.type, captured.type);
+      module.type = captured.type;
+      module.subType = captured.subType;
+      if (captured.type == MODULE_TYPE_MULTIMODULE)
+        module.multi.rfProtocol = captured.rfProtocol;
+    }
+
+    pulsesSendNextFrame(i);
+  }
+}
+
+static void replayStopModules()
+{
+  for (uint8_t i = 0; i < MAX_MODULES; i++) {
+    pulsesStopModule(i);
+  }
+}
+
+bool simuReplayCapture(const char * path, uint32_t speed, FILE * out,
+                       SimuReplayStats * stats)
+{
+  FILE * f = fopen(path, "rb");
+  if (!f) {
+    TRACE("replay: cannot open %s", path);
+    return false;
+  }
+
+  LogsCaptureHeader header;
+  if (fread(&header, sizeof(header), 1, f) != 1 ||
+      memcmp(header.magic, LOGS_CAPTURE_MAGIC, sizeof(header.magic)) ||
+      header.version != LOGS_CAPTURE_VERSION ||
+      fseek(f, header.headerSize, SEEK_SET)) {
+    TRACE("replay: %s is not a telemetry capture", path);
+    fclose(f);
+    return false;
+  }
+
+  SimuReplayStats localStats;
+  if (!stats)
+    stats = &localStats;
+  memclear(stats, sizeof(SimuReplayStats));
+
+  ReplayTrace trace;
+  memclear(&trace, sizeof(trace));
+  trace.out = out;
+  if (out)
+    fprintf(out, "time_ms,event,name,value\n");
+
+  // the modules and the sensors found during the replay are not kept
+  static ModelData savedModel;
+  memcpy(&savedModel, &g_model, sizeof(ModelData));
+
+  telemetryReset();
+  logicalSwitchesReset();
+  trace.telemetryState = telemetryState;
+  uint8_t previousAllowNewSensors = allowNewSensors;
+  allowNewSensors = true;
+
+  // the clock starts at 0 with the capture
+  uint64_t now = 0;
+  uint64_t nextTick = 0;
+  simuSetVirtualTimer(true, now);
+  replayStartModules(header);
+
+  auto wallStart = std::chrono::steady_clock::now();
+  uint32_t previousTime = 0;
+  bool first = true;
+  LogsCaptureRecord record;
+  static uint8_t payload[UINT16_MAX + 1];
+
+  while (fread(&record, sizeof(record), 1, f) == 1) {
+    if (fread(payload, 1, record.length, f) != record.length) {
+      stats->skipped++;
+      break;
+    }
+
+    // only the difference between consecutive records matters
+    if (!first)
+      now += (uint32_t)(record.time - previousTime);
+    previousTime = record.time;
+    first = false;
+
+    while (nextTick <= now) {
+      replayTick(trace, nextTick);
+      nextTick += 10000;
+      if (speed != SIMU_REPLAY_MAX_SPEED) {
+        std::this_thread::sleep_until(
+            wallStart + std::chrono::microseconds(nextTick / speed));
+      }
+    }
+    simuSetVirtualTimer(true, now);
+
+    stats->records++;
+    if (record.type == LOGS_CAPTURE_FRAME) {
+      stats->frames++;
+    }
+    else if (record.type == LOGS_CAPTURE_DATA) {
+      stats->bytes += record.length;
+    }
+    else {
+      // the channels are recomputed by the mixer
+      if (record.type != LOGS_CAPTURE_CHANNELS)
+        stats->skipped++;
+      continue;
+    }
+    if (record.module < MAX_MODULES)
+      replayRecord(record, payload);
+    else
+      stats->skipped++;
+  }
+
+  // let the telemetry time out so that the end of the flight is traced
+  // (the alarms are checked only every 10s while the RSSI is low)
+  uint64_t end = now + 10000 * (TELEMETRY_TIMEOUT10ms + 1100);
+  while (nextTick <= end) {
+    replayTick(trace, nextTick);
+    nextTick += 10000;
+  }
+  stats->duration = now / 1000;
+
+  replayStopModules();
+  memcpy(&g_model, &savedModel, sizeof(ModelData));
+  modelConfigChanged();
+  telemetryReset();
+  logicalSwitchesReset();
+  allowNewSensors = previousAllowNewSensors;
+  simuSetVirtualTimer(false, 0);
+  fclose(f);
+
+  return true;
+}
+
+int simuReplayMain(int argc, char ** argv)
+{
+  const char * capture = nullptr;
+  const char * tracePath = nullptr;
+  const char * sdPath = nullptr;
+  const char * settingsPath = nullptr;
+  uint32_t speed = SIMU_REPLAY_MAX_SPEED;
+
+  for (int i = 0; i < argc; i++) {
+    if (!strcmp(argv[i], "--speed") && i + 1 < argc) {
+      const char * value = argv[++i];
+      speed = (!strcmp(value, "max") ? SIMU_REPLAY_MAX_SPEED : atoi(value));
+    }
+    else if (!strcmp(argv[i], "--trace") && i + 1 < argc) {
+      tracePath = argv[++i];
+    }
+    else if (!strcmp(argv[i], "--sd") && i + 1 < argc) {
+      sdPath = argv[++i];
+    }
+    else if (!strcmp(argv[i], "--settings") && i + 1 < argc) {
+      settingsPath = argv[++i];
+    }
+    else if (!capture) {
+      capture = argv[i];
+    }
+  }
+
+  if (!capture) {
+    fprintf(stderr, "usage: --replay <capture.etxr> [--speed N|max] [--trace file] "
+                    "[--sd path] [--settings path]\n");
+    return 1;
+  }
+
+  FILE * out = stdout;
+  if (tracePath) {
+    out = fopen(tracePath, "w");
+    if (!out) {
+      fprintf(stderr, "cannot create %s\n", tracePath);
+      return 1;
+    }
+  }
+
+  simuInit();
+  simuFatfsSetPaths(sdPath, settingsPath);
+  if (g_tmr10ms == 0) {
+    g_tmr10ms = 1;
+  }
+#if defined(SDCARD)
+  sdInit();
+#endif
+  storageReadAll();
+
+  SimuReplayStats stats;
+  bool result = simuReplayCapture(capture, speed, out, &stats);
+  if (out != stdout)
+    fclose(out);
+
+  if (!result) {
+    fprintf(stderr, "cannot replay %s\n", capture);
+    return 1;
+  }
+
+  fprintf(stderr, "%u records (%u frames, %u bytes, %u skipped), %u ms\n",
+          stats.records, stats.frames, stats.bytes, stats.skipped,
+          stats.duration);
+  return 0;
+}
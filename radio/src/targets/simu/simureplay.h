@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#ifndef _SIMUREPLAY_H_
+#define _SIMUREPLAY_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+// Headless replay of raw telemetry captures (.etxr, see logs_capture.h)
+//
+// The records are fed to the module drivers of the current model, and
+// the mixer and the telemetry are run every 10ms of capture time. The
+// simulator clock follows the capture timestamps, so that the trace does
+// not depend on the replay speed nor on the host load.
+//
+// The RTOS tasks must not be running (see simuStop()). The model is
+// restored at the end: the module types taken from the capture header and
+// the sensors discovered during the replay are not kept.
+//
+// The trace is a CSV file, one line per event:
+//
+//   time_ms,event,name,value
+//
+// with the events:
+//  - sensor: a telemetry sensor value changed (name = sensor label)
+//  - switch: a logical switch changed (name = L1..L64, value = 0/1)
+//  - alarm: telemetry connected/lost/back, rssi low/critical and
+//    sensor lost (value = sensor label)
+
+#define SIMU_REPLAY_MAX_SPEED   0
+
+struct SimuReplayStats {
+  uint32_t records;
+  uint32_t frames;
+  uint32_t bytes;
+  uint32_t skipped;   // unknown or truncated records
+  uint32_t duration;  // ms of capture time
+};
+
+// speed: 1 = real time, 10 = 10x, SIMU_REPLAY_MAX_SPEED = as fast as possible
+// Returns false if the file could not be opened or is not a capture
+bool simuReplayCapture(const char * path, uint32_t speed, FILE * trace,
+                       SimuReplayStats * stats);
+
+// Command line front-end:
+//   <capture> [--speed N|max] [--trace file] [--sd path] [--settings path]
+int simuReplayMain(int argc, char ** argv);
+
+#endif // _SIMUREPLAY_H_
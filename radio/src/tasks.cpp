@@ -24,6 +24,7 @@
 
 #include "tasks.h"
 #include "tasks/mixer_task.h"
+#include "logs_binary.h"
 
 #include "watchdog_driver.h"
 
@@ -107,6 +108,10 @@ void tasksStart()
   RTOS_CREATE_TASK(menusTaskId, menusTask, "menus", menusStack,
                    MENUS_STACK_SIZE, MENUS_TASK_PRIO);
 
+#if defined(SDCARD)
+  logsBinaryStart();
+#endif
+
 #if !defined(SIMU)
   RTOS_CREATE_TASK(audioTaskId, audioTask, "audio", audioStack,
                    AUDIO_STACK_SIZE, AUDIO_TASK_PRIO);
@@ -22,6 +22,7 @@
 #include "tasks.h"
 #include "mixer_task.h"
 #include "mixer_scheduler.h"
+#include "mixer_stats.h"
 
 #include "opentx.h"
 #include "switches.h"
@@ -193,7 +194,12 @@ TASK_FUNCTION(mixerTask)
       mixerTaskLock();
 
       doMixerCalculations();
+
+      uint32_t t1 = mixerStatsStart();
       pulsesSendChannels();
+      mixerStatsStage(MIXER_STAGE_PULSES, t1);
+      mixerStatsCommit();
+
       doMixerPeriodicUpdates();
 
       // TODO: what are these for???
@@ -242,13 +248,17 @@ void doMixerCalculations()
   // therefore forget the exact calculation and use only 1 instead; good compromise
   lastTMR = tmr10ms;
 
+  uint32_t t0 = mixerStatsStart();
+
   DEBUG_TIMER_START(debugTimerGetAdc);
   getADC();
   DEBUG_TIMER_STOP(debugTimerGetAdc);
+  t0 = mixerStatsStage(MIXER_STAGE_ADC, t0);
 
   DEBUG_TIMER_START(debugTimerGetSwitches);
   getSwitchesPosition(!s_mixer_first_run_done);
   DEBUG_TIMER_STOP(debugTimerGetSwitches);
+  mixerStatsStage(MIXER_STAGE_SWITCHES, t0);
 
   DEBUG_TIMER_START(debugTimerEvalMixes);
   evalMixes(tick10ms);
@@ -20,12 +20,13 @@
  */
 
 #include "opentx.h"
+#include "telemetry_stats.h"
+
+static uint8_t dataState = STATE_DATA_IDLE;
 
 static inline bool pushFrskyTelemetryData(bool is_sport, uint8_t data,
                                           uint8_t* buffer, uint8_t& len)
 {
-  static uint8_t dataState = STATE_DATA_IDLE;
-
   switch (dataState) {
     case STATE_DATA_START:
       if (data == START_STOP) {
@@ -90,6 +91,7 @@ static inline bool pushFrskyTelemetryData(bool is_sport, uint8_t data,
 void processFrskyDTelemetryData(uint8_t module, uint8_t data, uint8_t* buffer, uint8_t& len)
 {
   if (pushFrskyTelemetryData(false, data, buffer, len)) {
+    telemetryStatsFrame(module);
     frskyDProcessPacket(module, buffer, len);
   }
 }
@@ -97,6 +99,31 @@ void processFrskyDTelemetryData(uint8_t module, uint8_t data, uint8_t* buffer, u
 void processFrskySportTelemetryData(uint8_t module, uint8_t data, uint8_t* buffer, uint8_t& len)
 {
   if (pushFrskyTelemetryData(true, data, buffer, len)) {
+    telemetryStatsFrame(module);
     sportProcessTelemetryPacket(module, buffer, len);
   }
 }
+
+void processFrskySportTelemetryData(uint8_t module, const uint8_t* data,
+                                    uint8_t dlen, uint8_t* buffer, uint8_t& len)
+{
+  const uint8_t* end = data + dlen;
+  while (data < end) {
+    if (dataState == STATE_DATA_IN_FRAME) {
+      // plain bytes are copied until the packet is complete,
+      // the delimiters and stuffed bytes go through the state machine
+      while (data < end && *data != START_STOP && *data != BYTE_STUFF &&
+             len < FRSKY_SPORT_PACKET_SIZE) {
+        buffer[len++] = *data++;
+      }
+      if (len >= FRSKY_SPORT_PACKET_SIZE) {
+        dataState = STATE_DATA_IDLE;
+        telemetryStatsFrame(module);
+        sportProcessTelemetryPacket(module, buffer, len);
+        continue;
+      }
+      if (data == end) break;
+    }
+    processFrskySportTelemetryData(module, *data++, buffer, len);
+  }
+}
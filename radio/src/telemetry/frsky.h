@@ -107,6 +107,8 @@ void sportProcessTelemetryPacketWithoutCrc(uint8_t module, uint8_t origin,
 
 void processFrskySportTelemetryData(uint8_t module, uint8_t data,
                                     uint8_t* buffer, uint8_t& len);
+void processFrskySportTelemetryData(uint8_t module, const uint8_t* data,
+                                    uint8_t dlen, uint8_t* buffer, uint8_t& len);
 
 void processFrskyDTelemetryData(uint8_t module, uint8_t data,
                                 uint8_t* buffer, uint8_t& len);
@@ -23,6 +23,7 @@
 #include "ghost_menu.h"
 
 #include "opentx.h"
+#include "telemetry_stats.h"
 
 const char * const ghstRfProfileValue[GHST_RF_PROFILE_COUNT] = { "Auto", "Norm", "Race", "Pure", "Long", "Unused", "Race2", "Pure2" };
 const char * const ghstVtxBandName[GHST_VTX_BAND_COUNT] = { "- - -" , "IRC", "Race", "BandE", "BandB", "BandA" };
@@ -165,8 +166,10 @@ void processGhostTelemetryFrame(uint8_t module, uint8_t* buffer, uint32_t length
 {
   uint8_t frame_len = buffer[1];
   auto frame = buffer + 2;
+  telemetryStatsFrame(module);
   if (!checkGhostTelemetryFrameCRC(frame, frame_len)) {
     TRACE("[GS] CRC error");
+    telemetryStatsCrcError(module);
     return;
   }
 
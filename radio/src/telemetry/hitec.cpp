@@ -162,7 +162,7 @@ enum
 
 #define HS(id,name,unit,precision) {id,unit,precision,name}
 
-const HitecSensor hitecSensors[] = {
+constexpr HitecSensor hitecSensors[] = {
   //frame 00
   HS(HITEC_ID_RX_VOLTAGE,   STR_SENSOR_BATT,       UNIT_VOLTS,             2),  // RX_Batt Voltage
   //frame 11
@@ -206,12 +206,28 @@ const HitecSensor hitecSensors[] = {
   HS(0x00,                  NULL,            UNIT_RAW,               0),  // sentinel
 };
 
+// hitecSensors[] must stay sorted by id
+constexpr bool isHitecSensorsTableSorted(unsigned i = 1)
+{
+  return hitecSensors[i].id == 0 ||
+         (hitecSensors[i - 1].id < hitecSensors[i].id && isHitecSensorsTableSorted(i + 1));
+}
+
+static_assert(isHitecSensorsTableSorted(), "hitecSensors[] is not sorted");
+
 const HitecSensor * getHitecSensor(uint16_t id)
 {
-  for (const HitecSensor * sensor = hitecSensors; sensor->id; sensor++) {
-    if (id == sensor->id)
-      return sensor;
+  // binary search, the sentinel is not searched
+  unsigned lo = 0, hi = DIM(hitecSensors) - 1;
+  while (lo < hi) {
+    unsigned mid = (lo + hi) / 2;
+    if (hitecSensors[mid].id < id)
+      lo = mid + 1;
+    else
+      hi = mid;
   }
+  if (hitecSensors[lo].id == id && id)
+    return &hitecSensors[lo];
   return nullptr;
 }
 
@@ -219,11 +219,7 @@ struct HottSensor
 
 #define HS(id,name,unit,precision) {id,unit,precision,name}
 
-const HottSensor hottSensors[] = {
-  // TX
-  HS( HOTT_ID_TX_RSSI_DL,   STR_SENSOR_HOTT_ID_TX_RSSI_DL,  UNIT_DB, 0),                	// downlink signal strength (rx --> tx as seen by tx) 
-  HS( HOTT_ID_TX_LQI_DL,    STR_SENSOR_HOTT_ID_TX_LQI_DL,   UNIT_RAW, 0),               	// downlink signal quality (rx --> tx s seen by tx)
-
+constexpr HottSensor hottSensors[] = {
   // RX
   HS( HOTT_ID_RX_RSSI_UL,   STR_SENSOR_HOTT_ID_RX_RSSI_UL,  UNIT_DB, 0 ),               	// uplink signal strength (tx --> rx as seen by rx)
   HS( HOTT_ID_RX_LQI_UL,    STR_SENSOR_HOTT_ID_RX_LQI_UL,   UNIT_RAW, 0 ),              	// uplink signal quality (tx --> rx as seen by rx)
@@ -288,17 +284,37 @@ const HottSensor hottSensors[] = {
   HS( HOTT_ID_EAM_VV,       STR_SENSOR_HOTT_ID_EAM_VV,      UNIT_METERS_PER_SECOND, 2 ),	// EAM vertical velcocity
   HS( HOTT_ID_EAM_RPM,      STR_SENSOR_HOTT_ID_EAM_RPM,    UNIT_RPMS, 0 ),              	// EAM rpm  
   HS( HOTT_ID_EAM_SPEED,    STR_SENSOR_HOTT_ID_EAM_SPEED,   UNIT_KMH,  0 ) ,            	// EAM speed
+
+  // TX
+  HS( HOTT_ID_TX_RSSI_DL,   STR_SENSOR_HOTT_ID_TX_RSSI_DL,  UNIT_DB, 0),                	// downlink signal strength (rx --> tx as seen by tx) 
+  HS( HOTT_ID_TX_LQI_DL,    STR_SENSOR_HOTT_ID_TX_LQI_DL,   UNIT_RAW, 0),               	// downlink signal quality (rx --> tx s seen by tx)
   
   // sentinel
   HS(0x00,                  NULL,                     UNIT_RAW, 0)                // sentinel
 };
 
+// hottSensors[] must stay sorted by id
+constexpr bool isHottSensorsTableSorted(unsigned i = 1)
+{
+  return hottSensors[i].id == 0 ||
+         (hottSensors[i - 1].id < hottSensors[i].id && isHottSensorsTableSorted(i + 1));
+}
+
+static_assert(isHottSensorsTableSorted(), "hottSensors[] is not sorted");
+
 const HottSensor * getHottSensor(uint16_t id)
 {
-  for (const HottSensor * sensor = hottSensors; sensor->id; sensor++) {
-    if (id == sensor->id)
-      return sensor;
+  // binary search, the sentinel is not searched
+  unsigned lo = 0, hi = DIM(hottSensors) - 1;
+  while (lo < hi) {
+    unsigned mid = (lo + hi) / 2;
+    if (hottSensors[mid].id < id)
+      lo = mid + 1;
+    else
+      hi = mid;
   }
+  if (hottSensors[lo].id == id && id)
+    return &hottSensors[lo];
   return nullptr;
 }
 
@@ -22,6 +22,7 @@
 #include "hal/module_port.h"
 
 #include "telemetry.h"
+#include "telemetry_stats.h"
 #include "io/multi_protolist.h"
 #include "multi.h"
 #include "spektrum.h"
@@ -381,59 +382,75 @@ static void processMultiTelemetryPaket(const uint8_t * packet, uint8_t module)
       // just send one byte of our header instead
       if (len >= 17)
         processSpektrumPacket(data - 1);
-      else
+      else {
         TRACE("[MP] Received spektrum telemetry len %d < 17", len);
+        telemetryStatsSizeError(module);
+      }
       break;
 
     case FlyskyIBusTelemetry:
       if (len >= 28)
         processFlySkyPacket(data);
-      else
+      else {
         TRACE("[MP] Received IBUS telemetry len %d < 28", len);
+        telemetryStatsSizeError(module);
+      }
       break;
 
     case FlyskyIBusTelemetryAC:
       if (len >= 28)
         processFlySkyPacketAC(data);
-      else
+      else {
         TRACE("[MP] Received IBUS telemetry AC len %d < 28", len);
+        telemetryStatsSizeError(module);
+      }
       break;
 
     case HitecTelemetry:
       if (len >= 8)
         processHitecPacket(data);
-      else
+      else {
         TRACE("[MP] Received Hitec telemetry len %d < 8", len);
+        telemetryStatsSizeError(module);
+      }
       break;
 
     case HottTelemetry:
       if (len >= 14)
         processHottPacket(data);
-      else
+      else {
         TRACE("[MP] Received HoTT telemetry len %d < 14", len);
+        telemetryStatsSizeError(module);
+      }
       break;
 
     case MLinkTelemetry:
       if (len > 6)
         processMLinkPacket(data, true);
-      else
+      else {
         TRACE("[MP] Received M-Link telemetry len %d <= 6", len);
+        telemetryStatsSizeError(module);
+      }
       break;
 
 #if defined(LUA)
     case ConfigTelemetry:
       if (len >= 21)
         processConfigPacket(data, len);
-      else
+      else {
         TRACE("[MP] Received Config telemetry len %d < 20", len);
+        telemetryStatsSizeError(module);
+      }
       break;
 #endif
 
     case FrSkyHubTelemetry:
       if (len >= 4)
         frskyDProcessPacket(module, data, len);
-      else
+      else {
         TRACE("[MP] Received Frsky HUB telemetry len %d < 4", len);
+        telemetryStatsSizeError(module);
+      }
       break;
 
     case FrSkySportTelemetry:
@@ -450,15 +467,19 @@ static void processMultiTelemetryPaket(const uint8_t * packet, uint8_t module)
           }
         }
       }
-      else
+      else {
         TRACE("[MP] Received sport telemetry len %d < 4", len);
+        telemetryStatsSizeError(module);
+      }
       break;
 
     case InputSync:
       if (len >= 6)
         processMultiSyncPacket(data, module);
-      else
+      else {
         TRACE("[MP] Received input sync len %d < 6", len);
+        telemetryStatsSizeError(module);
+      }
       break;
 
     case ConfigCommand:
@@ -479,16 +500,20 @@ static void processMultiTelemetryPaket(const uint8_t * packet, uint8_t module)
     case SpectrumScannerPacket:
       if (len == 6)
         processMultiScannerPacket(data, module);
-      else
+      else {
         TRACE("[MP] Received spectrum scanner len %d != 6", len);
+        telemetryStatsSizeError(module);
+      }
       break;
 
 #if defined(PCBTARANIS) || defined(PCBHORUS)
     case MultiRxChannels:
       if (len >= 4)
         processMultiRxChannels(data, len);
-      else
+      else {
         TRACE("[MP] Received RX channels len %d < 4", len);
+        telemetryStatsSizeError(module);
+      }
       break;
 #endif
 
@@ -578,6 +603,7 @@ static void processMultiTelemetryByte(const uint8_t data, uint8_t module)
   }
   else {
     TRACE("[MP] array size %d error", rxBufferCount);
+    telemetryStatsSizeError(module);
     setMultiTelemetryBufferState(module, NoProtocolDetected);
   }
 
@@ -594,6 +620,7 @@ static void processMultiTelemetryByte(const uint8_t data, uint8_t module)
     debugPrintf(CRLF);
 #endif
     // Packet is complete, process it
+    telemetryStatsFrame(module);
     processMultiTelemetryPaket(rxBuffer, module);
     setMultiTelemetryBufferState(module, NoProtocolDetected);
   }
@@ -707,12 +734,14 @@ void processMultiTelemetryData(uint8_t data, uint8_t module)
         if (rxBufferCount > 24) {
           // too long ignore
           TRACE("Overlong multi status packet detected ignoring, wanted %d", rxBuffer[0]);
+          telemetryStatsSizeError(module);
           rxBufferCount = 0;
           setMultiTelemetryBufferState(module, NoProtocolDetected);
         }
       }
       else {
         TRACE("[MP] array size %d error", rxBufferCount);
+        telemetryStatsSizeError(module);
         setMultiTelemetryBufferState(module, NoProtocolDetected);
       }
       break;
@@ -722,6 +751,31 @@ void processMultiTelemetryData(uint8_t data, uint8_t module)
   }
 }
 
+void processMultiTelemetryData(const uint8_t * data, uint8_t dlen, uint8_t module)
+{
+  uint8_t * rxBuffer = getTelemetryRxBuffer(module);
+  uint8_t &rxBufferCount = getTelemetryRxBufferCount(module);
+
+  const uint8_t * end = data + dlen;
+  while (data < end) {
+    // the packet length is known from its 2nd byte: the bytes up to the
+    // last one are copied, which then goes through the byte decoder
+    if (getMultiTelemetryBufferState(module) == ReceivingMultiProtocol &&
+        rxBufferCount >= 2) {
+      unsigned packetLength = rxBuffer[1] + 2;
+      if (packetLength <= TELEMETRY_RX_PACKET_SIZE &&
+          rxBufferCount + 1u < packetLength) {
+        uint8_t count = min<int>(end - data, packetLength - 1 - rxBufferCount);
+        memcpy(&rxBuffer[rxBufferCount], data, count);
+        rxBufferCount += count;
+        data += count;
+        continue;
+      }
+    }
+    processMultiTelemetryData(*data++, module);
+  }
+}
+
 bool isMultiTelemReceiving(uint8_t module)
 {
   return getMultiTelemetryBufferState(module) != NoProtocolDetected;
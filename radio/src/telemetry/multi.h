@@ -94,6 +94,7 @@ Type 0x0B Spectrum Scanner telemetry data
 */
 
 void processMultiTelemetryData(uint8_t data, uint8_t module);
+void processMultiTelemetryData(const uint8_t * data, uint8_t dlen, uint8_t module);
 
 #define MULTI_SCANNER_MAX_CHANNEL 249
 
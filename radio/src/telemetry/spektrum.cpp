@@ -21,6 +21,7 @@
 
 #include "opentx.h"
 #include "spektrum.h"
+#include "telemetry_stats.h"
 #include "hal/module_port.h"
 #include "tasks/mixer_task.h"
 
@@ -142,7 +143,7 @@ struct SpektrumSensor {
 
 #define SS(i2caddress,startByte,dataType,name,unit,precision) {i2caddress,startByte,dataType,precision,unit,name}
 
-const SpektrumSensor spektrumSensors[] = {
+constexpr SpektrumSensor spektrumSensors[] = {
   // 0x01 High voltage internal sensor
   SS(I2C_VOLTAGE,      0,  int16,     STR_SENSOR_A1,                UNIT_VOLTS,     2), // 0.01V increments 
 
@@ -353,6 +354,33 @@ const SpektrumSensor spektrumSensors[] = {
   SS(0,                0,  int16,     NULL,                   UNIT_RAW,             0) //sentinel
 };
 
+// spektrumSensors[] must stay sorted by (i2caddress, startByte)
+constexpr bool isSpektrumSensorsTableSorted(unsigned i = 1)
+{
+  return spektrumSensors[i].i2caddress == 0 ||
+         ((spektrumSensors[i - 1].i2caddress < spektrumSensors[i].i2caddress ||
+           (spektrumSensors[i - 1].i2caddress == spektrumSensors[i].i2caddress &&
+            spektrumSensors[i - 1].startByte <= spektrumSensors[i].startByte)) &&
+          isSpektrumSensorsTableSorted(i + 1));
+}
+
+static_assert(isSpektrumSensorsTableSorted(), "spektrumSensors[] is not sorted");
+
+// Returns the first sensor whose pseudoId is not lower than pseudoId
+// (the sentinel when there is none)
+static const SpektrumSensor * findSpektrumSensor(uint16_t pseudoId)
+{
+  unsigned lo = 0, hi = DIM(spektrumSensors) - 1;
+  while (lo < hi) {
+    unsigned mid = (lo + hi) / 2;
+    if ((spektrumSensors[mid].i2caddress << 8 | spektrumSensors[mid].startByte) < pseudoId)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return &spektrumSensors[lo];
+}
+
 // Alt Low and High needs to be combined (in 2 diff packets)
 static uint8_t gpsAltHigh = 0;
 
@@ -612,12 +640,10 @@ void processSpektrumPacket(const uint8_t *packet)
   } // I2C_SMART_BAT_BASE_ADDRESS
 
   bool handled = false;
-  for (const SpektrumSensor * sensor = spektrumSensors; sensor->i2caddress; sensor++) {
+  for (const SpektrumSensor * sensor = findSpektrumSensor(i2cAddress << 8);
+       sensor->i2caddress == i2cAddress; sensor++) {
     uint16_t pseudoId = (sensor->i2caddress << 8 | sensor->startByte);
 
-    if (i2cAddress != sensor->i2caddress)  // Not the sensor for current packet
-      continue;
-  
     handled = true;
 
     // Extract value, skip header
@@ -856,6 +882,7 @@ void processSpektrumTelemetryData(uint8_t module, uint8_t data,
   }
   else {
     TRACE("[SPK] array size %d error", rxBufferCount);
+    telemetryStatsSizeError(module);
     rxBufferCount = 0;
   }
 
@@ -876,19 +903,40 @@ void processSpektrumTelemetryData(uint8_t module, uint8_t data,
     }
     debugPrintf(CRLF);
 #endif
+    telemetryStatsFrame(module);
     processSpektrumPacket(rxBuffer);
     rxBufferCount = 0;
   }
 }
 
-const SpektrumSensor *getSpektrumSensor(uint16_t pseudoId)
+void processSpektrumTelemetryData(uint8_t module, const uint8_t *data,
+                                  uint8_t dlen, uint8_t *rxBuffer,
+                                  uint8_t &rxBufferCount)
 {
-  uint8_t startByte = (uint8_t) (pseudoId & 0xff);
-  uint8_t i2cadd = (uint8_t) (pseudoId >> 8);
-  for (const SpektrumSensor * sensor = spektrumSensors; sensor->i2caddress; sensor++) {
-    if (i2cadd == sensor->i2caddress && startByte == sensor->startByte) {
-      return sensor;
+  const uint8_t *end = data + dlen;
+  while (data < end) {
+    // the packet length is known from its 2nd byte: the bytes up to the
+    // last one are copied, which then goes through the byte decoder
+    if (rxBufferCount >= 2) {
+      uint8_t packetLength = rxBuffer[1] == 0x80 ? DSM_BIND_PACKET_LENGTH
+                                                 : SPEKTRUM_TELEMETRY_LENGTH;
+      if (rxBufferCount + 1 < packetLength) {
+        uint8_t count = min<int>(end - data, packetLength - 1 - rxBufferCount);
+        memcpy(&rxBuffer[rxBufferCount], data, count);
+        rxBufferCount += count;
+        data += count;
+        continue;
+      }
     }
+    processSpektrumTelemetryData(module, *data++, rxBuffer, rxBufferCount);
+  }
+}
+
+const SpektrumSensor *getSpektrumSensor(uint16_t pseudoId)
+{
+  const SpektrumSensor * sensor = findSpektrumSensor(pseudoId);
+  if (sensor->i2caddress && (sensor->i2caddress << 8 | sensor->startByte) == pseudoId) {
+    return sensor;
   }
   return nullptr;
 }
@@ -24,6 +24,10 @@
 #include "pulses/afhds3.h"
 #include "pulses/flysky.h"
 #include "mixer_scheduler.h"
+#include "mixer_stats.h"
+#include "telemetry_stats.h"
+#include "telemetry_history.h"
+#include "logs_capture.h"
 #include "io/multi_protolist.h"
 #include "hal/module_port.h"
 
@@ -178,6 +182,15 @@ void telemetryMirrorSend(uint8_t data)
   }
 }
 
+// RX overruns are counted by the serial driver (frames merged, bytes lost)
+static void _check_rx_overruns(uint8_t module, const etx_serial_driver_t* drv,
+                               void* ctx)
+{
+  if (!drv->getRxOverruns) return;
+  uint32_t overruns = drv->getRxOverruns(ctx);
+  if (overruns) telemetryStatsOverrun(module, overruns);
+}
+
 #if !defined(SIMU)
 static TimerHandle_t telemetryTimer = nullptr;
 static StaticTimer_t telemetryTimerBuffer;
@@ -235,9 +248,31 @@ static void _poll_frame(void *pvParameter1, uint32_t ulParameter2)
     return;
 
   uint8_t frame[TELEMETRY_RX_PACKET_SIZE];
+  uint8_t* rxBuffer = getTelemetryRxBuffer(module);
+  uint8_t& rxBufferCount = getTelemetryRxBufferCount(module);
+
+  // drain all the frames received since the last call,
+  // or whatever is in the RX buffer if the port cannot delimit frames
+  bool delimited = serial_drv->copyRxFrame != nullptr;
+  bool decoded = false;
+  while (true) {
+    int frame_len = -1;
+    if (delimited) {
+      frame_len = serial_drv->copyRxFrame(serial_ctx, frame, sizeof(frame));
+      delimited = (frame_len >= 0);
+    }
+    if (!delimited) {
+      frame_len = serial_drv->copyRxBuffer(serial_ctx, frame, sizeof(frame));
+    }
+    if (frame_len <= 0) break;
+
+    telemetryStatsBytes(module, frame_len);
+    if (delimited && frame_len == sizeof(frame)) {
+      // oversize frame: the rest follows in the next chunk
+      telemetryStatsSizeError(module);
+    }
 
-  int frame_len = serial_drv->copyRxBuffer(serial_ctx, frame, TELEMETRY_RX_PACKET_SIZE);
-  if (frame_len > 0) {
+    LOGS_CAPTURE_TELEMETRY(module, LOGS_CAPTURE_FRAME, frame, frame_len);
 
     LOG_TELEMETRY_WRITE_START();
     for (int i = 0; i < frame_len; i++) {
@@ -245,18 +280,29 @@ static void _poll_frame(void *pvParameter1, uint32_t ulParameter2)
       LOG_TELEMETRY_WRITE_BYTE(frame[i]);
     }
 
-    uint8_t* rxBuffer = getTelemetryRxBuffer(module);
-    uint8_t& rxBufferCount = getTelemetryRxBufferCount(module);
     drv->processFrame(ctx, frame, frame_len, rxBuffer, &rxBufferCount);
+    decoded = true;
+    if (!delimited) break;
+  }
+
+  if (decoded) {
+    telemetryStatsFrameDecoded(module);
   }
 
+  _check_rx_overruns(module, serial_drv, serial_ctx);
+
   _telemetryIsPolling = false;
 }
 
 void telemetryFrameTrigger_ISR(uint8_t module, const etx_proto_driver_t* drv)
 {
+  telemetryStatsFrameEnd_ISR(module);
+
+  // a failed call loses nothing: the frame stays queued
+  // in the serial driver until the next poll
   BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-  xTimerPendFunctionCallFromISR(_poll_frame, (void*)drv, module, &xHigherPriorityTaskWoken);
+  xTimerPendFunctionCallFromISR(_poll_frame, (void*)drv, module,
+                                &xHigherPriorityTaskWoken);
   portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
 }
 #endif
@@ -277,6 +323,21 @@ inline bool isBadAntennaDetected()
   return false;
 }
 
+// Fetches the received bytes in chunks rather than one by one
+static int _copy_rx_chunk(const etx_serial_driver_t* drv, void* ctx,
+                          uint8_t* chunk, uint32_t size)
+{
+  if (drv->copyRxBuffer) {
+    return drv->copyRxBuffer(ctx, chunk, size);
+  }
+
+  uint32_t len = 0;
+  while (len < size && drv->getByte(ctx, &chunk[len]) > 0) {
+    len++;
+  }
+  return len;
+}
+
 static inline void pollTelemetry(uint8_t module, const etx_proto_driver_t* drv, void* ctx)
 {
   if (!drv || !drv->processData) return;
@@ -288,20 +349,31 @@ static inline void pollTelemetry(uint8_t module, const etx_proto_driver_t* drv,
   if (!serial_drv  || !serial_ctx || !serial_drv->getByte)
     return;
 
+  _check_rx_overruns(module, serial_drv, serial_ctx);
+
   uint8_t* rxBuffer = getTelemetryRxBuffer(module);
   uint8_t& rxBufferCount = getTelemetryRxBufferCount(module);
 
-  uint8_t data;
-  if (serial_drv->getByte(serial_ctx, &data) > 0) {
+  // the protocol gets the whole chunk at once
+  uint8_t chunk[TELEMETRY_RX_CHUNK_SIZE];
+  int len = _copy_rx_chunk(serial_drv, serial_ctx, chunk, sizeof(chunk));
+  if (len > 0) {
     LOG_TELEMETRY_WRITE_START();
     do {
-      telemetryMirrorSend(data);
-      drv->processData(ctx, data, rxBuffer, &rxBufferCount);
-      LOG_TELEMETRY_WRITE_BYTE(data);
-    } while (serial_drv->getByte(serial_ctx, &data) > 0);
+      telemetryStatsBytes(module, len);
+      LOGS_CAPTURE_TELEMETRY(module, LOGS_CAPTURE_DATA, chunk, len);
+      for (int i = 0; i < len; i++) {
+        telemetryMirrorSend(chunk[i]);
+        LOG_TELEMETRY_WRITE_BYTE(chunk[i]);
+      }
+      drv->processData(ctx, chunk, len, rxBuffer, &rxBufferCount);
+      len = _copy_rx_chunk(serial_drv, serial_ctx, chunk, sizeof(chunk));
+    } while (len > 0);
   }
 }
 
+static tmr10ms_t alarmsCheckTime = 0;
+
 void telemetryWakeup()
 {
   _telemetryIsPolling = true;
@@ -312,12 +384,7 @@ void telemetryWakeup()
   }
   _telemetryIsPolling = false;
 
-  for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
-    const TelemetrySensor& sensor = g_model.telemetrySensors[i];
-    if (sensor.type == TELEM_TYPE_CALCULATED) {
-      telemetryItems[i].eval(sensor);
-    }
-  }
+  evalCalculatedSensors();
 
 #if defined(VARIO)
   if (TELEMETRY_STREAMING() && !IS_FAI_ENABLED()) {
@@ -325,7 +392,6 @@ void telemetryWakeup()
   }
 #endif
 
-  static tmr10ms_t alarmsCheckTime = 0;
 #define SCHEDULE_NEXT_ALARMS_CHECK(seconds) \
   alarmsCheckTime = get_tmr10ms() + (100 * (seconds))
   if (int32_t(get_tmr10ms() - alarmsCheckTime) > 0) {
@@ -438,6 +504,9 @@ void telemetryReset()
 
   telemetryStreaming = 0; // reset counter only if valid telemetry packets are being detected
   telemetryState = TELEMETRY_INIT;
+  alarmsCheckTime = get_tmr10ms();
+
+  telemetryHistoryClear();
 }
 
 #if defined(LOG_TELEMETRY) && !defined(SIMU)
@@ -501,9 +570,13 @@ void ModuleSyncStatus::update(uint16_t newRefreshRate, int16_t newInputLag)
 
   refreshRate = newRefreshRate;
   inputLag    = newInputLag;
-  currentLag  = newInputLag;
+  // a target further than half a period would lock onto the previous frame
+  int16_t maxOffset = newRefreshRate / 2;
+  currentLag  = newInputLag - limit<int16_t>(-maxOffset, phaseOffset, maxOffset);
   lastUpdate  = get_tmr10ms();
 
+  mixerStatsSample(MIXER_STATS_SYNC_LAG, currentLag);
+
 #if 0
   TRACE("[SYNC] update rate = %dus; lag = %dus",refreshRate,currentLag);
 #endif
@@ -514,6 +587,15 @@ void ModuleSyncStatus::invalidate() {
   currentLag = 0;
 }
 
+void ModuleSyncStatus::setPhaseOffset(int16_t offset)
+{
+  // applied from the next update
+  phaseOffset = offset;
+}
+
+// max period correction per frame (1/4 of the period)
+constexpr int16_t SYNC_MAX_SLEW_DIVIDER = 4;
+
 uint16_t ModuleSyncStatus::getAdjustedRefreshRate()
 {
   int16_t lag = currentLag;
@@ -523,8 +605,19 @@ uint16_t ModuleSyncStatus::getAdjustedRefreshRate()
     return refreshRate;
   }
   
+  // Spread large corrections over several frames: stretching
+  // a single frame by several periods would make the module
+  // miss frames at high link rates.
+  int16_t maxSlew = refreshRate / SYNC_MAX_SLEW_DIVIDER;
+  if (lag > maxSlew) {
+    lag = maxSlew;
+  }
+  else if (lag < -maxSlew) {
+    lag = -maxSlew;
+  }
+
   newRefreshRate += lag;
-  
+
   if (newRefreshRate < MIN_REFRESH_RATE) {
       newRefreshRate = MIN_REFRESH_RATE;
   }
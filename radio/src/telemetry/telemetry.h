@@ -57,6 +57,9 @@ constexpr uint8_t TELEMETRY_TIMEOUT10ms = 100; // 1 second
 #define TELEMETRY_RX_PACKET_SIZE       19  // 9 bytes (full packet), worst case 18 bytes with byte-stuffing (+1)
 #endif
 
+// bytes fetched at once from the serial RX buffer by byte-stream protocols
+#define TELEMETRY_RX_CHUNK_SIZE        32
+
 //TODO: remove this public definition
 extern uint8_t telemetryRxBuffer[TELEMETRY_RX_PACKET_SIZE];
 extern uint8_t telemetryRxBufferCount;
@@ -252,7 +255,11 @@ struct ModuleSyncStatus
 
   tmr10ms_t lastUpdate;  // in 10ms
   int16_t   currentLag;  // in us
-  
+
+  // phase lock target: frames are sent this early
+  // before the point requested by the module
+  int16_t   phaseOffset; // in us
+
   inline bool isValid() const {
     // 2 seconds
     return (get_tmr10ms() - lastUpdate < 200);
@@ -264,6 +271,9 @@ struct ModuleSyncStatus
   //mark as timeouted
   void invalidate();
 
+  // Set the phase lock target (0: the module's own send point)
+  void setPhaseOffset(int16_t offset);
+
   // Get computed settings for scheduler
   uint16_t getAdjustedRefreshRate();
 
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "opentx.h"
+#include "telemetry_history.h"
+
+// allocated by the first telemetryHistoryEnable() call, and kept afterwards
+static TelemetryHistory * _telemetry_history = nullptr;
+
+// held while a slot is handed over to another sensor or fed
+static RTOS_MUTEX_HANDLE historyMutex;
+
+static bool telemetryHistoryAllocate()
+{
+  if (_telemetry_history)
+    return true;
+
+  auto history = (TelemetryHistory *)calloc(TELEMETRY_HISTORY_SLOTS,
+                                            sizeof(TelemetryHistory));
+  if (!history)
+    return false;
+
+  RTOS_CREATE_MUTEX(historyMutex);
+  _telemetry_history = history;
+  return true;
+}
+
+static TelemetryHistory * telemetryHistoryFind(uint8_t index, uint16_t period)
+{
+  for (uint8_t i = 0; i < TELEMETRY_HISTORY_SLOTS; i++) {
+    auto & history = _telemetry_history[i];
+    if (history.sensor == index + 1 && (!period || history.period == period)) {
+      history.lastAccess = get_tmr10ms();
+      return &history;
+    }
+  }
+  return nullptr;
+}
+
+TelemetryHistory * telemetryHistoryGet(uint8_t index)
+{
+  if (!_telemetry_history)
+    return nullptr;
+
+  return telemetryHistoryFind(index, 0);
+}
+
+TelemetryHistory * telemetryHistoryEnable(uint8_t index, uint16_t period, uint16_t depth)
+{
+  if (index >= MAX_TELEMETRY_SENSORS || period == 0 || depth == 0)
+    return nullptr;
+
+  if (!telemetryHistoryAllocate())
+    return nullptr;
+
+  if (depth > TELEMETRY_HISTORY_DEPTH)
+    depth = TELEMETRY_HISTORY_DEPTH;
+
+  auto history = telemetryHistoryFind(index, period);
+  if (history) {
+    // shared with the other readers, they only get more samples
+    if (history->depth < depth)
+      history->depth = depth;
+    return history;
+  }
+
+  // a free slot, or the least recently read one if nobody reads it anymore
+  tmr10ms_t now = get_tmr10ms();
+  for (uint8_t i = 0; i < TELEMETRY_HISTORY_SLOTS; i++) {
+    auto & slot = _telemetry_history[i];
+    if (!slot.sensor) {
+      history = &slot;
+      break;
+    }
+    if (now - slot.lastAccess >= TELEMETRY_HISTORY_IDLE_TIME &&
+        (!history || int32_t(slot.lastAccess - history->lastAccess) < 0)) {
+      history = &slot;
+    }
+  }
+
+  if (!history)
+    return nullptr;
+
+  RTOS_LOCK_MUTEX(historyMutex);
+  history->period = period;
+  history->depth = depth;
+  history->count = 0;
+  history->head = 0;
+  history->lastAccess = now;
+  history->sensor = index + 1;
+  RTOS_UNLOCK_MUTEX(historyMutex);
+
+  return history;
+}
+
+void telemetryHistoryAdd(uint8_t index, int32_t value)
+{
+  if (!_telemetry_history)
+    return;
+
+  // called by the telemetry: the value is dropped
+  // rather than waiting for a slot handover
+  if (!RTOS_TRYLOCK_MUTEX(historyMutex))
+    return;
+
+  for (uint8_t i = 0; i < TELEMETRY_HISTORY_SLOTS; i++) {
+    auto & history = _telemetry_history[i];
+    if (history.sensor != index + 1)
+      continue;
+
+    tmr10ms_t now = get_tmr10ms();
+    if (history.count == 0 || now - history.sampleTime >= history.period) {
+      if (history.count > 0)
+        history.head = (history.head + 1) % TELEMETRY_HISTORY_DEPTH;
+      if (history.count < history.depth)
+        history.count++;
+      history.samples[history.head] = { value, value };
+      history.sampleTime = now;
+    }
+    else {
+      auto & sample = history.samples[history.head];
+      if (value < sample.min)
+        sample.min = value;
+      else if (value > sample.max)
+        sample.max = value;
+    }
+  }
+
+  RTOS_UNLOCK_MUTEX(historyMutex);
+}
+
+void telemetryHistoryClear()
+{
+  if (!_telemetry_history)
+    return;
+
+  RTOS_LOCK_MUTEX(historyMutex);
+  for (uint8_t i = 0; i < TELEMETRY_HISTORY_SLOTS; i++) {
+    _telemetry_history[i].count = 0;
+    _telemetry_history[i].head = 0;
+  }
+  RTOS_UNLOCK_MUTEX(historyMutex);
+}
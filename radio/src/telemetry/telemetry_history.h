@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+#include "opentx_types.h"
+
+// Telemetry sensors history, for graphs (Lua scripts, widgets).
+//
+// A few sensors at a time keep the history of their values, so that
+// graphs do not have to poll them and keep their own copies. The rings
+// are allocated by the first telemetryHistoryEnable() call, handed over
+// on demand to a sensor and a sample period (the least recently read
+// one being reused, unless it is still read by someone), and fed by
+// TelemetryItem::setValue().
+//
+// Each sample holds the min and the max of the values received during
+// the sample period. Periods without any value do not add samples.
+//
+// The depth is given by each request, up to TELEMETRY_HISTORY_DEPTH: the
+// rings are allocated once at this size, so that the telemetry never
+// allocates memory when it feeds them, and the readers sharing a ring
+// never see it resized under them.
+
+#if defined(COLORLCD)
+  #define TELEMETRY_HISTORY_DEPTH   256
+#else
+  #define TELEMETRY_HISTORY_DEPTH   64
+#endif
+#define TELEMETRY_HISTORY_SLOTS     4
+
+// a history read within this time (10ms) is not handed over
+#define TELEMETRY_HISTORY_IDLE_TIME 500
+
+struct TelemetryHistorySample {
+  int32_t min;
+  int32_t max;
+};
+
+struct TelemetryHistory {
+  uint8_t sensor;         // sensor index + 1, 0 when the slot is free
+  uint16_t period;        // 10ms
+  uint16_t depth;         // samples kept, the deepest request
+  uint16_t count;         // samples available, including the current one
+  uint16_t head;          // current sample
+  tmr10ms_t sampleTime;   // start of the current sample
+  tmr10ms_t lastAccess;
+  TelemetryHistorySample samples[TELEMETRY_HISTORY_DEPTH];
+
+  // i = 0 is the newest sample, i < count
+  const TelemetryHistorySample & get(uint16_t i) const
+  {
+    return samples[(head + TELEMETRY_HISTORY_DEPTH - i) % TELEMETRY_HISTORY_DEPTH];
+  }
+};
+
+// Returns the history of a sensor with this sample period, allocating it
+// if needed, or nullptr if out of memory or all the histories are read
+TelemetryHistory * telemetryHistoryEnable(uint8_t index, uint16_t period,
+                                          uint16_t depth = TELEMETRY_HISTORY_DEPTH);
+
+// Returns a history of a sensor, whatever its period,
+// or nullptr if it is not enabled
+TelemetryHistory * telemetryHistoryGet(uint8_t index);
+
+void telemetryHistoryAdd(uint8_t index, int32_t value);
+
+// Clears all the samples (telemetry reset)
+void telemetryHistoryClear();
@@ -20,6 +20,7 @@
  */
 
 #include "opentx.h"
+#include "telemetry_history.h"
 #define _USE_MATH_DEFINES
 #include <math.h>
 
@@ -56,6 +57,17 @@
 #endif
 
 TelemetryItem telemetryItems[MAX_TELEMETRY_SENSORS];
+
+// items which received a value since the last calculated sensors evaluation
+static bool telemetryItemsUpdated[MAX_TELEMETRY_SENSORS];
+
+static inline void setTelemetryItemUpdated(const TelemetryItem * item)
+{
+  // some items are local copies
+  if (item >= telemetryItems && item < telemetryItems + MAX_TELEMETRY_SENSORS) {
+    telemetryItemsUpdated[item - telemetryItems] = true;
+  }
+}
 uint8_t allowNewSensors;
 
 bool isFaiForbidden(source_t idx)
@@ -68,20 +80,9 @@ bool isFaiForbidden(source_t idx)
   return true;
 }
 
-// TODO in maths
-uint32_t getDistFromEarthAxis(int32_t latitude)
-{
-  uint32_t lat = abs(latitude) / 10000;
-  uint32_t angle2 = (lat * lat) / 10000;
-  uint32_t angle4 = angle2 * angle2;
-
-  return 139 * (((uint32_t)10000000 - ((angle2 * (uint32_t)123370) / 81) +
-                 (angle4 / 25)) /
-                12500);
-}
-
 void TelemetryItem::setValue(const TelemetrySensor & sensor, const char * val, uint32_t, uint32_t)
 {
+  setTelemetryItemUpdated(this);
   strncpy(text, val, sizeof(text));
   // Save hash of string so changes can be detected quickly
   value = hash(text, sizeof(text));
@@ -91,6 +92,8 @@ void TelemetryItem::setValue(const TelemetrySensor & sensor, const char * val, u
 void TelemetryItem::setValue(const TelemetrySensor &sensor, int32_t val,
                              uint32_t unit, uint32_t prec)
 {
+  setTelemetryItemUpdated(this);
+
   int32_t newVal = val;
 
   if (prec == 255) {
@@ -157,14 +160,15 @@ void TelemetryItem::setValue(const TelemetrySensor &sensor, int32_t val,
   }
   else if (unit == UNIT_GPS_LATITUDE) {
 #if defined(INTERNAL_GPS)
-    if (gpsData.fix  && gpsData.hdop < PILOTPOS_MIN_HDOP) {
+    if (gpsData.fix && gpsData.hdop < PILOTPOS_MIN_HDOP &&
+        pilotLatitude != gpsData.latitude) {
       pilotLatitude = gpsData.latitude;
-      distFromEarthAxis = getDistFromEarthAxis(pilotLatitude);
+      pilotLongitudeScale = gpsLongitudeScale(pilotLatitude);
     }
 #endif
     if (!pilotLatitude) {
       pilotLatitude = newVal;
-      distFromEarthAxis = getDistFromEarthAxis(newVal);
+      pilotLongitudeScale = gpsLongitudeScale(newVal);
     }
     gps.latitude = newVal;
     setFresh();
@@ -269,6 +273,10 @@ void TelemetryItem::setValue(const TelemetrySensor &sensor, int32_t val,
 
   value = newVal;
   setFresh();
+
+  if (this >= telemetryItems && this < telemetryItems + MAX_TELEMETRY_SENSORS) {
+    telemetryHistoryAdd(this - telemetryItems, newVal);
+  }
 }
 
 void TelemetryItem::per10ms(const TelemetrySensor & sensor)
@@ -350,7 +358,7 @@ void TelemetryItem::eval(const TelemetrySensor & sensor)
 
     case TELEM_FORMULA_DIST:
       if (sensor.dist.gps) {
-        TelemetryItem gpsItem = telemetryItems[sensor.dist.gps-1];
+        TelemetryItem & gpsItem = telemetryItems[sensor.dist.gps-1];
         TelemetryItem * altItem = nullptr;
         if (!gpsItem.isAvailable()) {
           return;
@@ -369,19 +377,11 @@ void TelemetryItem::eval(const TelemetrySensor & sensor)
             return;
           }
         }
-        uint32_t angle = abs(gpsItem.gps.latitude - gpsItem.pilotLatitude);
-        uint32_t dist = uint64_t(EARTH_RADIUS * M_PI / 180) * angle / 1000000;
-        uint32_t result = dist * dist;
-
-        angle = abs(gpsItem.gps.longitude - gpsItem.pilotLongitude);
-        dist = uint64_t(gpsItem.distFromEarthAxis) * angle / 1000000;
-        result += dist * dist;
-
-        // Length on ground (ignoring curvature of the earth)
-        result = isqrt32(result);
-
+        uint32_t result = gpsDistance(gpsItem.gps.latitude - gpsItem.pilotLatitude,
+                                      gpsItem.gps.longitude - gpsItem.pilotLongitude,
+                                      gpsItem.pilotLongitudeScale);
         if (altItem) {
-          dist = convertTelemetryValue(abs(altItem->value), g_model.telemetrySensors[sensor.dist.alt-1].unit, g_model.telemetrySensors[sensor.dist.alt-1].prec, UNIT_METERS, 0);
+          uint32_t dist = convertTelemetryValue(abs(altItem->value), g_model.telemetrySensors[sensor.dist.alt-1].unit, g_model.telemetrySensors[sensor.dist.alt-1].prec, UNIT_METERS, 0);
           result = (dist * dist) + (result * result);
           result = isqrt32(result);
         }
@@ -471,7 +471,7 @@ void delTelemetryIndex(uint8_t index)
 {
   memclear(&g_model.telemetrySensors[index], sizeof(TelemetrySensor));
   telemetryItems[index].clear();
-  storageDirty(EE_MODEL);
+  storageConfigDirty(EE_MODEL);
 }
 
 int availableTelemetryIndex()
@@ -496,6 +496,241 @@ int lastUsedTelemetryIndex()
   return -1;
 }
 
+/*
+  Calculated sensors evaluation
+
+  The calculated sensors are evaluated in dependency order, so that a
+  sensor computed from another calculated sensor gets its value in the
+  same wakeup. A sensor is only evaluated when one of its inputs received
+  a value, or became old or unavailable, since the previous evaluation.
+
+  The order is rebuilt on first use after the model is loaded or edited.
+*/
+
+static uint8_t calculatedSensorsOrder[MAX_TELEMETRY_SENSORS];
+static uint8_t calculatedSensorsCount = 0;
+static bool calculatedSensorsOrderValid = false;
+
+// availability of the items during the previous evaluation
+static uint8_t telemetryItemsState[MAX_TELEMETRY_SENSORS];
+
+static inline uint8_t getTelemetryItemState(TelemetryItem & item)
+{
+  return item.isAvailable() ? (item.isOld() ? 1 : 2) : 0;
+}
+
+// TELEM_FORMULA_CONSUMPTION and TELEM_FORMULA_TOTALIZE are not
+// evaluated here, they are updated every 10ms and on each source value
+static inline bool isEvaluatedSensor(const TelemetrySensor & sensor)
+{
+  return sensor.type == TELEM_TYPE_CALCULATED &&
+         sensor.formula != TELEM_FORMULA_CONSUMPTION &&
+         sensor.formula != TELEM_FORMULA_TOTALIZE;
+}
+
+static uint8_t getCalculatedSensorInputs(const TelemetrySensor & sensor, uint8_t * inputs)
+{
+  uint8_t count = 0;
+
+  switch (sensor.formula) {
+    case TELEM_FORMULA_CELL:
+      if (sensor.cell.source)
+        inputs[count++] = sensor.cell.source - 1;
+      break;
+
+    case TELEM_FORMULA_DIST:
+      if (sensor.dist.gps)
+        inputs[count++] = sensor.dist.gps - 1;
+      if (sensor.dist.alt)
+        inputs[count++] = sensor.dist.alt - 1;
+      break;
+
+    case TELEM_FORMULA_ADD:
+    case TELEM_FORMULA_AVERAGE:
+    case TELEM_FORMULA_MIN:
+    case TELEM_FORMULA_MAX:
+    case TELEM_FORMULA_MULTIPLY:
+    {
+      int maxitems = (sensor.formula == TELEM_FORMULA_MULTIPLY ? 2 : 4);
+      for (int i = 0; i < maxitems; i++) {
+        int8_t source = sensor.calc.sources[i];
+        if (source)
+          inputs[count++] = abs(source) - 1;
+      }
+      break;
+    }
+
+    default:
+      break;
+  }
+
+  return count;
+}
+
+static void buildCalculatedSensorsOrder()
+{
+  // sensors already in the order, or not evaluated
+  bool placed[MAX_TELEMETRY_SENSORS];
+  for (int index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
+    placed[index] = !isEvaluatedSensor(g_model.telemetrySensors[index]);
+  }
+
+  calculatedSensorsCount = 0;
+
+  bool progress = true;
+  while (progress) {
+    progress = false;
+    for (int index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
+      if (placed[index])
+        continue;
+      uint8_t inputs[4];
+      uint8_t count = getCalculatedSensorInputs(g_model.telemetrySensors[index], inputs);
+      bool ready = true;
+      for (uint8_t i = 0; i < count; i++) {
+        if (inputs[i] < MAX_TELEMETRY_SENSORS && !placed[inputs[i]]) {
+          ready = false;
+          break;
+        }
+      }
+      if (ready) {
+        calculatedSensorsOrder[calculatedSensorsCount++] = index;
+        placed[index] = true;
+        progress = true;
+      }
+    }
+  }
+
+  // sensors in a dependency loop keep their index order
+  for (int index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
+    if (!placed[index]) {
+      calculatedSensorsOrder[calculatedSensorsCount++] = index;
+    }
+  }
+}
+
+void evalCalculatedSensors()
+{
+  if (!calculatedSensorsOrderValid) {
+    // mark as valid first, so that an edit
+    // happening while building triggers a rebuild
+    calculatedSensorsOrderValid = true;
+    buildCalculatedSensorsOrder();
+    // everything is evaluated once with the new configuration
+    memset(telemetryItemsUpdated, true, sizeof(telemetryItemsUpdated));
+  }
+
+  // values may be received during the evaluation, they will be
+  // taken into account on next wakeup
+  bool updated[MAX_TELEMETRY_SENSORS];
+  for (int index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
+    updated[index] = telemetryItemsUpdated[index];
+    telemetryItemsUpdated[index] = false;
+    uint8_t state = getTelemetryItemState(telemetryItems[index]);
+    if (state != telemetryItemsState[index]) {
+      telemetryItemsState[index] = state;
+      updated[index] = true;
+    }
+  }
+
+  for (uint8_t n = 0; n < calculatedSensorsCount; n++) {
+    uint8_t index = calculatedSensorsOrder[n];
+    const TelemetrySensor & sensor = g_model.telemetrySensors[index];
+    uint8_t inputs[4];
+    uint8_t count = getCalculatedSensorInputs(sensor, inputs);
+    bool changed = (count == 0);
+    for (uint8_t i = 0; i < count; i++) {
+      if (inputs[i] < MAX_TELEMETRY_SENSORS && updated[inputs[i]]) {
+        changed = true;
+        break;
+      }
+    }
+    if (changed) {
+      TelemetryItem & item = telemetryItems[index];
+      item.eval(sensor);
+      // the sensors computed from this one are further in the order
+      telemetryItemsUpdated[index] = false;
+      telemetryItemsState[index] = getTelemetryItemState(item);
+      updated[index] = true;
+    }
+  }
+}
+
+/*
+  Sensors lookup index
+
+  Open addressing table keyed by (id, subId), pointing to the first
+  custom sensor with this key. The other sensors sharing the same key
+  are chained in ascending order. The instance is checked on each
+  candidate, as its matching depends on the protocol.
+
+  The index is rebuilt on first use after the model is loaded or edited.
+*/
+
+#define SENSORS_INDEX_SIZE   128 // power of 2, > MAX_TELEMETRY_SENSORS
+#define SENSORS_INDEX_NONE   0xFF
+
+static_assert(SENSORS_INDEX_SIZE > MAX_TELEMETRY_SENSORS, "Sensors index too small");
+
+static uint8_t sensorsIndex[SENSORS_INDEX_SIZE]; // first sensor
+static uint8_t sensorsIndexNext[MAX_TELEMETRY_SENSORS]; // next sensor with the same key
+static bool sensorsIndexValid = false;
+
+void invalidateTelemetrySensorsIndex()
+{
+  sensorsIndexValid = false;
+  calculatedSensorsOrderValid = false;
+}
+
+static inline uint8_t getSensorsIndexHash(uint16_t id, uint8_t subId)
+{
+  // multiplicative hash, top 7 bits for 128 entries
+  uint32_t key = ((uint32_t)id << 8) | subId;
+  return (key * 2654435761u) >> (32 - 7);
+}
+
+static inline bool isSensorKey(uint8_t index, uint16_t id, uint8_t subId)
+{
+  const TelemetrySensor & sensor = g_model.telemetrySensors[index];
+  return sensor.type == TELEM_TYPE_CUSTOM && sensor.id == id && sensor.subId == subId;
+}
+
+// returns the index table entry for this key (empty if not found)
+static uint8_t & findSensorsIndexEntry(uint16_t id, uint8_t subId)
+{
+  uint8_t hash = getSensorsIndexHash(id, subId);
+  while (sensorsIndex[hash] != SENSORS_INDEX_NONE &&
+         !isSensorKey(sensorsIndex[hash], id, subId)) {
+    hash = (hash + 1) & (SENSORS_INDEX_SIZE - 1);
+  }
+  return sensorsIndex[hash];
+}
+
+static void buildSensorsIndex()
+{
+  memset(sensorsIndex, SENSORS_INDEX_NONE, sizeof(sensorsIndex));
+
+  // backwards, so that the chains are in ascending order
+  for (int index = MAX_TELEMETRY_SENSORS - 1; index >= 0; index--) {
+    const TelemetrySensor & sensor = g_model.telemetrySensors[index];
+    if (sensor.type == TELEM_TYPE_CUSTOM) {
+      uint8_t & entry = findSensorsIndexEntry(sensor.id, sensor.subId);
+      sensorsIndexNext[index] = entry;
+      entry = index;
+    }
+  }
+}
+
+static uint8_t getFirstSensor(uint16_t id, uint8_t subId)
+{
+  if (!sensorsIndexValid) {
+    // mark as valid first, so that an edit
+    // happening while building triggers a rebuild
+    sensorsIndexValid = true;
+    buildSensorsIndex();
+  }
+  return findSensorsIndexEntry(id, subId);
+}
+
 template <class T>
 int setTelemetryValue(TelemetryProtocol protocol, uint16_t id, uint8_t subId,
                       uint8_t instance, T value, uint32_t unit = 0,
@@ -503,14 +738,19 @@ int setTelemetryValue(TelemetryProtocol protocol, uint16_t id, uint8_t subId,
 {
   bool sensorFound = false;
 
-  for (int index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
+  for (uint8_t index = getFirstSensor(id, subId); index != SENSORS_INDEX_NONE;
+       index = sensorsIndexNext[index]) {
     TelemetrySensor &telemetrySensor = g_model.telemetrySensors[index];
 
-    if (telemetrySensor.type == TELEM_TYPE_CUSTOM && telemetrySensor.id == id &&
-        telemetrySensor.subId == subId &&
-        (telemetrySensor.isSameInstance(protocol, instance) ||
-         g_model.ignoreSensorIds)) {
+    // the index may be outdated if the sensors were changed
+    // without notification
+    if (!isSensorKey(index, id, subId)) {
+      invalidateTelemetrySensorsIndex();
+      break;
+    }
 
+    if (telemetrySensor.isSameInstance(protocol, instance) ||
+        g_model.ignoreSensorIds) {
       telemetryItems[index].setValue(telemetrySensor, value, unit, prec);
       sensorFound = true;
       // we continue search here, because sensors can share the same id and
@@ -518,6 +758,24 @@ int setTelemetryValue(TelemetryProtocol protocol, uint16_t id, uint8_t subId,
     }
   }
 
+  if (!sensorFound) {
+    // make sure that the index was not outdated before
+    // creating a new sensor or dropping the value: values without
+    // any sensor (e.g. a deleted one) still cost a full scan here
+    for (int index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
+      TelemetrySensor &telemetrySensor = g_model.telemetrySensors[index];
+      if (isSensorKey(index, id, subId) &&
+          (telemetrySensor.isSameInstance(protocol, instance) ||
+           g_model.ignoreSensorIds)) {
+        telemetryItems[index].setValue(telemetrySensor, value, unit, prec);
+        sensorFound = true;
+      }
+    }
+    if (sensorFound) {
+      invalidateTelemetrySensorsIndex();
+    }
+  }
+
   if (sensorFound || !allowNewSensors) {
     return -1;
   }
@@ -34,7 +34,7 @@ class TelemetryItem
   public:
     union {
       int32_t  value;           // value, stored as uint32_t but interpreted accordingly to type
-      uint32_t distFromEarthAxis;
+      uint32_t pilotLongitudeScale;  // see gpsLongitudeScale()
     };
 
     union {
@@ -74,7 +74,7 @@ class TelemetryItem
         int32_t longitude;
         // pilot longitude is stored in min
         // pilot latitude is stored in max
-        // distFromEarthAxis is stored in value
+        // pilotLongitudeScale is stored in value
       } gps;
       char text[TELEMETRY_SENSOR_TEXT_LENGTH];
     };
@@ -137,4 +137,11 @@ extern TelemetryItem telemetryItems[MAX_TELEMETRY_SENSORS];
 extern uint8_t allowNewSensors;
 bool isFaiForbidden(source_t idx);
 
+// Mark the sensors lookup index and the calculated sensors
+// order as outdated (sensors added, deleted or edited)
+void invalidateTelemetrySensorsIndex();
+
+// Evaluate the calculated sensors whose inputs changed
+void evalCalculatedSensors();
+
 #endif // _TELEMETRY_SENSORS_H_
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "opentx.h"
+#include "telemetry_stats.h"
+
+static TelemetryStats _telemetry_stats[NUM_MODULES];
+static volatile uint32_t _telemetry_frame_end[NUM_MODULES];
+
+static inline TelemetryStats * getStats(uint8_t module)
+{
+  return module < NUM_MODULES ? &_telemetry_stats[module] : nullptr;
+}
+
+void telemetryStatsBytes(uint8_t module, uint32_t count)
+{
+  auto stats = getStats(module);
+  if (stats) stats->bytes += count;
+}
+
+void telemetryStatsFrame(uint8_t module)
+{
+  auto stats = getStats(module);
+  if (stats) stats->frames++;
+}
+
+void telemetryStatsCrcError(uint8_t module)
+{
+  auto stats = getStats(module);
+  if (stats) stats->crcErrors++;
+}
+
+void telemetryStatsSizeError(uint8_t module)
+{
+  auto stats = getStats(module);
+  if (stats) stats->sizeErrors++;
+}
+
+void telemetryStatsOverrun(uint8_t module, uint32_t count)
+{
+  auto stats = getStats(module);
+  if (stats) stats->overruns += count;
+}
+
+void telemetryStatsFrameEnd_ISR(uint8_t module)
+{
+  if (module < NUM_MODULES) {
+    _telemetry_frame_end[module] = timersGetUsTick();
+  }
+}
+
+void telemetryStatsFrameDecoded(uint8_t module)
+{
+  auto stats = getStats(module);
+  if (!stats) return;
+
+  uint32_t latency = timersGetUsTick() - _telemetry_frame_end[module];
+  stats->lastLatency = min<uint32_t>(latency, UINT16_MAX);
+  if (stats->lastLatency > stats->maxLatency) {
+    stats->maxLatency = stats->lastLatency;
+  }
+}
+
+void telemetryStatsReset()
+{
+  memclear(_telemetry_stats, sizeof(_telemetry_stats));
+}
+
+void telemetryStatsGet(uint8_t module, TelemetryStats & stats)
+{
+  if (module < NUM_MODULES) {
+    stats = _telemetry_stats[module];
+  } else {
+    memclear(&stats, sizeof(stats));
+  }
+}
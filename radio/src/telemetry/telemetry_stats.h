@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+#include "dataconstants.h"
+
+// Per-module telemetry pipeline statistics, available in release builds.
+//
+// The counters tell apart a link on which the receiver sends less
+// (few frames, no errors) from one on which the radio drops or
+// mangles data (CRC / size errors, RX overruns).
+//
+// The latency is the time from the end of a frame, as signalled by
+// the serial IRQ, to the end of its decoding (i.e. after the sensors
+// have been updated). It is only available for frame-triggered
+// protocols (CRSF).
+
+struct TelemetryStats {
+  uint32_t frames;      // frames handed over to the decoder
+  uint32_t bytes;       // bytes received
+  uint16_t crcErrors;
+  uint16_t sizeErrors;  // oversize or undersize frames
+  uint16_t overruns;    // RX overruns (frames merged, bytes lost)
+  uint16_t lastLatency; // us
+  uint16_t maxLatency;  // us
+};
+
+void telemetryStatsBytes(uint8_t module, uint32_t count);
+void telemetryStatsFrame(uint8_t module);
+void telemetryStatsCrcError(uint8_t module);
+void telemetryStatsSizeError(uint8_t module);
+void telemetryStatsOverrun(uint8_t module, uint32_t count);
+
+// Records the end of a frame (IRQ context)
+void telemetryStatsFrameEnd_ISR(uint8_t module);
+
+// Records the end of the decoding of the last frame
+void telemetryStatsFrameDecoded(uint8_t module);
+
+void telemetryStatsReset();
+
+void telemetryStatsGet(uint8_t module, TelemetryStats & stats);
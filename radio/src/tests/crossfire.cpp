@@ -20,6 +20,7 @@
  */
 
 #include "gtests.h"
+#include "mixer_scheduler.h"
 
 #if defined(CROSSFIRE)
 uint8_t createCrossfireChannelsFrame(uint8_t * frame, int16_t * pulses);
@@ -44,5 +45,47 @@ TEST(Crossfire, crc8)
   uint8_t crc = crc8(&frame[2], frame[1]-1);
   ASSERT_EQ(frame[frame[1]+1], crc);
 }
+
+TEST(Crossfire, syncLagSpreadOverFrames)
+{
+  ModuleSyncStatus status;
+
+  // 1kHz link, 600us late
+  status.update(1000, 600);
+  EXPECT_TRUE(status.isValid());
+  EXPECT_EQ(status.getAdjustedRefreshRate(), 1250);
+  EXPECT_EQ(status.getAdjustedRefreshRate(), 1250);
+  EXPECT_EQ(status.getAdjustedRefreshRate(), 1100);
+  EXPECT_EQ(status.getAdjustedRefreshRate(), 1000);
+
+  // 150us early: limited by the minimum refresh rate
+  status.update(1000, -150);
+  EXPECT_EQ(status.getAdjustedRefreshRate(), MIN_REFRESH_RATE);
+  EXPECT_EQ(status.getAdjustedRefreshRate(), 1000);
+}
+
+TEST(Crossfire, syncPhaseOffset)
+{
+  ModuleSyncStatus status;
+
+  // locked 200us before the module's send point
+  status.setPhaseOffset(200);
+  status.update(1000, 200);
+  EXPECT_EQ(status.getAdjustedRefreshRate(), 1000);
+
+  status.update(1000, 0);
+  EXPECT_EQ(status.getAdjustedRefreshRate(), 850);
+  EXPECT_EQ(status.getAdjustedRefreshRate(), 950);
+  EXPECT_EQ(status.getAdjustedRefreshRate(), 1000);
+
+  // not further than half a period
+  status.setPhaseOffset(2000);
+  status.update(1000, 0);
+  EXPECT_EQ(status.getAdjustedRefreshRate(), 850);
+  EXPECT_EQ(status.getAdjustedRefreshRate(), 850);
+  EXPECT_EQ(status.getAdjustedRefreshRate(), 850);
+  EXPECT_EQ(status.getAdjustedRefreshRate(), 950);
+  EXPECT_EQ(status.getAdjustedRefreshRate(), 1000);
+}
 #endif
 
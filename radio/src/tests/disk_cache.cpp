@@ -0,0 +1,365 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+
+#if defined(DISK_CACHE)
+
+#include <vector>
+#include "disk_cache.h"
+
+#define SECTOR_SIZE   FF_MAX_SS
+#define BLOCK         DISK_CACHE_BLOCK_SECTORS
+#define DISK_BLOCKS   256
+
+struct DiskAccess {
+  DWORD sector;
+  UINT count;
+
+  bool operator==(const DiskAccess& other) const
+  {
+    return sector == other.sector && count == other.count;
+  }
+};
+
+// RAM disk recording the accesses which reach it
+static struct {
+  std::vector<uint8_t> data;
+  std::vector<DiskAccess> reads;
+  std::vector<DiskAccess> writes;
+  bool failWrites;
+  unsigned failNextWrites;
+} fakeDisk;
+
+static DRESULT fakeRead(BYTE, BYTE* buff, DWORD sector, UINT count)
+{
+  fakeDisk.reads.push_back({sector, count});
+  memcpy(buff, &fakeDisk.data[sector * SECTOR_SIZE], count * SECTOR_SIZE);
+  return RES_OK;
+}
+
+static DRESULT fakeWrite(BYTE, const BYTE* buff, DWORD sector, UINT count)
+{
+  if (fakeDisk.failWrites) return RES_ERROR;
+  if (fakeDisk.failNextWrites > 0) {
+    fakeDisk.failNextWrites--;
+    return RES_ERROR;
+  }
+  fakeDisk.writes.push_back({sector, count});
+  memcpy(&fakeDisk.data[sector * SECTOR_SIZE], buff, count * SECTOR_SIZE);
+  return RES_OK;
+}
+
+static DRESULT fakeIoctl(BYTE, BYTE cmd, void* buff)
+{
+  if (cmd == GET_SECTOR_COUNT) {
+    *(DWORD*)buff = DISK_BLOCKS * BLOCK;
+  }
+  return RES_OK;
+}
+
+static const diskio_driver_t fakeDriver = {
+  .initialize = nullptr,
+  .deinit = nullptr,
+  .status = nullptr,
+  .read = fakeRead,
+  .write = fakeWrite,
+  .ioctl = fakeIoctl,
+};
+
+// each sector is filled with its number + 'version'
+static void fillSector(uint8_t* buff, DWORD sector, uint8_t version = 0)
+{
+  memset(buff, sector + version, SECTOR_SIZE);
+  memcpy(buff, &sector, sizeof(sector));
+}
+
+static bool checkSector(const uint8_t* buff, DWORD sector, uint8_t version = 0)
+{
+  uint8_t expected[SECTOR_SIZE];
+  fillSector(expected, sector, version);
+  return !memcmp(buff, expected, SECTOR_SIZE);
+}
+
+class DiskCacheTest : public testing::Test
+{
+ protected:
+  DiskCache cache;
+  uint8_t buff[2 * BLOCK * SECTOR_SIZE];
+
+  void SetUp() override
+  {
+    fakeDisk.data.resize(DISK_BLOCKS * BLOCK * SECTOR_SIZE);
+    for (DWORD sector = 0; sector < DISK_BLOCKS * BLOCK; sector++) {
+      fillSector(&fakeDisk.data[sector * SECTOR_SIZE], sector);
+    }
+    fakeDisk.reads.clear();
+    fakeDisk.writes.clear();
+    fakeDisk.failWrites = false;
+    fakeDisk.failNextWrites = 0;
+    cache.initialize(&fakeDriver);
+  }
+
+  DRESULT readBlock(DWORD blockNo)
+  {
+    return cache.read(0, buff, blockNo * BLOCK, 1);
+  }
+
+  void readOtherBlocks(DWORD count)
+  {
+    for (DWORD i = 0; i < count; i++) {
+      EXPECT_EQ(RES_OK, readBlock(40 + 2 * i));
+    }
+  }
+
+  bool isCached(DWORD blockNo)
+  {
+    auto misses = cache.getStats().noMisses;
+    readBlock(blockNo);
+    return cache.getStats().noMisses == misses;
+  }
+
+  DRESULT writeSectors(DWORD sector, UINT count, uint8_t version)
+  {
+    for (UINT i = 0; i < count; i++) {
+      fillSector(&buff[i * SECTOR_SIZE], sector + i, version);
+    }
+    return cache.write(0, buff, sector, count);
+  }
+
+  bool diskSector(DWORD sector, uint8_t version)
+  {
+    return checkSector(&fakeDisk.data[sector * SECTOR_SIZE], sector, version);
+  }
+};
+
+TEST_F(DiskCacheTest, hitsAndMisses)
+{
+  ASSERT_EQ(RES_OK, cache.read(0, buff, 3, 1));
+  EXPECT_TRUE(checkSector(buff, 3));
+  ASSERT_EQ(RES_OK, cache.read(0, buff, 5, 2));
+  EXPECT_TRUE(checkSector(buff, 5));
+  EXPECT_TRUE(checkSector(buff + SECTOR_SIZE, 6));
+
+  // the whole block is read once
+  EXPECT_EQ(1u, cache.getStats().noMisses);
+  EXPECT_EQ(1u, cache.getStats().noHits);
+  EXPECT_EQ(500, cache.getHitRate());
+  ASSERT_EQ(1u, fakeDisk.reads.size());
+  EXPECT_EQ((DiskAccess{0, BLOCK}), fakeDisk.reads[0]);
+}
+
+TEST_F(DiskCacheTest, promotion)
+{
+  // block 1 read again later goes to Am, block 3 (read twice in a row,
+  // like a file read sequentially) and block 5 stay in A1
+  readBlock(1);
+  cache.read(0, buff, 3 * BLOCK, 1);
+  cache.read(0, buff, 3 * BLOCK + 1, 1);
+  readBlock(5);
+  readBlock(1);
+  EXPECT_EQ(2u, cache.getStats().noHits);
+
+  // the A1 blocks are evicted first
+  readOtherBlocks(DISK_CACHE_BLOCKS_NUM);
+  EXPECT_TRUE(isCached(1));
+  EXPECT_FALSE(isCached(3));
+  EXPECT_FALSE(isCached(5));
+}
+
+TEST_F(DiskCacheTest, sequentialReads)
+{
+  // only the blocks being read reach the disk
+  readBlock(20);
+  readBlock(21);
+  readBlock(22);
+  EXPECT_TRUE(checkSector(buff, 22 * BLOCK));
+  EXPECT_EQ(3u, cache.getStats().noMisses);
+
+  ASSERT_EQ(3u, fakeDisk.reads.size());
+  EXPECT_EQ((DiskAccess{22 * BLOCK, BLOCK}), fakeDisk.reads[2]);
+}
+
+TEST_F(DiskCacheTest, readSpanningBlocks)
+{
+  ASSERT_EQ(RES_OK, cache.read(0, buff, BLOCK - 2, 4));
+  for (int i = 0; i < 4; i++) {
+    EXPECT_TRUE(checkSector(buff + i * SECTOR_SIZE, BLOCK - 2 + i));
+  }
+  EXPECT_EQ(2u, cache.getStats().noMisses);
+
+  ASSERT_EQ(RES_OK, cache.read(0, buff, BLOCK - 1, 2));
+  EXPECT_TRUE(checkSector(buff, BLOCK - 1));
+  EXPECT_TRUE(checkSector(buff + SECTOR_SIZE, BLOCK));
+  EXPECT_EQ(2u, cache.getStats().noHits);
+}
+
+TEST_F(DiskCacheTest, writeUpdatesCache)
+{
+  readBlock(0);
+  ASSERT_EQ(RES_OK, writeSectors(3, 1, 1));
+  ASSERT_EQ(RES_OK, cache.read(0, buff, 3, 1));
+  EXPECT_TRUE(checkSector(buff, 3, 1));
+
+  // sectors which are not cached are written at once
+  ASSERT_EQ(RES_OK, writeSectors(10 * BLOCK, 2, 1));
+  EXPECT_TRUE(diskSector(10 * BLOCK + 1, 1));
+  EXPECT_FALSE(isCached(10));
+}
+
+TEST_F(DiskCacheTest, failedWrite)
+{
+  // block 2 in Am, block 0 in A1
+  readBlock(2);
+  readBlock(0);
+  readBlock(2);
+
+  // block 0 is invalidated, but stays in its queue
+  fakeDisk.failWrites = true;
+  EXPECT_NE(RES_OK, writeSectors(BLOCK - 1, 2, 1));
+  fakeDisk.failWrites = false;
+  EXPECT_FALSE(diskSector(BLOCK - 1, 1));
+
+  // so that it is reused without breaking the other blocks
+  EXPECT_FALSE(isCached(0));
+  EXPECT_TRUE(checkSector(buff, 0));
+  readOtherBlocks(2 * DISK_CACHE_BLOCKS_NUM);
+  EXPECT_TRUE(isCached(2));
+  EXPECT_TRUE(checkSector(buff, 2 * BLOCK));
+}
+
+#if defined(DISK_CACHE_WRITE_BACK)
+TEST_F(DiskCacheTest, writeBackOnSync)
+{
+  readBlock(0);
+  ASSERT_EQ(RES_OK, writeSectors(8, 2, 1));
+  ASSERT_EQ(RES_OK, writeSectors(3, 1, 1));
+  ASSERT_EQ(RES_OK, writeSectors(1, 1, 1));
+  EXPECT_EQ(3u, cache.getStats().noWriteBacks);
+  EXPECT_TRUE(fakeDisk.writes.empty());
+  EXPECT_TRUE(diskSector(3, 0));
+
+  ASSERT_EQ(RES_OK, cache.read(0, buff, 3, 1));
+  EXPECT_TRUE(checkSector(buff, 3, 1));
+
+  // in sectors order, contiguous sectors at once
+  ASSERT_EQ(RES_OK, cache.ioctl(0, CTRL_SYNC, nullptr));
+  ASSERT_EQ(3u, fakeDisk.writes.size());
+  EXPECT_EQ((DiskAccess{1, 1}), fakeDisk.writes[0]);
+  EXPECT_EQ((DiskAccess{3, 1}), fakeDisk.writes[1]);
+  EXPECT_EQ((DiskAccess{8, 2}), fakeDisk.writes[2]);
+  EXPECT_TRUE(diskSector(1, 1));
+  EXPECT_TRUE(diskSector(9, 1));
+
+  // nothing left to write
+  ASSERT_EQ(RES_OK, cache.ioctl(0, CTRL_SYNC, nullptr));
+  EXPECT_EQ(3u, fakeDisk.writes.size());
+}
+
+TEST_F(DiskCacheTest, writeBackOnEviction)
+{
+  readBlock(1);
+  ASSERT_EQ(RES_OK, writeSectors(BLOCK + 2, 1, 1));
+  EXPECT_TRUE(fakeDisk.writes.empty());
+
+  readOtherBlocks(DISK_CACHE_BLOCKS_NUM);
+  ASSERT_EQ(1u, fakeDisk.writes.size());
+  EXPECT_EQ((DiskAccess{BLOCK + 2, 1}), fakeDisk.writes[0]);
+  EXPECT_TRUE(diskSector(BLOCK + 2, 1));
+}
+
+TEST_F(DiskCacheTest, writeBackPartiallyCached)
+{
+  // block 1 is not cached: the whole write goes to the disk
+  readBlock(0);
+  ASSERT_EQ(RES_OK, writeSectors(BLOCK - 1, 2, 1));
+  EXPECT_EQ(0u, cache.getStats().noWriteBacks);
+  EXPECT_TRUE(diskSector(BLOCK - 1, 1));
+  EXPECT_TRUE(diskSector(BLOCK, 1));
+
+  ASSERT_EQ(RES_OK, cache.read(0, buff, BLOCK - 1, 1));
+  EXPECT_TRUE(checkSector(buff, BLOCK - 1, 1));
+  ASSERT_EQ(RES_OK, cache.ioctl(0, CTRL_SYNC, nullptr));
+  EXPECT_EQ(1u, fakeDisk.writes.size());
+}
+
+TEST_F(DiskCacheTest, bigReadWithDelayedWrites)
+{
+  readBlock(1);
+  ASSERT_EQ(RES_OK, writeSectors(BLOCK + 4, 1, 1));
+
+  // read from the disk, then patched with the delayed sectors
+  ASSERT_EQ(RES_OK, cache.read(0, buff, 0, 2 * BLOCK));
+  EXPECT_EQ((DiskAccess{0, 2 * BLOCK}), fakeDisk.reads.back());
+  EXPECT_TRUE(checkSector(buff + 3 * SECTOR_SIZE, 3));
+  EXPECT_TRUE(checkSector(buff + (BLOCK + 4) * SECTOR_SIZE, BLOCK + 4, 1));
+  EXPECT_TRUE(checkSector(buff + (BLOCK + 5) * SECTOR_SIZE, BLOCK + 5));
+}
+
+TEST_F(DiskCacheTest, failedWriteKeepsDelayedWrites)
+{
+  readBlock(0);
+  ASSERT_EQ(RES_OK, writeSectors(2, 1, 1));
+
+  // the write fails, the delayed sector of the same block is still written
+  fakeDisk.failNextWrites = 1;
+  EXPECT_NE(RES_OK, writeSectors(BLOCK - 1, 2, 1));
+  ASSERT_EQ(1u, fakeDisk.writes.size());
+  EXPECT_EQ((DiskAccess{2, 1}), fakeDisk.writes[0]);
+  EXPECT_TRUE(diskSector(2, 1));
+  EXPECT_FALSE(isCached(0));
+}
+
+TEST_F(DiskCacheTest, failedWriteAndWriteBack)
+{
+  readBlock(0);
+  ASSERT_EQ(RES_OK, writeSectors(2, 1, 1));
+
+  // nothing can be written: the block keeps the failed sector as well
+  fakeDisk.failWrites = true;
+  EXPECT_NE(RES_OK, writeSectors(BLOCK - 1, 2, 1));
+  fakeDisk.failWrites = false;
+  EXPECT_TRUE(isCached(0));
+
+  ASSERT_EQ(RES_OK, cache.ioctl(0, CTRL_SYNC, nullptr));
+  EXPECT_TRUE(diskSector(2, 1));
+  EXPECT_TRUE(diskSector(BLOCK - 1, 1));
+  EXPECT_FALSE(diskSector(BLOCK, 1));
+}
+
+TEST_F(DiskCacheTest, failedWriteBackOnEviction)
+{
+  readBlock(1);
+  ASSERT_EQ(RES_OK, writeSectors(BLOCK + 2, 1, 1));
+
+  // block 1 can't be written back: the misses use the other blocks
+  fakeDisk.failWrites = true;
+  readOtherBlocks(2 * DISK_CACHE_BLOCKS_NUM);
+  fakeDisk.failWrites = false;
+  EXPECT_TRUE(isCached(1));
+  EXPECT_TRUE(checkSector(buff, BLOCK));
+
+  ASSERT_EQ(RES_OK, cache.ioctl(0, CTRL_SYNC, nullptr));
+  EXPECT_TRUE(diskSector(BLOCK + 2, 1));
+}
+#endif
+
+#endif
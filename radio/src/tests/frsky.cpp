@@ -20,6 +20,7 @@
  */
 
 #include "gtests.h"
+#include "telemetry/telemetry_stats.h"
 
 void frskyDProcessPacket(const uint8_t *packet);
 bool checkSportPacket(const uint8_t *packet);
@@ -154,6 +155,39 @@ TEST(FrSkySPORT, checkCrc)
   EXPECT_EQ(checkSportPacket(pkt2+1), true);
 }
 
+TEST(FrSkySPORT, telemetryStats)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStatsReset();
+
+  const uint8_t good[] = { 0x7E, 0x1C, 0x31, 0x00, 0x10, 0x85, 0x64, 0x00, 0x00, 0xD4 };
+  const uint8_t bad[] = { 0x7E, 0x1C, 0x31, 0x00, 0x10, 0x85, 0x64, 0x00, 0x00, 0xD5 };
+
+  uint8_t buffer[TELEMETRY_RX_PACKET_SIZE];
+  uint8_t len = 0;
+  for (auto packet: { good, bad, good }) {
+    for (unsigned i = 0; i < sizeof(good); i++) {
+      processFrskySportTelemetryData(EXTERNAL_MODULE, packet[i], buffer, len);
+    }
+  }
+
+  TelemetryStats stats;
+  telemetryStatsGet(EXTERNAL_MODULE, stats);
+  EXPECT_EQ(stats.frames, 3u);
+  EXPECT_EQ(stats.crcErrors, 1);
+  EXPECT_EQ(stats.sizeErrors, 0);
+
+  telemetryStatsGet(INTERNAL_MODULE, stats);
+  EXPECT_EQ(stats.frames, 0u);
+  EXPECT_EQ(stats.crcErrors, 0);
+
+  telemetryStatsReset();
+  telemetryStatsGet(EXTERNAL_MODULE, stats);
+  EXPECT_EQ(stats.frames, 0u);
+  EXPECT_EQ(stats.crcErrors, 0);
+}
+
 void setSportPacketCrc(uint8_t * packet)
 {
   short crc = 0;
@@ -451,6 +485,60 @@ TEST(FrSkySPORT, frskyVfas)
   EXPECT_EQ(telemetryItems[0].valueMax, 6524);
 }
 
+TEST(FrSkySPORT, calculatedSensorsChain)
+{
+  uint8_t packet[FRSKY_SPORT_PACKET_SIZE];
+
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  telemetryData.telemetryValid = 0x07;
+  allowNewSensors = true;
+
+  generateSportFasVoltagePacket(packet, 1000);
+  sportProcessTelemetryPacket(0, packet, sizeof(packet));
+
+  // sensor 1 is computed from sensor 2, itself computed from Vfas
+  TelemetrySensor & max = g_model.telemetrySensors[1];
+  max.type = TELEM_TYPE_CALCULATED;
+  max.formula = TELEM_FORMULA_MAX;
+  max.unit = UNIT_VOLTS;
+  max.prec = 2;
+  max.calc.sources[0] = 3;
+  TelemetrySensor & add = g_model.telemetrySensors[2];
+  add.type = TELEM_TYPE_CALCULATED;
+  add.formula = TELEM_FORMULA_ADD;
+  add.unit = UNIT_VOLTS;
+  add.prec = 2;
+  add.calc.sources[0] = 1;
+  add.calc.sources[1] = 1;
+  storageConfigDirty(EE_MODEL);
+
+  // the whole chain is evaluated in one wakeup
+  telemetryWakeup();
+  EXPECT_EQ(telemetryItems[2].value, 2000);
+  EXPECT_EQ(telemetryItems[1].value, 2000);
+
+  // no new value, nothing is evaluated
+  telemetryItems[1].value = 0;
+  telemetryItems[2].value = 0;
+  telemetryWakeup();
+  EXPECT_EQ(telemetryItems[2].value, 0);
+  EXPECT_EQ(telemetryItems[1].value, 0);
+
+  generateSportFasVoltagePacket(packet, 1100);
+  sportProcessTelemetryPacket(0, packet, sizeof(packet));
+  telemetryWakeup();
+  EXPECT_EQ(telemetryItems[2].value, 2200);
+  EXPECT_EQ(telemetryItems[1].value, 2200);
+
+  // Vfas lost
+  telemetryItems[0].setOld();
+  telemetryWakeup();
+  EXPECT_TRUE(telemetryItems[2].isOld());
+  EXPECT_TRUE(telemetryItems[1].isOld());
+}
+
 void generateSportFasCurrentPacket(uint8_t * packet, uint32_t current)
 {
   packet[0] = 0x22; //DATA_ID_FAS
@@ -530,3 +618,181 @@ TEST(FrSkySPORT, frskyCurrent)
   EXPECT_EQ(telemetryItems[0].valueMax, 505);
 }
 
+
+void generateSportPacket(uint8_t * packet, uint8_t physicalId, uint16_t dataId, uint32_t data)
+{
+  packet[0] = physicalId;
+  packet[1] = 0x10; //DATA_FRAME
+  *((uint16_t *)(packet+2)) = dataId;
+  *((int32_t *)(packet+4)) = data;
+  setSportPacketCrc(packet);
+}
+
+TEST(FrSkySPORT, blockDecoding)
+{
+  // values with bytes to be stuffed
+  const uint32_t values[] = { 0x7E, 0x7D7E, 1234, 0x7D };
+
+  uint8_t stream[4 * (2 * FRSKY_SPORT_PACKET_SIZE + 1)];
+  uint8_t size = 0;
+  for (uint8_t i = 0; i < DIM(values); i++) {
+    uint8_t packet[FRSKY_SPORT_PACKET_SIZE];
+    generateSportPacket(packet, 0x1B, DIY_FIRST_ID + i, values[i]);
+    stream[size++] = START_STOP;
+    for (auto data: packet) {
+      if (data == START_STOP || data == BYTE_STUFF) {
+        stream[size++] = BYTE_STUFF;
+        stream[size++] = data ^ STUFF_MASK;
+      }
+      else {
+        stream[size++] = data;
+      }
+    }
+  }
+
+  // the result does not depend on how the stream is split
+  uint8_t buffer[TELEMETRY_RX_PACKET_SIZE];
+  for (uint8_t chunk = 1; chunk <= size; chunk++) {
+    MODEL_RESET();
+    TELEMETRY_RESET();
+    telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+    telemetryData.telemetryValid = 0x07;
+    allowNewSensors = true;
+
+    uint8_t len = 0;
+    for (int i = 0; i < size; i += chunk) {
+      processFrskySportTelemetryData(0, stream + i, min<int>(chunk, size - i), buffer, len);
+    }
+
+    EXPECT_EQ(lastUsedTelemetryIndex() + 1, (int)DIM(values)) << "chunk " << (int)chunk;
+    for (uint8_t i = 0; i < DIM(values); i++) {
+      EXPECT_EQ(telemetryItems[i].value, (int32_t)values[i]) << "chunk " << (int)chunk;
+    }
+  }
+}
+
+// 16 sensor types, each sent by 2 sensors with their own dataId
+static const uint16_t sportStreamIds[] = {
+  ALT_FIRST_ID, VARIO_FIRST_ID, CURR_FIRST_ID, VFAS_FIRST_ID,
+  T1_FIRST_ID, T2_FIRST_ID, RPM_FIRST_ID, FUEL_FIRST_ID,
+  ACCX_FIRST_ID, ACCY_FIRST_ID, ACCZ_FIRST_ID, GPS_ALT_FIRST_ID,
+  GPS_SPEED_FIRST_ID, A3_FIRST_ID, AIR_SPEED_FIRST_ID,
+  ESC_TEMPERATURE_FIRST_ID,
+};
+static const uint8_t sportStreamPhysicalIds[] = { 0x22, 0x83 };
+#define SPORT_STREAM_PACKETS (DIM(sportStreamPhysicalIds) * DIM(sportStreamIds))
+
+static void sendSportStream(uint32_t data, uint16_t idOffset = 0)
+{
+  uint8_t packet[FRSKY_SPORT_PACKET_SIZE];
+  for (uint8_t n = 0; n < DIM(sportStreamPhysicalIds); n++) {
+    for (auto id: sportStreamIds) {
+      generateSportPacket(packet, sportStreamPhysicalIds[n], id + idOffset + n, data);
+      sportProcessTelemetryPacket(0, packet, sizeof(packet));
+    }
+  }
+}
+
+static void startSportStream()
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  telemetryData.telemetryValid = 0x07;
+  allowNewSensors = true;
+
+  // sensors discovery
+  sendSportStream(100);
+}
+
+TEST(FrSkySPORT, sensorsStream)
+{
+  startSportStream();
+  int count = lastUsedTelemetryIndex() + 1;
+  EXPECT_EQ(count, (int)SPORT_STREAM_PACKETS);
+
+  const int rounds = 10;
+  for (int i = 0; i < rounds; i++) {
+    sendSportStream(i);
+  }
+
+  // no duplicate sensor created, all values updated
+  EXPECT_EQ(lastUsedTelemetryIndex() + 1, count);
+  for (int i = 0; i < count; i++) {
+    EXPECT_EQ(g_model.telemetrySensors[i].id,
+              sportStreamIds[i % DIM(sportStreamIds)] + i / DIM(sportStreamIds));
+    EXPECT_TRUE(telemetryItems[i].isFresh());
+  }
+
+  // a deleted sensor is discovered again
+  delTelemetryIndex(3);
+  sendSportStream(rounds);
+  EXPECT_EQ(g_model.telemetrySensors[3].id, sportStreamIds[3]);
+  EXPECT_EQ(lastUsedTelemetryIndex() + 1, count);
+}
+
+TEST(FrSkySPORT, DISABLED_sensorsStreamBenchmark)
+{
+  startSportStream();
+  const unsigned rounds = 1000;
+  uint32_t data = 0;
+
+  double ns = benchmarkNs(rounds, [&]() { sendSportStream(data++); });
+  printf("S.Port stream: %.1f ns/packet (%d sensors)\n",
+         ns / SPORT_STREAM_PACKETS, lastUsedTelemetryIndex() + 1);
+
+  // values without a sensor still go through a full scan of the sensors
+  allowNewSensors = false;
+  ns = benchmarkNs(rounds, [&]() { sendSportStream(data++, 2); });
+  printf("S.Port stream, unknown sensors: %.1f ns/packet\n",
+         ns / SPORT_STREAM_PACKETS);
+  allowNewSensors = true;
+}
+
+TEST(FrSkySPORT, sensorsDescriptors)
+{
+  struct {
+    uint16_t id;
+    uint8_t subId;
+    TelemetryUnit unit;
+  } const descriptors[] = {
+    { ALT_FIRST_ID, 0, UNIT_METERS },
+    { VARIO_LAST_ID, 0, UNIT_METERS_PER_SECOND },
+    { ANGLE_FIRST_ID + 2, 0, UNIT_DEGREE },
+    { GPS_LONG_LATI_FIRST_ID, 0, UNIT_GPS },
+    { RBOX_BATT2_FIRST_ID + 1, 1, UNIT_AMPS },
+    { RBOX_STATE_FIRST_ID, 0, UNIT_TEXT },
+    { RBOX_STATE_LAST_ID, 1, UNIT_TEXT },
+    { ESC_RPM_CONS_FIRST_ID, 1, UNIT_MAH },
+    { SERVO_FIRST_ID, 0, UNIT_AMPS },
+    { SERVO_FIRST_ID + 4, 2, UNIT_CELSIUS },
+    { SERVO_LAST_ID, 3, UNIT_TEXT },
+    { VALID_FRAME_RATE_ID, 0, UNIT_PERCENT },
+    { R9_PWR_ID, 0, UNIT_MILLIWATTS },
+#if defined(MULTIMODULE)
+    { TX_RSSI_ID, 0, UNIT_DB },
+#endif
+  };
+
+  MODEL_RESET();
+  TELEMETRY_RESET();
+
+  for (auto & descriptor: descriptors) {
+    frskySportSetDefault(0, descriptor.id, descriptor.subId, 0);
+    EXPECT_EQ(g_model.telemetrySensors[0].unit, descriptor.unit);
+  }
+
+  // unknown ids and subIds get a generic raw sensor
+  const uint16_t unknown[][2] = {
+    { ALT_FIRST_ID, 1 },
+    { ANGLE_FIRST_ID, 2 },
+    { 0x0120, 0 },
+    { DIY_FIRST_ID, 0 },
+    { SERVO_LAST_ID + 1, 0 },
+    { 0xFFFF, 0 },
+  };
+  for (auto & sensor: unknown) {
+    frskySportSetDefault(0, sensor[0], sensor[1], 0);
+    EXPECT_EQ(g_model.telemetrySensors[0].unit, UNIT_RAW);
+  }
+}
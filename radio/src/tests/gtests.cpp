@@ -27,6 +27,10 @@
 #include "gtests.h"
 #include "hal/adc_driver.h"
 
+#if defined(MODEL_SNAPSHOTS)
+  #include "storage/model_snapshot.h"
+#endif
+
 using ::testing::TestEventListener;
 using ::testing::EmptyTestEventListener;
 using ::testing::Test;
@@ -155,6 +159,9 @@ int main(int argc, char **argv)
   QCoreApplication app(argc, argv);
   simuInit();
   adcInit(&simu_adc_driver);
+#if defined(MODEL_SNAPSHOTS)
+  modelSnapshotsEnabled = true;
+#endif
 
 #if !defined(COLORLCD)
   menuLevel = 0;
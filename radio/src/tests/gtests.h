@@ -24,6 +24,7 @@
 
 #include <QtCore/QString>
 #include <math.h>
+#include <chrono>
 #include <gtest/gtest.h>
 
 #define SWAP_DEFINED
@@ -47,6 +48,20 @@ extern const char * nchar2string(const char * string, int size);
 #define EXPECT_ZSTREQ(c_string, z_string)   EXPECT_STREQ(c_string, zchar2string(z_string, sizeof(z_string)))
 #define EXPECT_STRNEQ(c_string, n_string)   EXPECT_STREQ(c_string, nchar2string(n_string, sizeof(n_string)))
 
+// Average duration of f() in ns, for the benchmarks. These are disabled
+// by default (DISABLED_ prefix) and run with:
+//   gtests-radio --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'
+template <class F>
+double benchmarkNs(unsigned count, F f)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned n = 0; n < count; n++) {
+    f();
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / count;
+}
+
 #if defined(PCBFRSKY)
 #define RADIO_RESET() \
   g_eeGeneral.switchConfig = 0x00007bff
@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+
+#if defined(SDCARD)
+
+#include "location.h"
+#include "logs_binary.h"
+#include "logs_capture.h"
+
+TEST(Logs, convertPeriod)
+{
+  // 100ms steps for CSV, 10ms steps for the binary formats
+  EXPECT_EQ(100, logsConvertPeriod(10, LOGS_FORMAT_CSV, LOGS_FORMAT_BINARY));
+  EXPECT_EQ(255, logsConvertPeriod(30, LOGS_FORMAT_CSV, LOGS_FORMAT_CAPTURE));
+  EXPECT_EQ(10, logsConvertPeriod(100, LOGS_FORMAT_BINARY, LOGS_FORMAT_CSV));
+  EXPECT_EQ(1, logsConvertPeriod(5, LOGS_FORMAT_CAPTURE, LOGS_FORMAT_CSV));
+  EXPECT_EQ(20, logsConvertPeriod(20, LOGS_FORMAT_BINARY, LOGS_FORMAT_CAPTURE));
+  EXPECT_EQ(20, logsConvertPeriod(20, LOGS_FORMAT_CSV, LOGS_FORMAT_CSV));
+}
+
+static void setLogsSensor(uint8_t index, const char * label, uint8_t unit,
+                          uint8_t prec)
+{
+  TelemetrySensor & sensor = g_model.telemetrySensors[index];
+  strncpy(sensor.label, label, TELEM_LABEL_LEN);
+  sensor.unit = unit;
+  sensor.prec = prec;
+  sensor.logs = 1;
+}
+
+TEST_F(OpenTxTest, binaryLog)
+{
+  static_assert(sizeof(LogsBinaryHeader) == 20, "LogsBinaryHeader layout");
+  static_assert(sizeof(LogsBinaryColumn) == LOGS_BINARY_NAME_LEN + 4,
+                "LogsBinaryColumn layout");
+
+  simuFatfsSetPaths(TESTS_BUILD_PATH "/", TESTS_BUILD_PATH "/");
+  sdCheckAndCreateDirectory(LOGS_PATH);
+
+  TELEMETRY_RESET();
+  setLogsSensor(0, "Alt", UNIT_METERS, 1);
+  telemetryItems[0].value = 1234;
+  setLogsSensor(1, "GPS", UNIT_GPS, 0);
+  telemetryItems[1].gps.latitude = 47500000;
+  telemetryItems[1].gps.longitude = -8250000;
+  setLogsSensor(2, "Tmp", UNIT_CELSIUS, 0);
+  g_model.telemetrySensors[2].logs = 0;
+  channelOutputs[0] = 512;
+  g_vbat100mV = 82;
+
+  const char * path = LOGS_PATH "/binary.etxl";
+  f_unlink(path);
+  ASSERT_EQ(FR_OK, f_open(&g_oLogFile, path, FA_CREATE_NEW | FA_WRITE));
+  ASSERT_TRUE(logsBinaryOpen(100));
+  logsBinaryWrite();
+  logsBinaryWrite();
+  logsBinaryClose();
+  f_close(&g_oLogFile);
+
+  FIL file;
+  UINT count;
+  ASSERT_EQ(FR_OK, f_open(&file, path, FA_READ));
+
+  LogsBinaryHeader header;
+  ASSERT_EQ(FR_OK, f_read(&file, &header, sizeof(header), &count));
+  EXPECT_EQ(0, memcmp(header.magic, LOGS_BINARY_MAGIC, sizeof(header.magic)));
+  EXPECT_EQ(LOGS_BINARY_VERSION, header.version);
+  EXPECT_EQ(0, header.headerSize % LOGS_BINARY_SECTOR_SIZE);
+  EXPECT_GE(header.headerSize,
+            sizeof(header) + header.columnsCount * sizeof(LogsBinaryColumn));
+  EXPECT_EQ(100u, header.period);
+
+  // sensors first (if logged), TX voltage last
+  uint32_t recordSize = sizeof(uint32_t);
+  int channel = -1;
+  std::vector<LogsBinaryColumn> columns(header.columnsCount);
+  for (auto & column : columns) {
+    ASSERT_EQ(FR_OK, f_read(&file, &column, sizeof(column), &count));
+    EXPECT_STRNE("Tmp(C)", column.name);
+    if (!strcmp(column.name, "CH1(us)")) channel = recordSize;
+    recordSize += column.size;
+  }
+  EXPECT_EQ(recordSize, header.recordSize);
+  ASSERT_GE(channel, 0);
+
+  EXPECT_STREQ("Alt(m)", columns[0].name);
+  EXPECT_EQ(LOGS_COLUMN_VALUE, columns[0].type);
+  EXPECT_EQ(1, columns[0].prec);
+  EXPECT_EQ(4, columns[0].size);
+  EXPECT_STREQ("GPS", columns[1].name);
+  EXPECT_EQ(LOGS_COLUMN_GPS, columns[1].type);
+  EXPECT_EQ(6, columns[1].prec);
+  EXPECT_EQ(8, columns[1].size);
+  const LogsBinaryColumn & last = columns.back();
+  EXPECT_STREQ("TxBat(V)", last.name);
+  EXPECT_EQ(1, last.prec);
+
+  // 2 records, starting on a sector boundary
+  EXPECT_EQ(header.headerSize + 2u * header.recordSize, f_size(&file));
+
+  std::vector<uint8_t> record(header.recordSize);
+  f_lseek(&file, header.headerSize);
+  ASSERT_EQ(FR_OK, f_read(&file, record.data(), record.size(), &count));
+  ASSERT_EQ(record.size(), count);
+  f_close(&file);
+
+  int32_t values[3];
+  memcpy(values, &record[4], sizeof(values));
+  EXPECT_EQ(1234, values[0]);
+  EXPECT_EQ(47500000, values[1]);
+  EXPECT_EQ(-8250000, values[2]);
+  memcpy(values, &record[channel], sizeof(int32_t));
+  EXPECT_EQ(PPM_CENTER + 256, values[0]);
+  memcpy(values, &record[header.recordSize - 4], sizeof(int32_t));
+  EXPECT_EQ(82, values[0]);
+
+  simuFatfsSetPaths("", "");
+}
+
+TEST_F(OpenTxTest, captureLog)
+{
+  static_assert(sizeof(LogsCaptureHeader) == 12 + 4 * LOGS_CAPTURE_MODULES,
+                "LogsCaptureHeader layout");
+  static_assert(sizeof(LogsCaptureRecord) == 8, "LogsCaptureRecord layout");
+
+  simuFatfsSetPaths(TESTS_BUILD_PATH "/", TESTS_BUILD_PATH "/");
+  sdCheckAndCreateDirectory(LOGS_PATH);
+
+  g_model.moduleData[0].type = MODULE_TYPE_PPM;
+  g_model.moduleData[0].subType = 1;
+  channelOutputs[0] = -300;
+
+  const char * path = LOGS_PATH "/capture.etxr";
+  f_unlink(path);
+  ASSERT_EQ(FR_OK, f_open(&g_oLogFile, path, FA_CREATE_NEW | FA_WRITE));
+  ASSERT_TRUE(logsCaptureOpen());
+  const uint8_t frame[] = {0x7E, 0x10, 0x42};
+  LOGS_CAPTURE_TELEMETRY(0, LOGS_CAPTURE_FRAME, frame, sizeof(frame));
+  logsCaptureChannels();
+  logsCaptureClose();
+  f_close(&g_oLogFile);
+  EXPECT_FALSE(logsCapturing);
+
+  FIL file;
+  UINT count;
+  ASSERT_EQ(FR_OK, f_open(&file, path, FA_READ));
+
+  LogsCaptureHeader header;
+  ASSERT_EQ(FR_OK, f_read(&file, &header, sizeof(header), &count));
+  EXPECT_EQ(0, memcmp(header.magic, LOGS_CAPTURE_MAGIC, sizeof(header.magic)));
+  EXPECT_EQ(LOGS_CAPTURE_VERSION, header.version);
+  EXPECT_EQ(MAX_OUTPUT_CHANNELS, header.channelsCount);
+  EXPECT_EQ(LOGS_BINARY_SECTOR_SIZE, header.headerSize);
+  EXPECT_EQ(MODULE_TYPE_PPM, header.modules[0].type);
+  EXPECT_EQ(1, header.modules[0].subType);
+
+  // records start on a sector boundary, each one followed by its payload
+  uint32_t size = sizeof(LogsCaptureRecord) + sizeof(frame) +
+                  sizeof(LogsCaptureRecord) + sizeof(channelOutputs);
+  EXPECT_EQ(header.headerSize + size, f_size(&file));
+
+  std::vector<uint8_t> records(size);
+  f_lseek(&file, header.headerSize);
+  ASSERT_EQ(FR_OK, f_read(&file, records.data(), records.size(), &count));
+  ASSERT_EQ(records.size(), count);
+  f_close(&file);
+
+  LogsCaptureRecord record;
+  memcpy(&record, &records[0], sizeof(record));
+  EXPECT_EQ(LOGS_CAPTURE_FRAME, record.type);
+  EXPECT_EQ(0, record.module);
+  EXPECT_EQ(sizeof(frame), record.length);
+  EXPECT_EQ(0, memcmp(frame, &records[sizeof(record)], sizeof(frame)));
+
+  uint32_t offset = sizeof(record) + sizeof(frame);
+  memcpy(&record, &records[offset], sizeof(record));
+  EXPECT_EQ(LOGS_CAPTURE_CHANNELS, record.type);
+  EXPECT_EQ(sizeof(channelOutputs), record.length);
+  int16_t channel;
+  memcpy(&channel, &records[offset + sizeof(record)], sizeof(channel));
+  EXPECT_EQ(-300, channel);
+
+  simuFatfsSetPaths("", "");
+}
+
+#endif
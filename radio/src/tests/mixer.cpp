@@ -21,6 +21,9 @@
 
 #include "gtests.h"
 #include "hal/adc_driver.h"
+#include "mixes.h"
+#include "mixer_stats.h"
+#include "mixer_scheduler.h"
 
 class TrimsTest : public OpenTxTest {};
 class MixerTest : public OpenTxTest {};
@@ -524,7 +527,100 @@ TEST(Curves, LinearIntpol)
   EXPECT_EQ(applyCustomCurve(-192, 0), -192);
 }
 
+int16_t hermite_spline(int16_t x, uint8_t idx);
 
+TEST(Curves, SmoothCurveCache)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+  setModelDefaults();
+
+  // 17 points pitch curve
+  const int8_t pitch[] = {-100, -90, -60, -45, -30, -20, -10, -5, 0,
+                          5, 15, 30, 50, 70, 85, 95, 100};
+  g_model.curves[0].type = CURVE_TYPE_STANDARD;
+  g_model.curves[0].smooth = 1;
+  g_model.curves[0].points = 17 - 5;
+  memcpy(g_model.points, pitch, sizeof(pitch));
+
+  // 5 points custom throttle curve
+  const int8_t throttle[] = {0, 40, 65, 80, 100, -60, 10, 50};
+  g_model.curves[1].type = CURVE_TYPE_CUSTOM;
+  g_model.curves[1].smooth = 1;
+  g_model.curves[1].points = 0;
+  memcpy(&g_model.points[17], throttle, sizeof(throttle));
+
+  loadCurves();
+
+  for (int x = -RESX - 10; x <= RESX + 10; x++) {
+    EXPECT_EQ(applyCustomCurve(x, 0, true), hermite_spline(x, 0));
+    EXPECT_EQ(applyCustomCurve(x, 1, true), hermite_spline(x, 1));
+  }
+
+  // the cache follows model edits
+  g_model.points[8] = 20;
+  storageConfigDirty(EE_MODEL);
+  EXPECT_EQ(applyCustomCurve(0, 0, true), calc100toRESX(20));
+}
+
+
+
+// expo() as computed before the factors table
+static int referenceExpo(int x, int k)
+{
+  if (k == 0)
+    return x;
+
+  bool neg = (x < 0);
+  if (neg)
+    x = -x;
+  if (x > RESX)
+    x = RESX;
+
+  bool inverted = (k < 0);
+  uint32_t u = inverted ? RESX - x : x;
+  uint32_t kk = inverted ? -k : k;
+
+#if defined(EXTENDED_EXPO)
+  bool extended = (kk > 80);
+  if (!extended)
+    kk += (kk >> 2);
+#endif
+
+  kk = calc100to256(kk);
+
+  uint32_t value = u * u;
+  value *= kk;
+  value >>= 8;
+  value *= u;
+
+#if defined(EXTENDED_EXPO)
+  if (extended) {
+    value >>= 16;
+    value *= u;
+    value >>= 4;
+    value *= u;
+  }
+#endif
+
+  value >>= 12;
+  value += (256 - kk) * u + 128;
+
+  int y = value >> 8;
+  if (inverted)
+    y = RESX - y;
+  return neg ? -y : y;
+}
+
+TEST(Expo, BitExact)
+{
+  for (int k = -100; k <= 100; k++) {
+    for (int x = -RESX; x <= RESX; x++) {
+      ASSERT_EQ(expo(x, k), referenceExpo(x, k)) << "x=" << x << " k=" << k;
+    }
+  }
+}
 
 TEST_F(MixerTest, InfiniteRecursiveChannels)
 {
@@ -543,6 +639,71 @@ TEST_F(MixerTest, InfiniteRecursiveChannels)
   EXPECT_EQ(chans[0], 0);
 }
 
+TEST_F(MixerTest, LongChannelChain)
+{
+  // CH1 <- CH2 <- ... <- CH8 <- MAX, declared in channel order
+  // so that every source comes after its destination
+  for (int i = 0; i < 8; i++) {
+    g_model.mixData[i].destCh = i;
+    g_model.mixData[i].srcRaw = (i < 7 ? MIXSRC_FIRST_CH + i + 1 : MIXSRC_MAX);
+    g_model.mixData[i].weight = 100;
+  }
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  for (int i = 0; i < 8; i++) {
+    EXPECT_EQ(chans[i], CHANNEL_MAX);
+  }
+  EXPECT_EQ(getMixerPlan().loopChannels, 0u);
+}
+
+TEST_F(MixerTest, ChannelLoopDetected)
+{
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].srcRaw = MIXSRC_FIRST_CH + 1;
+  g_model.mixData[0].weight = 100;
+  g_model.mixData[1].destCh = 1;
+  g_model.mixData[1].srcRaw = MIXSRC_FIRST_CH;
+  g_model.mixData[1].weight = 100;
+  g_model.mixData[2].destCh = 2;
+  g_model.mixData[2].srcRaw = MIXSRC_FIRST_CH + 1;
+  g_model.mixData[2].weight = 100;
+  g_model.mixData[3].destCh = 3;
+  g_model.mixData[3].srcRaw = MIXSRC_MAX;
+  g_model.mixData[3].weight = 100;
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(getMixerPlan().loopChannels, 0x03u);
+  EXPECT_EQ(getMixerLoopChannels(), 0x03u);
+  EXPECT_EQ(chans[3], CHANNEL_MAX);
+}
+
+TEST_F(MixerTest, ChannelAfterLoop)
+{
+  // CH1 <- CH5 <-> CH6, CH5 also driven by MAX
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].srcRaw = MIXSRC_FIRST_CH + 4;
+  g_model.mixData[0].weight = 100;
+  g_model.mixData[1].destCh = 4;
+  g_model.mixData[1].srcRaw = MIXSRC_MAX;
+  g_model.mixData[1].weight = 100;
+  g_model.mixData[2].destCh = 4;
+  g_model.mixData[2].srcRaw = MIXSRC_FIRST_CH + 5;
+  g_model.mixData[2].weight = 0;
+  g_model.mixData[3].destCh = 5;
+  g_model.mixData[3].srcRaw = MIXSRC_FIRST_CH + 4;
+  g_model.mixData[3].weight = 100;
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+
+  const MixPlan& plan = getMixerPlan();
+  EXPECT_EQ(plan.loopChannels, 0x30u);
+  ASSERT_EQ(plan.channelsCount, 3);
+  EXPECT_EQ(plan.channels[0].ch, 4);
+  EXPECT_EQ(plan.channels[1].ch, 0);
+  EXPECT_EQ(plan.channels[2].ch, 5);
+
+  // CH1 reads CH5 from the same cycle
+  EXPECT_EQ(chans[4], CHANNEL_MAX);
+  EXPECT_EQ(chans[0], CHANNEL_MAX);
+}
+
 TEST_F(MixerTest, BlockingChannel)
 {
   g_model.mixData[0].destCh = 0;
@@ -708,6 +869,101 @@ TEST_F(MixerTest, SlowOnMultiply)
   CHECK_NO_MOVEMENT(0, CHANNEL_MAX, 250);
 }
 
+TEST_F(MixerTest, PlanFollowsModelEdits)
+{
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].mltpx = MLTPX_ADD;
+  g_model.mixData[0].srcRaw = MIXSRC_MAX;
+  g_model.mixData[0].weight = 100;
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(chans[0], CHANNEL_MAX);
+
+  g_model.mixData[0].weight = 50;
+  g_model.mixData[1].destCh = 0;
+  g_model.mixData[1].mltpx = MLTPX_ADD;
+  g_model.mixData[1].srcRaw = MIXSRC_MAX;
+  g_model.mixData[1].weight = 25;
+  storageConfigDirty(EE_MODEL);
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(chans[0], CHANNEL_MAX*3/4);
+}
+
+TEST_F(MixerTest, SourcesValues)
+{
+  anas[1] = 123;
+  ex_chans[2] = -456;
+  EXPECT_EQ(getValue(MIXSRC_FIRST_INPUT + 1), 123);
+  EXPECT_EQ(getValue(MIXSRC_FIRST_CH + 2), -456);
+  EXPECT_EQ(getValue(MIXSRC_MIN), -RESX);
+  EXPECT_EQ(getValue(MIXSRC_MAX), RESX);
+  EXPECT_EQ(getValue(MIXSRC_TX_VOLTAGE), g_vbat100mV);
+
+  bool valid = true;
+  EXPECT_EQ(getValue(MIXSRC_NONE, &valid), 0);
+  EXPECT_FALSE(valid);
+
+  valid = true;
+  EXPECT_EQ(getValue(MIXSRC_LAST_TELEM + 1, &valid), 0);
+  EXPECT_FALSE(valid);
+}
+
+TEST_F(MixerTest, SourcesRanges)
+{
+  // first and last source of each range
+  const mixsrc_t sources[] = {
+    MIXSRC_FIRST_INPUT, MIXSRC_LAST_INPUT,
+    MIXSRC_FIRST_STICK,
+    (mixsrc_t)(MIXSRC_FIRST_STICK + adcGetMaxInputs(ADC_INPUT_MAIN) - 1),
+    MIXSRC_FIRST_POT,
+    (mixsrc_t)(MIXSRC_FIRST_POT + adcGetMaxInputs(ADC_INPUT_POT) - 1),
+    MIXSRC_MAX,
+    MIXSRC_FIRST_TRIM, MIXSRC_LAST_TRIM,
+    MIXSRC_FIRST_SWITCH,
+    (mixsrc_t)(MIXSRC_FIRST_SWITCH + switchGetMaxSwitches() - 1),
+    MIXSRC_FIRST_LOGICAL_SWITCH, MIXSRC_LAST_LOGICAL_SWITCH,
+    MIXSRC_FIRST_TRAINER, MIXSRC_LAST_TRAINER,
+    MIXSRC_FIRST_CH, MIXSRC_LAST_CH,
+    MIXSRC_FIRST_GVAR, MIXSRC_LAST_GVAR,
+    MIXSRC_FIRST_TIMER, MIXSRC_LAST_TIMER,
+    MIXSRC_FIRST_TELEM, MIXSRC_LAST_TELEM,
+  };
+
+  for (auto source: sources) {
+    bool valid = true;
+    getValue(source, &valid);
+    EXPECT_TRUE(valid) << "source " << source;
+  }
+}
+
+TEST_F(MixerTest, DISABLED_SourcesBenchmark)
+{
+  const struct {
+    const char * name;
+    mixsrc_t source;
+  } categories[] = {
+    { "input", MIXSRC_FIRST_INPUT },
+    { "stick", MIXSRC_FIRST_STICK },
+    { "pot", MIXSRC_FIRST_POT },
+    { "max", MIXSRC_MAX },
+    { "trim", MIXSRC_FIRST_TRIM },
+    { "switch", MIXSRC_FIRST_SWITCH },
+    { "ls", MIXSRC_FIRST_LOGICAL_SWITCH },
+    { "trainer", MIXSRC_FIRST_TRAINER },
+    { "channel", MIXSRC_FIRST_CH },
+    { "gvar", MIXSRC_FIRST_GVAR },
+    { "timer", MIXSRC_FIRST_TIMER },
+    { "telemetry", MIXSRC_LAST_TELEM },
+  };
+
+  volatile getvalue_t sum = 0;
+  for (const auto & category: categories) {
+    double ns = benchmarkNs(100000, [&]() {
+      sum = sum + getValue(category.source);
+    });
+    printf("getValue(%s): %.1f ns/call\n", category.name, ns);
+  }
+}
+
 TEST_F(TrimsTest, throttleTrimEle) {
   SYSTEM_RESET();
   MODEL_RESET();
@@ -846,6 +1102,52 @@ TEST_F(MixerTest, flightModeTransition)
   CHECK_FLIGHT_MODE_TRANSITION(0, 1000, 1024, -102);
 }
 
+TEST_F(MixerTest, flightModeTransitionSharedLines)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+  setModelDefaults();
+  g_model.flightModeData[1].swtch = SWSRC_FIRST_SWITCH + 2;
+  g_model.flightModeData[0].fadeOut = 100;
+  g_model.flightModeData[1].fadeIn = 100;
+
+  // CH1 same in all flight modes
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].srcRaw = MIXSRC_MAX;
+  g_model.mixData[0].weight = 100;
+  // CH2 depends on the flight mode
+  g_model.mixData[1].destCh = 1;
+  g_model.mixData[1].srcRaw = MIXSRC_MAX;
+  g_model.mixData[1].flightModes = 0b11110;
+  g_model.mixData[1].weight = 100;
+  g_model.mixData[2].destCh = 1;
+  g_model.mixData[2].srcRaw = MIXSRC_MAX;
+  g_model.mixData[2].flightModes = 0b11101;
+  g_model.mixData[2].weight = -10;
+  // CH3 uses CH1, CH4 uses CH2
+  g_model.mixData[3].destCh = 2;
+  g_model.mixData[3].srcRaw = MIXSRC_FIRST_CH;
+  g_model.mixData[3].weight = 50;
+  g_model.mixData[4].destCh = 3;
+  g_model.mixData[4].srcRaw = MIXSRC_FIRST_CH + 1;
+  g_model.mixData[4].weight = 100;
+
+  evalMixes(1);
+  simuSetSwitch(0, 1);
+
+  int16_t last = 1024;
+  for (int i = 0; i < 1100; i++) {
+    evalMixes(1);
+    EXPECT_EQ(channelOutputs[0], 1024);
+    EXPECT_EQ(channelOutputs[2], 512);
+    EXPECT_LE(channelOutputs[1], last);
+    EXPECT_LE(abs(channelOutputs[3] - channelOutputs[1]), 1);
+    last = channelOutputs[1];
+  }
+  EXPECT_EQ(channelOutputs[1], -102);
+}
+
 TEST_F(MixerTest, flightModeOverflow)
 {
   SYSTEM_RESET();
@@ -865,6 +1167,83 @@ TEST_F(MixerTest, flightModeOverflow)
   CHECK_FLIGHT_MODE_TRANSITION(0, 1000, 1024, 1024);
 }
 
+TEST_F(MixerTest, StageStats)
+{
+  MixerStageStats stats;
+
+  mixerStatsReset();
+  mixerStatsCommit();
+  mixerStatsGet(MIXER_STAGE_MIXES, stats);
+  EXPECT_EQ(stats.count, 0u);
+
+  evalMixes(1);
+  mixerStatsCommit();
+  evalMixes(0);
+  mixerStatsCommit();
+
+  mixerStatsGet(MIXER_STAGE_INPUTS, stats);
+  EXPECT_EQ(stats.count, 2u);
+  mixerStatsGet(MIXER_STAGE_MIXES, stats);
+  EXPECT_EQ(stats.count, 2u);
+  mixerStatsGet(MIXER_STAGE_LIMITS, stats);
+  EXPECT_EQ(stats.count, 2u);
+
+  // only evaluated on 10ms ticks
+  mixerStatsGet(MIXER_STAGE_LOGICAL_SWITCHES, stats);
+  EXPECT_EQ(stats.count, 1u);
+  mixerStatsGet(MIXER_STAGE_FUNCTIONS, stats);
+  EXPECT_EQ(stats.count, 1u);
+
+  // not part of evalMixes()
+  mixerStatsGet(MIXER_STAGE_ADC, stats);
+  EXPECT_EQ(stats.count, 0u);
+  EXPECT_LE(stats.p50, stats.p99);
+  EXPECT_LE(stats.p99, stats.max);
+}
+
+TEST(MixerScheduler, FasterModuleSentEveryCycle)
+{
+  ModuleFrameSchedule schedule = {};
+  for (uint32_t now = 0; now < 100000; now += 4000) {
+    EXPECT_TRUE(mixerScheduleFrameDue(schedule, 4000, 4000, now));
+    EXPECT_TRUE(mixerScheduleFrameDue(schedule, 2000, 4000, now));
+  }
+  EXPECT_FALSE(schedule.decimated);
+}
+
+TEST(MixerScheduler, SlowerModuleDecimated)
+{
+  // 4ms mixer, 10ms module frames
+  ModuleFrameSchedule schedule = {};
+  unsigned frames = 0;
+  for (uint32_t now = 1000; now < 1000 + 400000; now += 4000) {
+    if (mixerScheduleFrameDue(schedule, 10000, 4000, now)) {
+      // sent on the mixer cycle closest to the module frame
+      int32_t frameTime = 1000 + frames * 10000;
+      EXPECT_LE(abs((int32_t)now - frameTime), 2000);
+      frames++;
+    }
+  }
+  EXPECT_EQ(frames, 40u);
+}
+
+TEST(MixerScheduler, SlowerModuleLateCycle)
+{
+  ModuleFrameSchedule schedule = {};
+  EXPECT_TRUE(mixerScheduleFrameDue(schedule, 10000, 4000, 0));
+  EXPECT_FALSE(mixerScheduleFrameDue(schedule, 10000, 4000, 4000));
+
+  // mixer cycles missed: restart from the late cycle
+  EXPECT_TRUE(mixerScheduleFrameDue(schedule, 10000, 4000, 25000));
+  EXPECT_EQ(schedule.nextFrame, 35000u);
+  EXPECT_FALSE(mixerScheduleFrameDue(schedule, 10000, 4000, 29000));
+  EXPECT_TRUE(mixerScheduleFrameDue(schedule, 10000, 4000, 33000));
+
+  // the module became faster than the mixer
+  EXPECT_TRUE(mixerScheduleFrameDue(schedule, 4000, 4000, 37000));
+  EXPECT_FALSE(schedule.decimated);
+}
+
 TEST_F(TrimsTest, throttleTrimWithCrossTrims)
 {
   g_model.thrTrim = 1;
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+
+#if defined(STORAGE_MODELSLIST)
+
+#include "location.h"
+#include "storage/modelslist.h"
+#include "storage/sdcard_yaml.h"
+
+static void writeTestModel(const char * filename, const char * name)
+{
+  MODEL_RESET();
+  strncpy(g_model.header.name, name, LEN_MODEL_NAME);
+  strncpy(g_model.header.labels, "Lbl", LABELS_LENGTH);
+  EXPECT_EQ(nullptr, writeModelYaml(filename));
+}
+
+static void writeLabelsList(const char * content)
+{
+  FIL file;
+  ASSERT_EQ(FR_OK, f_open(&file, LABELSLIST_YAML_PATH, FA_CREATE_ALWAYS | FA_WRITE));
+  f_puts(content, &file);
+  f_close(&file);
+}
+
+static void reloadModelsList()
+{
+  modelslist.clear();
+  modelslist.load();
+}
+
+TEST(ModelsList, loadLabels)
+{
+  // empty SD card
+  simuFatfsSetPaths(TESTS_BUILD_PATH "/", TESTS_BUILD_PATH "/");
+  sdCheckAndCreateDirectory("/modelslist");
+  simuFatfsSetPaths(TESTS_BUILD_PATH "/modelslist/", TESTS_BUILD_PATH "/modelslist/");
+  sdCheckAndCreateDirectory(MODELS_PATH);
+  f_unlink(LABELSLIST_YAML_PATH);
+
+  // written in another order than their names
+  writeTestModel("model3.yml", "Charlie");
+  writeTestModel("model1.yml", "Alpha");
+  writeTestModel("model2.yml", "Bravo");
+  strcpy(g_eeGeneral.currModelFilename, "model2.yml");
+
+  // outdated hashes, a missing file and a duplicate
+  writeLabelsList(
+      "Labels:\r\n"
+      "  \"Lbl\":\r\n"
+      "Sort: 1\r\n"
+      "Models:\r\n"
+      "  model2.yml:\r\n"
+      "    hash: \"0\"\r\n"
+      "    name: \"Stale\"\r\n"
+      "  model9.yml:\r\n"
+      "    hash: \"0\"\r\n"
+      "  model2.yml:\r\n"
+      "    hash: \"0\"\r\n"
+      "  model1.yml:\r\n"
+      "    hash: \"0\"\r\n");
+
+  reloadModelsList();
+  ASSERT_EQ(3u, modelslist.size());
+  EXPECT_STREQ("model2.yml", modelslist[0]->modelFilename);
+  EXPECT_STREQ("model1.yml", modelslist[1]->modelFilename);
+  EXPECT_STREQ("model3.yml", modelslist[2]->modelFilename);
+  EXPECT_STREQ("Bravo", modelslist[0]->modelName);
+  EXPECT_STREQ("Alpha", modelslist[1]->modelName);
+  EXPECT_STREQ("Charlie", modelslist[2]->modelName);
+  EXPECT_EQ(modelslist[0], modelslist.getCurrentModel());
+  EXPECT_EQ(3u, modelslabels.getModelsByLabel("Lbl").size());
+
+  // labels.yml has been rewritten: no model is parsed anymore
+  reloadModelsList();
+  ASSERT_EQ(3u, modelslist.size());
+  for (auto cell : modelslist) {
+    EXPECT_FALSE(cell->_isDirty);
+  }
+  EXPECT_STREQ("Charlie", modelslist[2]->modelName);
+
+  // saving the current model keeps its labels.yml entry valid
+  writeTestModel("model2.yml", "Bravo");
+  strncpy(g_model.header.name, "Bravo two", LEN_MODEL_NAME);
+  storageDirty(EE_MODEL);
+  storageCheck(true);
+  EXPECT_EQ(nullptr, modelslist.save());
+
+  reloadModelsList();
+  ASSERT_EQ(3u, modelslist.size());
+  EXPECT_FALSE(modelslist[0]->_isDirty);
+  EXPECT_STREQ("Bravo two", modelslist[0]->modelName);
+
+  modelslist.clear();
+  simuFatfsSetPaths("", "");
+}
+
+#endif
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+#include "hal/serial_frames.h"
+
+#define RX_LEN 32
+
+// RX buffer written as the serial IRQ would
+struct FakeRxBuffer {
+  uint8_t buffer[RX_LEN];
+  uint32_t widx;
+  volatile uint32_t ridx;
+  SerialFrameRing<4> frames;
+
+  void receive(uint8_t first, uint32_t len)
+  {
+    for (uint32_t i = 0; i < len; i++) {
+      buffer[widx] = first + i;
+      widx = (widx + 1) & (RX_LEN - 1);
+    }
+  }
+
+  void idle() { frames.push(widx); }
+
+  int copyFrame(uint8_t* buf, uint32_t len)
+  {
+    return frames.copyFrame(buffer, RX_LEN, ridx, buf, len);
+  }
+};
+
+static void checkFrame(const uint8_t* buf, int len, uint8_t first)
+{
+  for (int i = 0; i < len; i++) {
+    EXPECT_EQ(first + i, buf[i]);
+  }
+}
+
+TEST(SerialFrames, copyFrames)
+{
+  FakeRxBuffer rx{};
+  uint8_t buf[RX_LEN];
+
+  EXPECT_EQ(0, rx.copyFrame(buf, sizeof(buf)));
+
+  // empty frames are skipped
+  rx.receive(0, 20);
+  rx.idle();
+  rx.idle();
+  EXPECT_EQ(20, rx.copyFrame(buf, sizeof(buf)));
+  checkFrame(buf, 20, 0);
+
+  // this one wraps around the RX buffer
+  rx.receive(100, 16);
+  rx.idle();
+  EXPECT_EQ(16, rx.copyFrame(buf, sizeof(buf)));
+  checkFrame(buf, 16, 100);
+  EXPECT_EQ(0, rx.copyFrame(buf, sizeof(buf)));
+  EXPECT_EQ(0u, rx.frames.takeOverruns());
+}
+
+TEST(SerialFrames, oversizeFrame)
+{
+  FakeRxBuffer rx{};
+  uint8_t buf[RX_LEN];
+
+  rx.receive(0, 20);
+  rx.idle();
+  rx.receive(50, 4);
+  rx.idle();
+
+  // the remainder is returned by the next calls
+  EXPECT_EQ(8, rx.copyFrame(buf, 8));
+  checkFrame(buf, 8, 0);
+  EXPECT_EQ(8, rx.copyFrame(buf, 8));
+  checkFrame(buf, 8, 8);
+  EXPECT_EQ(4, rx.copyFrame(buf, 8));
+  checkFrame(buf, 4, 16);
+  EXPECT_EQ(4, rx.copyFrame(buf, 8));
+  checkFrame(buf, 4, 50);
+  EXPECT_EQ(0, rx.copyFrame(buf, 8));
+}
+
+TEST(SerialFrames, ringFull)
+{
+  FakeRxBuffer rx{};
+  uint8_t buf[RX_LEN];
+
+  // 3 frames fit in the ring, the 4th and 5th are merged into the next one
+  for (int i = 0; i < 5; i++) {
+    rx.receive(i * 4, 4);
+    rx.idle();
+  }
+  EXPECT_EQ(2u, rx.frames.takeOverruns());
+  EXPECT_EQ(0u, rx.frames.takeOverruns());
+
+  // bytes lost by the USART
+  rx.frames.overrun();
+  EXPECT_EQ(1u, rx.frames.takeOverruns());
+
+  EXPECT_EQ(4, rx.copyFrame(buf, sizeof(buf)));
+  EXPECT_EQ(4, rx.copyFrame(buf, sizeof(buf)));
+  EXPECT_EQ(4, rx.copyFrame(buf, sizeof(buf)));
+  checkFrame(buf, 4, 8);
+
+  rx.receive(20, 4);
+  rx.idle();
+  EXPECT_EQ(12, rx.copyFrame(buf, sizeof(buf)));
+  checkFrame(buf, 12, 12);
+  EXPECT_EQ(0, rx.copyFrame(buf, sizeof(buf)));
+}
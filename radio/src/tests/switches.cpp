@@ -70,6 +70,42 @@ TEST(getSwitch, OldTypeStickyCSW)
 }
 #endif
 
+#if defined(PCBTARANIS)
+TEST(evalLogicalSwitches, changeTracking)
+{
+  RADIO_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+
+  // L1 reads L2 which is evaluated after it
+  setLogicalSwitch(0, LS_FUNC_AND, SWSRC_SW2, SWSRC_NONE);
+  setLogicalSwitch(1, LS_FUNC_AND, SWSRC_FIRST_SWITCH, SWSRC_NONE);
+
+  simuSetSwitch(0, 0);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), false);
+  EXPECT_EQ(getSwitch(SWSRC_SW2), false);
+
+  simuSetSwitch(0, -1);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), false);
+  EXPECT_EQ(getSwitch(SWSRC_SW2), true);
+
+  // nothing moved, L1 still needs L2 new state
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), true);
+  EXPECT_EQ(getSwitch(SWSRC_SW2), true);
+
+  // model edit
+  setLogicalSwitch(1, LS_FUNC_NONE, SWSRC_NONE, SWSRC_NONE);
+  storageConfigDirty(EE_MODEL);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW2), false);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), false);
+}
+#endif
+
 TEST(getSwitch, nullSW)
 {
   MODEL_RESET();
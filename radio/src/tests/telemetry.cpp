@@ -0,0 +1,635 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <vector>
+#include "gtests.h"
+#include "location.h"
+#include "telemetry/telemetry_history.h"
+
+TEST(Telemetry, gpsDistanceAndBearing)
+{
+  for (int32_t home = -70000000; home <= 70000000; home += 5000000) {
+    uint32_t scale = gpsLongitudeScale(home);
+    double cosLat = cos(home / 1000000.0 * M_PI / 180);
+
+    // up to ~40 km around the pilot
+    for (int32_t dlat = -360000; dlat <= 360000; dlat += 45000) {
+      for (int32_t dlon = -360000; dlon <= 360000; dlon += 45000) {
+        double y = dlat / 1000000.0 * M_PI / 180 * EARTH_RADIUS;
+        double x = dlon / 1000000.0 * M_PI / 180 * EARTH_RADIUS * cosLat;
+        double distance = sqrt(x * x + y * y);
+        if (distance > 46000)
+          continue;
+
+        EXPECT_NEAR(gpsDistance(dlat, dlon, scale), distance, 2)
+            << "home " << home << " dlat " << dlat << " dlon " << dlon;
+
+        if (distance > 10) {
+          double bearing = atan2(x, y) * 180 / M_PI;
+          if (bearing < 0)
+            bearing += 360;
+          double error = fabs(gpsBearing(dlat, dlon, scale) / 10.0 - bearing);
+          EXPECT_LT(min(error, 360 - error), 0.3)
+              << "home " << home << " dlat " << dlat << " dlon " << dlon;
+        }
+      }
+    }
+  }
+
+  EXPECT_EQ(gpsBearing(0, 0, gpsLongitudeScale(0)), 0);
+  EXPECT_EQ(gpsBearing(1000, 0, gpsLongitudeScale(0)), 0);
+  EXPECT_EQ(gpsBearing(0, 1000, gpsLongitudeScale(0)), 900);
+  EXPECT_EQ(gpsBearing(-1000, 0, gpsLongitudeScale(0)), 1800);
+  EXPECT_EQ(gpsBearing(0, -1000, gpsLongitudeScale(0)), 2700);
+}
+
+TEST(Telemetry, sensorHistory)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  TelemetrySensor & sensor = g_model.telemetrySensors[0];
+  TelemetryItem & item = telemetryItems[0];
+
+  g_tmr10ms = 1000;
+  EXPECT_EQ(telemetryHistoryGet(0), nullptr);
+  TelemetryHistory * history = telemetryHistoryEnable(0, 10);
+  ASSERT_NE(history, nullptr);
+  EXPECT_EQ(telemetryHistoryGet(0), history);
+  EXPECT_EQ(history->count, 0);
+
+  // min / max over the sample period
+  item.setValue(sensor, 5, UNIT_RAW);
+  item.setValue(sensor, 3, UNIT_RAW);
+  g_tmr10ms += 9;
+  item.setValue(sensor, 8, UNIT_RAW);
+  g_tmr10ms += 1;
+  item.setValue(sensor, 4, UNIT_RAW);
+  EXPECT_EQ(history->count, 2);
+  EXPECT_EQ(history->get(0).min, 4);
+  EXPECT_EQ(history->get(0).max, 4);
+  EXPECT_EQ(history->get(1).min, 3);
+  EXPECT_EQ(history->get(1).max, 8);
+
+  // the ring keeps the newest samples
+  for (int i = 0; i < TELEMETRY_HISTORY_DEPTH + 5; i++) {
+    g_tmr10ms += 10;
+    item.setValue(sensor, i, UNIT_RAW);
+  }
+  EXPECT_EQ(history->count, TELEMETRY_HISTORY_DEPTH);
+  EXPECT_EQ(history->get(0).max, TELEMETRY_HISTORY_DEPTH + 4);
+  EXPECT_EQ(history->get(TELEMETRY_HISTORY_DEPTH - 1).max, 5);
+
+  // the other sensors are not recorded
+  telemetryItems[1].setValue(g_model.telemetrySensors[1], 1, UNIT_RAW);
+  EXPECT_EQ(telemetryHistoryGet(1), nullptr);
+
+  // another period gets its own history, with its own depth
+  TelemetryHistory * shortHistory = telemetryHistoryEnable(0, 20, 4);
+  ASSERT_NE(shortHistory, nullptr);
+  EXPECT_NE(shortHistory, history);
+  for (int i = 0; i < 10; i++) {
+    g_tmr10ms += 20;
+    item.setValue(sensor, i, UNIT_RAW);
+  }
+  EXPECT_EQ(shortHistory->count, 4);
+  EXPECT_EQ(shortHistory->get(0).max, 9);
+  EXPECT_EQ(shortHistory->get(3).max, 6);
+  EXPECT_EQ(history->count, TELEMETRY_HISTORY_DEPTH);
+  EXPECT_EQ(history->get(0).max, 9);
+
+  // a deeper request keeps the samples of the shared history
+  EXPECT_EQ(telemetryHistoryEnable(0, 20), shortHistory);
+  EXPECT_EQ(shortHistory->count, 4);
+  EXPECT_EQ(shortHistory->depth, TELEMETRY_HISTORY_DEPTH);
+
+  // the histories still read are not handed over
+  EXPECT_EQ(telemetryHistoryGet(0), history);
+  for (int i = 1; i < TELEMETRY_HISTORY_SLOTS - 1; i++) {
+    g_tmr10ms += 1;
+    EXPECT_NE(telemetryHistoryEnable(i, 10), nullptr);
+  }
+  EXPECT_EQ(telemetryHistoryEnable(TELEMETRY_HISTORY_SLOTS, 10), nullptr);
+  EXPECT_EQ(history->count, TELEMETRY_HISTORY_DEPTH);
+
+  // the least recently read one is, once idle
+  g_tmr10ms += TELEMETRY_HISTORY_IDLE_TIME;
+  EXPECT_EQ(telemetryHistoryEnable(0, 20), shortHistory);
+  for (int i = 1; i < TELEMETRY_HISTORY_SLOTS - 1; i++) {
+    EXPECT_NE(telemetryHistoryEnable(i, 10), nullptr);
+  }
+  EXPECT_EQ(telemetryHistoryEnable(TELEMETRY_HISTORY_SLOTS, 10), history);
+  EXPECT_EQ(history->count, 0);
+  EXPECT_EQ(telemetryHistoryGet(0), shortHistory);
+  EXPECT_EQ(shortHistory->count, 4);
+
+  telemetryReset();
+  EXPECT_EQ(history->count, 0);
+}
+
+struct ExpectedSensor {
+  uint16_t id;
+  TelemetryUnit unit;
+  uint8_t prec;
+  int32_t value;
+};
+
+// Decodes the captured packets twice (cells and filtered values need
+// more than one packet), and checks that no duplicate was created
+template <size_t N, size_t L>
+static void decodeTelemetryPackets(void (*process)(const uint8_t *),
+                                   const uint8_t (&packets)[N][L])
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  telemetryData.telemetryValid = 0x07;
+  allowNewSensors = true;
+
+  // decoders may patch the packet in place
+  uint8_t packet[L];
+
+  for (auto & captured: packets) {
+    memcpy(packet, captured, L);
+    process(packet);
+  }
+  int count = lastUsedTelemetryIndex() + 1;
+
+  for (auto & captured: packets) {
+    memcpy(packet, captured, L);
+    process(packet);
+  }
+  EXPECT_EQ(lastUsedTelemetryIndex() + 1, count);
+}
+
+static int findTelemetrySensor(uint16_t id)
+{
+  for (int i = 0; i <= lastUsedTelemetryIndex(); i++) {
+    if (g_model.telemetrySensors[i].id == id)
+      return i;
+  }
+  return -1;
+}
+
+template <size_t N>
+static void checkTelemetrySensors(const ExpectedSensor (&expected)[N])
+{
+  for (auto & e: expected) {
+    int index = findTelemetrySensor(e.id);
+    ASSERT_GE(index, 0) << "sensor " << std::hex << e.id;
+    const TelemetrySensor & sensor = g_model.telemetrySensors[index];
+    EXPECT_NE(sensor.label[0], '\0') << "sensor " << std::hex << e.id;
+    EXPECT_EQ(sensor.unit, e.unit) << "sensor " << std::hex << e.id;
+    EXPECT_EQ(sensor.prec, e.prec) << "sensor " << std::hex << e.id;
+    EXPECT_EQ(telemetryItems[index].value, e.value) << "sensor " << std::hex << e.id;
+  }
+}
+
+// Decodes the captured packets again and again after the sensors
+// discovery, prints the time per packet and returns the sensors count
+template <size_t N, size_t L>
+static int benchmarkTelemetryDecoder(const char * name,
+                                     void (*process)(const uint8_t *),
+                                     const uint8_t (&packets)[N][L])
+{
+  decodeTelemetryPackets(process, packets);
+
+  uint8_t packet[L];
+  double ns = benchmarkNs(1000, [&]() {
+    for (auto & captured: packets) {
+      memcpy(packet, captured, L);
+      process(packet);
+    }
+  });
+
+  int count = lastUsedTelemetryIndex() + 1;
+  printf("%s decoder: %.1f ns/packet (%d sensors)\n", name, ns / N, count);
+  return count;
+}
+
+// RSSI, RxBt, Alt, VSpd, Curr, VFAS, Tmp1, RPM, Fuel, GAlt, GSpd, ASpd,
+// ESC volts + current, ESC temp, DIY
+static const uint8_t sportPackets[][FRSKY_SPORT_PACKET_SIZE] = {
+  { 0x98, 0x10, 0x01, 0xF1, 0x50, 0x00, 0x00, 0x00, 0xAC },
+  { 0x98, 0x10, 0x04, 0xF1, 0x78, 0x00, 0x00, 0x00, 0x81 },
+  { 0x1B, 0x10, 0x00, 0x01, 0xE0, 0x15, 0x00, 0x00, 0xF8 },
+  { 0x1B, 0x10, 0x10, 0x01, 0x2E, 0x00, 0x00, 0x00, 0xB0 },
+  { 0x22, 0x10, 0x00, 0x02, 0x7B, 0x00, 0x00, 0x00, 0x72 },
+  { 0x22, 0x10, 0x10, 0x02, 0xEC, 0x04, 0x00, 0x00, 0xEC },
+  { 0x83, 0x10, 0x00, 0x04, 0x19, 0x00, 0x00, 0x00, 0xD2 },
+  { 0x83, 0x10, 0x00, 0x05, 0x10, 0x27, 0x00, 0x00, 0xB3 },
+  { 0x83, 0x10, 0x00, 0x06, 0x4B, 0x00, 0x00, 0x00, 0x9E },
+  { 0x67, 0x10, 0x20, 0x08, 0xE0, 0x15, 0x00, 0x00, 0xD1 },
+  { 0x67, 0x10, 0x30, 0x08, 0x50, 0x46, 0x00, 0x00, 0x21 },
+  { 0x67, 0x10, 0x00, 0x0A, 0x68, 0x01, 0x00, 0x00, 0x7C },
+  { 0x0D, 0x10, 0x50, 0x0B, 0xEC, 0x04, 0x7B, 0x00, 0x28 },
+  { 0x0D, 0x10, 0x70, 0x0B, 0x28, 0x00, 0x00, 0x00, 0x4C },
+  { 0x48, 0x10, 0x00, 0x51, 0x01, 0x00, 0x00, 0x00, 0x9D },
+};
+
+static void processSportPacket(const uint8_t * packet)
+{
+  sportProcessTelemetryPacket(0, packet, FRSKY_SPORT_PACKET_SIZE);
+}
+
+#if defined(MULTIMODULE)
+
+#include "telemetry/spektrum.h"
+#include "telemetry/hitec.h"
+#include "telemetry/hott.h"
+#include "telemetry/multi.h"
+
+static const uint8_t spektrumPackets[][18] = {
+  // GPS LOC (BCD): Alt 009.7 (negative), LAT 28o 12'7154, LON -82 09 8040, Course 148.5
+  { 0x00, 0x1F, 0x16, 0x00, 0x97, 0x00, 0x54, 0x71, 0x12, 0x28,
+    0x40, 0x80, 0x09, 0x82, 0x85, 0x14, 0x13, 0xB9 },
+  // GPS STAT (BCD): Spd 002.5k, TimeUTC 21:18:28.00, Sats 06
+  { 0x00, 0x1F, 0x17, 0x00, 0x25, 0x00, 0x00, 0x28, 0x18, 0x21,
+    0x06, 0x00 },
+  // Dual flight pack monitor: B1 004.7A 2352mAh 38.9C, B2 004.3A 2567mAh 38.5C
+  { 0x00, 0x1F, 0x34, 0x00, 0x2F, 0x00, 0x30, 0x09, 0x85, 0x01,
+    0x2B, 0x00, 0x07, 0x0A, 0x81, 0x01 },
+  // Smart ESC: 12000 RPM, 22.20V, 45.0C, 18.00A, 40.0C, 1.2A, 6.00V, 60%, 55%
+  { 0x00, 0x1F, 0x20, 0x00, 0x04, 0xB0, 0x08, 0xAC, 0x01, 0xC2,
+    0x07, 0x08, 0x01, 0x90, 0x0C, 0x78, 0x78, 0x6E },
+  // RPM 500, 12.00V, 85F
+  { 0x00, 0x1F, 0x7E, 0x00, 0x01, 0xF4, 0x04, 0xB0, 0x00, 0x55 },
+  // QoS: A 2, B 3, L 0, R 0, frame loss 1, holds 0, 5.00V
+  { 0x00, 0x1F, 0x7F, 0x00, 0x00, 0x02, 0x00, 0x03, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01, 0xF4 },
+};
+
+TEST(Telemetry, spektrumDecoder)
+{
+  const ExpectedSensor expected[] = {
+    { 0x1600, UNIT_METERS, 1, -97 },
+    { 0x160A, UNIT_DEGREE, 1, 1485 },
+    { 0x1700, UNIT_KTS, 1, 25 },
+    { 0x1706, UNIT_RAW, 0, 6 },
+    { 0x3400, UNIT_AMPS, 1, 47 },
+    { 0x3402, UNIT_MAH, 0, 2352 },
+    { 0x3404, UNIT_CELSIUS, 1, 389 },
+    { 0x3406, UNIT_AMPS, 1, 43 },
+    { 0x3408, UNIT_MAH, 0, 2567 },
+    { 0x340A, UNIT_CELSIUS, 1, 385 },
+    { 0x2000, UNIT_RPMS, 0, 12000 },
+    { 0x2002, UNIT_VOLTS, 2, 2220 },
+    { 0x2004, UNIT_CELSIUS, 1, 450 },
+    { 0x2006, UNIT_AMPS, 2, 1800 },
+    { 0x2008, UNIT_CELSIUS, 1, 400 },
+    { 0x200A, UNIT_AMPS, 1, 12 },
+    { 0x200B, UNIT_VOLTS, 2, 600 },
+    { 0x200C, UNIT_PERCENT, 0, 60 },
+    { 0x200D, UNIT_PERCENT, 0, 55 },
+    { 0x7E00, UNIT_RPMS, 0, 500 },
+    { 0x7E02, UNIT_VOLTS, 2, 1200 },
+    { 0x7E04, UNIT_CELSIUS, 0, 29 },
+    { 0x7F00, UNIT_RAW, 0, 2 },
+    { 0x7F02, UNIT_RAW, 0, 3 },
+    { 0x7F08, UNIT_RAW, 0, 1 },
+    { 0x7F0C, UNIT_VOLTS, 2, 500 },
+  };
+
+  decodeTelemetryPackets(processSpektrumPacket, spektrumPackets);
+  checkTelemetrySensors(expected);
+
+  int index = findTelemetrySensor(0x1602);
+  ASSERT_GE(index, 0);
+  EXPECT_EQ(g_model.telemetrySensors[index].unit, UNIT_GPS);
+  EXPECT_EQ(telemetryItems[index].gps.latitude, 28211923);
+  EXPECT_EQ(telemetryItems[index].gps.longitude, -82163400);
+
+  index = findTelemetrySensor(0x1702);
+  ASSERT_GE(index, 0);
+  EXPECT_EQ(g_model.telemetrySensors[index].unit, UNIT_DATETIME);
+  EXPECT_EQ(telemetryItems[index].datetime.hour, 21);
+  EXPECT_EQ(telemetryItems[index].datetime.min, 18);
+  EXPECT_EQ(telemetryItems[index].datetime.sec, 28);
+}
+
+// The Spektrum packets, as received from a DSMP module (0xAA header) or
+// wrapped in Multi module frames, give the same values however the
+// received bytes are split
+TEST(Telemetry, spektrumStreamDecoding)
+{
+  decodeTelemetryPackets(processSpektrumPacket, spektrumPackets);
+  int count = lastUsedTelemetryIndex() + 1;
+  std::vector<int32_t> values;
+  for (int i = 0; i < count; i++) {
+    values.push_back(telemetryItems[i].value);
+  }
+
+  const uint8_t length = sizeof(spektrumPackets[0]) - 1;
+  uint8_t dsmpStream[2 * DIM(spektrumPackets) * (length + 1)];
+  uint8_t multiStream[2 * DIM(spektrumPackets) * (length + 4)];
+  uint8_t dsmpSize = 0, multiSize = 0;
+  for (int n = 0; n < 2; n++) {
+    for (auto & packet: spektrumPackets) {
+      dsmpStream[dsmpSize++] = 0xAA;
+      memcpy(&dsmpStream[dsmpSize], &packet[1], length);
+      dsmpSize += length;
+
+      const uint8_t header[] = { 'M', 'P', 0x04 /* Spektrum */, length };
+      memcpy(&multiStream[multiSize], header, sizeof(header));
+      memcpy(&multiStream[multiSize + sizeof(header)], &packet[1], length);
+      multiSize += sizeof(header) + length;
+    }
+  }
+
+  for (uint8_t chunk = 1; chunk <= 40; chunk++) {
+    for (int multi = 0; multi < 2; multi++) {
+      MODEL_RESET();
+      TELEMETRY_RESET();
+      telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+      telemetryData.telemetryValid = 0x07;
+      allowNewSensors = true;
+
+      uint8_t * buffer = getTelemetryRxBuffer(EXTERNAL_MODULE);
+      uint8_t & len = getTelemetryRxBufferCount(EXTERNAL_MODULE);
+      len = 0;
+
+      const uint8_t * stream = multi ? multiStream : dsmpStream;
+      uint8_t size = multi ? multiSize : dsmpSize;
+      for (int i = 0; i < size; i += chunk) {
+        uint8_t dlen = min<int>(chunk, size - i);
+        if (multi)
+          processMultiTelemetryData(stream + i, dlen, EXTERNAL_MODULE);
+        else
+          processSpektrumTelemetryData(EXTERNAL_MODULE, stream + i, dlen, buffer, len);
+      }
+
+      ASSERT_EQ(lastUsedTelemetryIndex() + 1, count) << "chunk " << (int)chunk;
+      for (int i = 0; i < count; i++) {
+        EXPECT_EQ(telemetryItems[i].value, values[i])
+            << "chunk " << (int)chunk << (multi ? " multi" : " dsmp");
+      }
+    }
+  }
+}
+
+static const uint8_t hottPackets[][15] = {
+  // RX: 4.8V, 22C, RSSI -26dBm, LQI 100, min 4.8V, VPack 16ms
+  { 0x60, 0x64, 0x00, 0x00, 0x00, 0x30, 0x2A, 0x5A, 0x64, 0x30,
+    0x10, 0x00 },
+  // Vario: 100m, 0.50m/s, heading 90
+  { 0x60, 0x64, 0x09, 0x01, 0x00, 0x00, 0x58, 0x02, 0x00, 0x00,
+    0x00, 0x00, 0x62, 0x75 },
+  { 0x60, 0x64, 0x09, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x2D },
+  // GAM: cells 4.20V + 4.16V, batt1 12.6V, batt2 12.4V, 25C, 20C, 75%,
+  // 10000 RPM, 56m, 0.46m/s, 12.3A, 3000mAh, 36km/h, 5000 RPM
+  { 0x60, 0x64, 0x0D, 0x01, 0x00, 0x00, 0x00, 0xD2, 0xD0, 0x00,
+    0x00, 0x00, 0x00, 0x7E, 0x00 },
+  { 0x60, 0x64, 0x0D, 0x02, 0x00, 0x7C, 0x00, 0x2D, 0x28, 0x4B,
+    0x00, 0x00, 0xE8, 0x03, 0x00 },
+  { 0x60, 0x64, 0x0D, 0x03, 0x2C, 0x02, 0x5E, 0x75, 0x78, 0x7B,
+    0x00, 0x00, 0x00, 0x2C, 0x00 },
+  { 0x60, 0x64, 0x0D, 0x04, 0x01, 0x24, 0x00, 0x00, 0x00, 0xF4,
+    0x01, 0x00, 0x00, 0x00, 0x00 },
+};
+
+TEST(Telemetry, hottDecoder)
+{
+  const ExpectedSensor expected[] = {
+    { 0xFF01, UNIT_DB, 0, -23 },
+    { 0xFF02, UNIT_RAW, 0, 100 },
+    { 0x0001, UNIT_DB, 0, -26 },
+    { 0x0002, UNIT_RAW, 0, 100 },
+    { 0x0003, UNIT_VOLTS, 1, 48 },
+    { 0x0004, UNIT_CELSIUS, 0, 22 },
+    { 0x0005, UNIT_VOLTS, 1, 48 },
+    { 0x0006, UNIT_MS, 0, 16 },
+    { 0x0007, UNIT_RAW, 0, 0 },
+    { 0x0901, UNIT_METERS, 0, 100 },
+    { 0x0902, UNIT_METERS_PER_SECOND, 1, 5 },
+    { 0x0903, UNIT_DEGREE, 0, 90 },
+    { 0x0D01, UNIT_CELLS, 2, 836 },
+    { 0x0D02, UNIT_VOLTS, 1, 126 },
+    { 0x0D03, UNIT_VOLTS, 1, 124 },
+    { 0x0D04, UNIT_CELSIUS, 0, 25 },
+    { 0x0D05, UNIT_CELSIUS, 0, 20 },
+    { 0x0D06, UNIT_PERCENT, 0, 75 },
+    { 0x0D07, UNIT_RPMS, 0, 10000 },
+    { 0x0D08, UNIT_METERS, 0, 56 },
+    { 0x0D09, UNIT_METERS_PER_SECOND, 1, 4 },
+    { 0x0D0A, UNIT_AMPS, 1, 123 },
+    { 0x0D0C, UNIT_MAH, 0, 3000 },
+    { 0x0D0D, UNIT_KMH, 0, 36 },
+    { 0x0D0E, UNIT_RPMS, 0, 5000 },
+  };
+
+  decodeTelemetryPackets(processHottPacket, hottPackets);
+  checkTelemetrySensors(expected);
+
+  int index = findTelemetrySensor(0x0D01);
+  ASSERT_GE(index, 0);
+  EXPECT_EQ(telemetryItems[index].cells.count, 2);
+  EXPECT_EQ(telemetryItems[index].cells.values[0].value, 420);
+  EXPECT_EQ(telemetryItems[index].cells.values[1].value, 416);
+}
+
+static const uint8_t hitecPackets[][8] = {
+  // RX 7.14V
+  { 0x40, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC8 },
+  // LAT 47o 30', LON 8o 15', temp2 25C
+  { 0x40, 0x64, 0x12, 0x00, 0x00, 0x12, 0x7A, 0x00 },
+  { 0x40, 0x64, 0x13, 0x00, 0x00, 0x03, 0x2F, 0x41 },
+  // 16km/h, 100m, temp1 20C
+  { 0x40, 0x64, 0x14, 0x00, 0x10, 0x00, 0x64, 0x3C },
+  // fuel 100%, 1000 RPM, 2000 RPM
+  { 0x40, 0x64, 0x15, 0x32, 0xE8, 0x03, 0xD0, 0x07 },
+  // heading 90, 8 sats, temp3 20C, temp4 21C
+  { 0x40, 0x64, 0x17, 0x00, 0x5A, 0x08, 0x3C, 0x3D },
+  // 12.6V, current 180
+  { 0x40, 0x64, 0x18, 0x7C, 0x00, 0xB4, 0x00, 0x00 },
+  // servos 1.0A, 2.0A, 3.0A, 4.0A
+  { 0x40, 0x64, 0x19, 0x0A, 0x14, 0x1E, 0x28, 0x00 },
+  // air speed 50km/h
+  { 0x40, 0x64, 0x1A, 0x00, 0x00, 0x00, 0x32, 0x00 },
+};
+
+TEST(Telemetry, hitecDecoder)
+{
+  const ExpectedSensor expected[] = {
+    { 0x0003, UNIT_VOLTS, 2, 714 },
+    { 0x1304, UNIT_CELSIUS, 0, 25 },
+    { 0x1400, UNIT_KMH, 0, 16 },
+    { 0x1402, UNIT_METERS, 0, 100 },
+    { 0x1404, UNIT_CELSIUS, 0, 20 },
+    { 0x1500, UNIT_PERCENT, 0, 100 },
+    { 0x1501, UNIT_RPMS, 0, 1000 },
+    { 0x1503, UNIT_RPMS, 0, 2000 },
+    { 0x1700, UNIT_DEGREE, 0, 90 },
+    { 0x1702, UNIT_RAW, 0, 8 },
+    { 0x1703, UNIT_CELSIUS, 0, 20 },
+    { 0x1704, UNIT_CELSIUS, 0, 21 },
+    { 0x1800, UNIT_VOLTS, 1, 126 },
+    { 0x1802, UNIT_AMPS, 0, 180 },
+    { 0x1803, UNIT_AMPS, 1, 425 },
+    { 0x1804, UNIT_AMPS, 0, 705 },
+    { 0x1900, UNIT_AMPS, 1, 10 },
+    { 0x1901, UNIT_AMPS, 1, 20 },
+    { 0x1902, UNIT_AMPS, 1, 30 },
+    { 0x1903, UNIT_AMPS, 1, 40 },
+    { 0x1A02, UNIT_KMH, 0, 50 },
+  };
+
+  decodeTelemetryPackets(processHitecPacket, hitecPackets);
+  checkTelemetrySensors(expected);
+
+  int index = findTelemetrySensor(0x1200);
+  ASSERT_GE(index, 0);
+  EXPECT_EQ(g_model.telemetrySensors[index].unit, UNIT_GPS);
+  EXPECT_EQ(telemetryItems[index].gps.latitude, 47500000);
+  EXPECT_EQ(telemetryItems[index].gps.longitude, 8250000);
+}
+
+#endif
+
+#if defined(CROSSFIRE) && defined(HARDWARE_EXTERNAL_MODULE)
+
+#include "telemetry/crossfire.h"
+#include "logs_capture.h"
+#include "targets/simu/simureplay.h"
+
+// Link, link RX, link TX, battery, GPS, vario, baro altitude, attitude,
+// flight mode
+static const uint8_t crossfirePackets[][19] = {
+  { 0xEA, 0x0C, 0x14, 0xC8, 0x00, 0x64, 0x0A, 0x00, 0x04, 0x01, 0x37, 0x64,
+    0x0F, 0x06 },
+  { 0xEA, 0x07, 0x1C, 0x3A, 0x5A, 0x64, 0x0A, 0x03, 0xFA },
+  { 0xEA, 0x08, 0x1D, 0x37, 0x50, 0x64, 0x0F, 0x03, 0x05, 0x06 },
+  { 0xEA, 0x0A, 0x08, 0x00, 0xA8, 0x00, 0x7B, 0x00, 0x0B, 0xB8, 0x4B, 0x49 },
+  { 0xEA, 0x11, 0x02, 0x10, 0xD0, 0xCC, 0x3E, 0xCF, 0x06, 0xDC, 0x30, 0x01,
+    0x68, 0x23, 0x28, 0x04, 0x20, 0x08, 0xF7 },
+  { 0xEA, 0x04, 0x07, 0x00, 0x2E, 0x2F },
+  { 0xEA, 0x04, 0x09, 0x29, 0x40, 0x1E },
+  { 0xEA, 0x08, 0x1E, 0x03, 0xE8, 0xFE, 0x0C, 0x3D, 0x5C, 0xFF },
+  { 0xEA, 0x07, 0x21, 0x41, 0x43, 0x52, 0x4F, 0x00, 0x80 },
+};
+
+static void processCrossfirePacket(const uint8_t * packet)
+{
+  // the test copy of the frame may be patched in place
+  processCrossfireTelemetryFrame(EXTERNAL_MODULE, (uint8_t *)packet,
+                                 packet[1] + 2);
+}
+
+static void writeCrossfireLinkFrame(FILE * f, uint32_t time, uint8_t quality)
+{
+  uint8_t frame[] = { 0xEA, 0x0C, 0x14, 0xC8, 0x00, quality, 0x0A, 0x00,
+                      0x04, 0x01, 0x37, 0x64, 0x0F, 0x00 };
+  frame[sizeof(frame) - 1] = crc8(&frame[2], frame[1] - 1);
+
+  LogsCaptureRecord record = { time, LOGS_CAPTURE_FRAME, EXTERNAL_MODULE,
+                               sizeof(frame) };
+  fwrite(&record, sizeof(record), 1, f);
+  fwrite(frame, sizeof(frame), 1, f);
+}
+
+static std::string replayCapture(const char * capture, uint32_t speed)
+{
+  std::string path = std::string(TESTS_BUILD_PATH) + "/replay.csv";
+  FILE * trace = fopen(path.c_str(), "w");
+  SimuReplayStats stats;
+  EXPECT_TRUE(simuReplayCapture(capture, speed, trace, &stats));
+  fclose(trace);
+  EXPECT_EQ(stats.frames, 50u);
+  EXPECT_EQ(stats.duration, 4900u);
+
+  std::string result;
+  char line[64];
+  trace = fopen(path.c_str(), "r");
+  while (fgets(line, sizeof(line), trace)) {
+    // only keep the lines independent from the radio defaults
+    if (!strstr(line, ",sensor,") || strstr(line, ",RQly,"))
+      result += line;
+  }
+  fclose(trace);
+  return result;
+}
+
+TEST_F(OpenTxTest, telemetryCaptureReplay)
+{
+  std::string path = std::string(TESTS_BUILD_PATH) + "/replay.etxr";
+  FILE * f = fopen(path.c_str(), "wb");
+  ASSERT_NE(f, nullptr);
+
+  LogsCaptureHeader header;
+  memclear(&header, sizeof(header));
+  memcpy(header.magic, LOGS_CAPTURE_MAGIC, sizeof(header.magic));
+  header.version = LOGS_CAPTURE_VERSION;
+  header.headerSize = sizeof(header);
+  header.modules[EXTERNAL_MODULE].type = MODULE_TYPE_CROSSFIRE;
+  fwrite(&header, sizeof(header), 1, f);
+
+  // 5s of link statistics at 10Hz, with the time wrapping in the middle,
+  // then the link is lost
+  uint32_t time = 0xFFFFFFFF - 2000000;
+  for (int i = 0; i < 50; i++) {
+    writeCrossfireLinkFrame(f, time, i < 25 ? 100 : 40);
+    time += 100000;
+  }
+  fclose(f);
+
+  // the module type comes from the capture, RQly is declared and the
+  // other sensors are discovered
+  g_model.moduleData[EXTERNAL_MODULE].type = MODULE_TYPE_NONE;
+  crossfireSetDefault(0, LINK_ID, 2);
+
+  // L1: RQly > 50
+  g_model.logicalSw[0].func = LS_FUNC_VPOS;
+  g_model.logicalSw[0].v1 = MIXSRC_FIRST_TELEM;
+  g_model.logicalSw[0].v2 = 50;
+
+  std::string fast = replayCapture(path.c_str(), SIMU_REPLAY_MAX_SPEED);
+  EXPECT_NE(fast.find("sensor,RQly,100\n"), std::string::npos);
+  EXPECT_NE(fast.find("sensor,RQly,40\n"), std::string::npos);
+  EXPECT_NE(fast.find("alarm,rssi,critical\n"), std::string::npos);
+  EXPECT_NE(fast.find("alarm,telemetry,connected\n"), std::string::npos);
+  EXPECT_NE(fast.find("alarm,telemetry,lost\n"), std::string::npos);
+  EXPECT_NE(fast.find("switch,L1,1\n"), std::string::npos);
+  EXPECT_NE(fast.find("switch,L1,0\n"), std::string::npos);
+
+  // the model is restored after the replay
+  EXPECT_EQ(g_model.moduleData[EXTERNAL_MODULE].type, MODULE_TYPE_NONE);
+  EXPECT_TRUE(g_model.telemetrySensors[0].isAvailable());
+  EXPECT_FALSE(g_model.telemetrySensors[1].isAvailable());
+
+  // so that the next replay gives the same trace
+  EXPECT_EQ(replayCapture(path.c_str(), SIMU_REPLAY_MAX_SPEED), fast);
+}
+
+#endif
+
+// Opt-in, run with:
+//   gtests-radio --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'
+TEST(Telemetry, DISABLED_decodersBenchmark)
+{
+  EXPECT_EQ(benchmarkTelemetryDecoder("S.Port", processSportPacket, sportPackets), 16);
+#if defined(MULTIMODULE)
+  EXPECT_EQ(benchmarkTelemetryDecoder("Spektrum", processSpektrumPacket, spektrumPackets), 32);
+  EXPECT_EQ(benchmarkTelemetryDecoder("HoTT", processHottPacket, hottPackets), 26);
+  EXPECT_EQ(benchmarkTelemetryDecoder("Hitec", processHitecPacket, hitecPackets), 24);
+#endif
+#if defined(CROSSFIRE) && defined(HARDWARE_EXTERNAL_MODULE)
+  EXPECT_EQ(benchmarkTelemetryDecoder("CRSF", processCrossfirePacket, crossfirePackets), 30);
+#endif
+}
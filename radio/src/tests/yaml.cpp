@@ -68,3 +68,163 @@ TEST(Yaml, SkipBlankLines)
   EXPECT_EQ(YamlParser::CONTINUE_PARSING, yp.parse(chunk_3, sizeof(chunk_3) - 1));
   EXPECT_EQ(45, t.foo);
 }
+
+TEST(Yaml, AttributesOutOfOrder)
+{
+  TestStruct t;
+
+  YamlTreeWalker tree;
+  tree.reset(&_root_node, (uint8_t*)&t);
+
+  const char chunk[] = "testStruct:\n  bar: 34\n  unknown: 1\n  foo: 12\n  bar: 56\n";
+
+  YamlParser yp;
+  yp.init(YamlTreeWalker::get_parser_calls(), &tree);
+  yp.set_eof();
+  EXPECT_EQ(YamlParser::CONTINUE_PARSING, yp.parse(chunk, sizeof(chunk) - 1));
+  EXPECT_EQ(12, t.foo);
+  EXPECT_EQ(56, t.bar);
+}
+
+#if defined(SDCARD_YAML)
+#include "location.h"
+#include <storage/sdcard_yaml.h>
+#include <storage/yaml/yaml_datastructs.h>
+
+TEST(Yaml, ReadFileWithChecksum)
+{
+  simuFatfsSetPaths(TESTS_BUILD_PATH "/", TESTS_BUILD_PATH "/");
+  sdCheckAndCreateDirectory(RADIO_PATH);
+
+  generalDefault();
+  g_eeGeneral.speakerVolume = 7;
+  g_eeGeneral.vBatMin = -20;
+  g_eeGeneral.ttsLanguage[0] = 'd';
+  g_eeGeneral.ttsLanguage[1] = 'e';
+  g_eeGeneral.customFn[1].swtch = SWSRC_ON;
+  g_eeGeneral.customFn[1].func = FUNC_LOGS;
+  g_eeGeneral.customFn[1].all.val = 10;
+  EXPECT_EQ(nullptr, writeGeneralSettings());
+
+  // the file is read through several buffers
+  FILINFO fno;
+  EXPECT_EQ(FR_OK, f_stat(RADIO_SETTINGS_YAML_PATH, &fno));
+  EXPECT_GT(fno.fsize, 512u);
+
+  memclear(&g_eeGeneral, sizeof(g_eeGeneral));
+  YamlTreeWalker tree;
+  tree.reset(get_radiodata_nodes(), (uint8_t*)&g_eeGeneral);
+  ChecksumResult checksum = ChecksumResult::None;
+  EXPECT_EQ(nullptr, readYamlFile(RADIO_SETTINGS_YAML_PATH, YamlTreeWalker::get_parser_calls(), &tree, &checksum));
+  EXPECT_EQ(ChecksumResult::Success, checksum);
+
+  EXPECT_EQ(7, g_eeGeneral.speakerVolume);
+  EXPECT_EQ(-20, g_eeGeneral.vBatMin);
+  EXPECT_EQ('d', g_eeGeneral.ttsLanguage[0]);
+  EXPECT_EQ('e', g_eeGeneral.ttsLanguage[1]);
+  EXPECT_EQ(SWSRC_ON, g_eeGeneral.customFn[1].swtch);
+  EXPECT_EQ(FUNC_LOGS, g_eeGeneral.customFn[1].func);
+  EXPECT_EQ(10, g_eeGeneral.customFn[1].all.val);
+
+  generalDefault();
+  simuFatfsSetPaths("","");
+}
+
+TEST(Yaml, LogsFormat)
+{
+  simuFatfsSetPaths(TESTS_BUILD_PATH "/", TESTS_BUILD_PATH "/");
+  sdCheckAndCreateDirectory(RADIO_PATH);
+
+  generalDefault();
+  CustomFunctionData * cfn = &g_eeGeneral.customFn[0];
+  cfn->swtch = SWSRC_ON;
+  cfn->func = FUNC_LOGS;
+  CFN_PARAM(cfn) = 5;
+  CFN_LOGS_FORMAT(cfn) = LOGS_FORMAT_BINARY;
+  cfn = &g_eeGeneral.customFn[1];
+  cfn->swtch = SWSRC_ON;
+  cfn->func = FUNC_LOGS;
+  CFN_PARAM(cfn) = 20;
+  cfn = &g_eeGeneral.customFn[2];
+  cfn->swtch = SWSRC_ON;
+  cfn->func = FUNC_LOGS;
+  CFN_PARAM(cfn) = 1;
+  CFN_LOGS_FORMAT(cfn) = LOGS_FORMAT_CAPTURE;
+  EXPECT_EQ(nullptr, writeGeneralSettings());
+
+  memclear(&g_eeGeneral, sizeof(g_eeGeneral));
+  YamlTreeWalker tree;
+  tree.reset(get_radiodata_nodes(), (uint8_t*)&g_eeGeneral);
+  EXPECT_EQ(nullptr, readYamlFile(RADIO_SETTINGS_YAML_PATH, YamlTreeWalker::get_parser_calls(), &tree, nullptr));
+
+  // ",bin" suffix
+  cfn = &g_eeGeneral.customFn[0];
+  EXPECT_EQ(FUNC_LOGS, cfn->func);
+  EXPECT_EQ(5, CFN_PARAM(cfn));
+  EXPECT_EQ(LOGS_FORMAT_BINARY, CFN_LOGS_FORMAT(cfn));
+
+  // no suffix for CSV
+  cfn = &g_eeGeneral.customFn[1];
+  EXPECT_EQ(FUNC_LOGS, cfn->func);
+  EXPECT_EQ(20, CFN_PARAM(cfn));
+  EXPECT_EQ(LOGS_FORMAT_CSV, CFN_LOGS_FORMAT(cfn));
+
+  // ",raw" suffix
+  cfn = &g_eeGeneral.customFn[2];
+  EXPECT_EQ(FUNC_LOGS, cfn->func);
+  EXPECT_EQ(1, CFN_PARAM(cfn));
+  EXPECT_EQ(LOGS_FORMAT_CAPTURE, CFN_LOGS_FORMAT(cfn));
+
+  generalDefault();
+  simuFatfsSetPaths("","");
+}
+#endif
+
+#if defined(MODEL_SNAPSHOTS)
+#include <storage/model_snapshot.h>
+
+TEST(Yaml, ModelSnapshot)
+{
+  simuFatfsSetPaths(TESTS_BUILD_PATH "/", TESTS_BUILD_PATH "/");
+  sdCheckAndCreateDirectory(MODELS_PATH);
+
+  MODEL_RESET();
+  memcpy(g_model.header.name, "Snap", 4);
+  g_model.mixData[0].srcRaw = MIXSRC_FIRST_STICK;
+  g_model.mixData[0].weight = 42;
+  EXPECT_EQ(nullptr, writeModelYaml("snapshot.yml"));
+
+  // the first read parses the YAML file, the snapshot is saved
+  // later by the storage check
+  EXPECT_EQ(nullptr, readModelYaml("snapshot.yml", (uint8_t*)&g_model, sizeof(g_model)));
+  static ModelData model;
+  memcpy(&model, &g_model, sizeof(model));
+  EXPECT_NE(nullptr, readModelSnapshot("snapshot.yml", MODELS_PATH "/snapshot.yml", &g_model));
+  EXPECT_TRUE(storageDirtyMsk & EE_SNAPSHOT);
+  storageCheck(true);
+
+  memclear(&g_model, sizeof(g_model));
+  EXPECT_EQ(nullptr, readModelSnapshot("snapshot.yml", MODELS_PATH "/snapshot.yml", &g_model));
+  EXPECT_EQ(0, memcmp(&model, &g_model, sizeof(model)));
+  EXPECT_EQ(42, g_model.mixData[0].weight);
+
+  // a YAML write invalidates the snapshot
+  EXPECT_EQ(nullptr, writeModelYaml("snapshot.yml"));
+  EXPECT_NE(nullptr, readModelSnapshot("snapshot.yml", MODELS_PATH "/snapshot.yml", &g_model));
+
+  // only the current model is snapshotted
+  EXPECT_EQ(nullptr, readModelYaml("snapshot.yml", (uint8_t*)&model, sizeof(model)));
+  storageCheck(true);
+  EXPECT_NE(nullptr, readModelSnapshot("snapshot.yml", MODELS_PATH "/snapshot.yml", &g_model));
+
+  // the simulator does not write snapshots to the user SD card
+  modelSnapshotsEnabled = false;
+  EXPECT_EQ(nullptr, readModelYaml("snapshot.yml", (uint8_t*)&g_model, sizeof(g_model)));
+  storageCheck(true);
+  modelSnapshotsEnabled = true;
+  EXPECT_NE(nullptr, readModelSnapshot("snapshot.yml", MODELS_PATH "/snapshot.yml", &g_model));
+
+  f_unlink(MODELS_PATH "/snapshot.yml");
+  simuFatfsSetPaths("","");
+}
+#endif
@@ -467,6 +467,16 @@ const char STR_POWER_METER_EXT[] = TR_POWER_METER_EXT;
 const char STR_POWER_METER_INT[] = TR_POWER_METER_INT;
 const char STR_SPECTRUM_ANALYSER_EXT[] = TR_SPECTRUM_ANALYSER_EXT;
 const char STR_SPECTRUM_ANALYSER_INT[] = TR_SPECTRUM_ANALYSER_INT;
+const char STR_TELEMETRY_STATS[] = TR_TELEMETRY_STATS;
+const char STR_STATS_INT[] = TR_STATS_INT;
+const char STR_STATS_EXT[] = TR_STATS_EXT;
+const char STR_STATS_FRAMES[] = TR_STATS_FRAMES;
+const char STR_STATS_BYTES[] = TR_STATS_BYTES;
+const char STR_STATS_CRC_ERRORS[] = TR_STATS_CRC_ERRORS;
+const char STR_STATS_SIZE_ERRORS[] = TR_STATS_SIZE_ERRORS;
+const char STR_STATS_OVERRUNS[] = TR_STATS_OVERRUNS;
+const char STR_STATS_LATENCY[] = TR_STATS_LATENCY;
+const char STR_STATS_MAX_LATENCY[] = TR_STATS_MAX_LATENCY;
 const char STR_WAITING_FOR_RX[] = TR_WAITING_FOR_RX;
 const char STR_WAITING_FOR_TX[] = TR_WAITING_FOR_TX;
 const char STR_WAITING_FOR_MODULE[]  = TR_WAITING_FOR_MODULE;
@@ -931,6 +941,9 @@ const char STR_SDCARD_ERROR[] = TR_SDCARD_ERROR;
 const char STR_NO_SDCARD[] = TR_NO_SDCARD;
 const char STR_SDCARD_FULL[] = TR_SDCARD_FULL;
 const char STR_SDCARD_FULL_EXT[] = TR_SDCARD_FULL_EXT;
+const char STR_LOGS_FORMAT_CSV[] = TR_LOGS_FORMAT_CSV;
+const char STR_LOGS_FORMAT_BINARY[] = TR_LOGS_FORMAT_BINARY;
+const char STR_LOGS_FORMAT_RAW[] = TR_LOGS_FORMAT_RAW;
 const char STR_INCOMPATIBLE[] = TR_INCOMPATIBLE;
 const char STR_LOGS_PATH[] = LOGS_PATH;
 const char STR_LOGS_EXT[] = LOGS_EXT;
@@ -700,6 +700,16 @@ extern const char STR_POWER_METER_EXT[];
 extern const char STR_POWER_METER_INT[];
 extern const char STR_SPECTRUM_ANALYSER_EXT[];
 extern const char STR_SPECTRUM_ANALYSER_INT[];
+extern const char STR_TELEMETRY_STATS[];
+extern const char STR_STATS_INT[];
+extern const char STR_STATS_EXT[];
+extern const char STR_STATS_FRAMES[];
+extern const char STR_STATS_BYTES[];
+extern const char STR_STATS_CRC_ERRORS[];
+extern const char STR_STATS_SIZE_ERRORS[];
+extern const char STR_STATS_OVERRUNS[];
+extern const char STR_STATS_LATENCY[];
+extern const char STR_STATS_MAX_LATENCY[];
 extern const char STR_WAITING_FOR_RX[];
 extern const char STR_WAITING_FOR_TX[];
 extern const char STR_WAITING_FOR_MODULE[];
@@ -712,6 +722,9 @@ extern const char STR_SDCARD_ERROR[];
 extern const char STR_NO_SDCARD[];
 extern const char STR_SDCARD_FULL[];
 extern const char STR_SDCARD_FULL_EXT[];
+extern const char STR_LOGS_FORMAT_CSV[];
+extern const char STR_LOGS_FORMAT_BINARY[];
+extern const char STR_LOGS_FORMAT_RAW[];
 extern const char STR_INCOMPATIBLE[];
 extern const char STR_LOGS_PATH[];
 extern const char STR_LOGS_EXT[];
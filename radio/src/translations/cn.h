@@ -613,12 +613,25 @@
 #define TR_POWER_METER_INT             "功率计 (内置)"
 #define TR_SPECTRUM_ANALYSER_EXT       "频谱仪 (外置)"
 #define TR_SPECTRUM_ANALYSER_INT       "频谱仪 (内置)"
+#define TR_TELEMETRY_STATS             "Telemetry stats"
+#define TR_STATS_INT                   "Int"
+#define TR_STATS_EXT                   "Ext"
+#define TR_STATS_FRAMES                "Frames"
+#define TR_STATS_BYTES                 "Bytes"
+#define TR_STATS_CRC_ERRORS            TR("CRC err", "CRC errors")
+#define TR_STATS_SIZE_ERRORS           TR("Size err", "Size errors")
+#define TR_STATS_OVERRUNS              "Overruns"
+#define TR_STATS_LATENCY               "Latency (us)"
+#define TR_STATS_MAX_LATENCY           TR("Max lat. us", "Max latency (us)")
 #define TR_SDCARD_FULL                 "SD卡已满"
 #if defined(COLORLCD)
 #define TR_SDCARD_FULL_EXT             TR_SDCARD_FULL "\n日志和截屏功能将被禁用"
 #else
 #define TR_SDCARD_FULL_EXT             TR_SDCARD_FULL "\036日志和 " LCDW_128_480_LINEBREAK "截屏功能将被禁用"
 #endif
+#define TR_LOGS_FORMAT_CSV             "CSV"
+#define TR_LOGS_FORMAT_BINARY          TR("BIN", "Binary")
+#define TR_LOGS_FORMAT_RAW             TR("RAW", "Raw telemetry")
 #define TR_NEEDS_FILE                  "需要文件名包含"
 #define TR_EXT_MULTI_SPEC              "opentx-inv"
 #define TR_INT_MULTI_SPEC              "stm-opentx-noinv"
@@ -631,12 +631,25 @@
 #define TR_POWER_METER_INT             "Měřič výkonu (INT)"
 #define TR_SPECTRUM_ANALYSER_EXT       "Spektální an. (EXT)"
 #define TR_SPECTRUM_ANALYSER_INT       "Spektální an. (INT)"
+#define TR_TELEMETRY_STATS             "Telemetry stats"
+#define TR_STATS_INT                   "Int"
+#define TR_STATS_EXT                   "Ext"
+#define TR_STATS_FRAMES                "Frames"
+#define TR_STATS_BYTES                 "Bytes"
+#define TR_STATS_CRC_ERRORS            TR("CRC err", "CRC errors")
+#define TR_STATS_SIZE_ERRORS           TR("Size err", "Size errors")
+#define TR_STATS_OVERRUNS              "Overruns"
+#define TR_STATS_LATENCY               "Latency (us)"
+#define TR_STATS_MAX_LATENCY           TR("Max lat. us", "Max latency (us)")
 #define TR_SDCARD_FULL                 "Plná karta SD"
 #if defined(COLORLCD)
 #define TR_SDCARD_FULL_EXT TR_SDCARD_FULL "\nLogování dat a snímky obrazovky vypnuty"
 #else
 #define TR_SDCARD_FULL_EXT TR_SDCARD_FULL "\036Logy a " LCDW_128_480_LINEBREAK " Snímky obrazovky vypnuty"
 #endif
+#define TR_LOGS_FORMAT_CSV             "CSV"
+#define TR_LOGS_FORMAT_BINARY          TR("BIN", "Binary")
+#define TR_LOGS_FORMAT_RAW             TR("RAW", "Raw telemetry")
 #define TR_NEEDS_FILE                  "Vyžadován soubor"
 #define TR_EXT_MULTI_SPEC              "opentx-inv"
 #define TR_INT_MULTI_SPEC              "stm-opentx-noinv"
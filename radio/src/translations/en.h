@@ -624,12 +624,25 @@
 #define TR_POWER_METER_INT             "Power Meter (INT)"
 #define TR_SPECTRUM_ANALYSER_EXT       "Spectrum (EXT)"
 #define TR_SPECTRUM_ANALYSER_INT       "Spectrum (INT)"
+#define TR_TELEMETRY_STATS             "Telemetry stats"
+#define TR_STATS_INT                   "Int"
+#define TR_STATS_EXT                   "Ext"
+#define TR_STATS_FRAMES                "Frames"
+#define TR_STATS_BYTES                 "Bytes"
+#define TR_STATS_CRC_ERRORS            TR("CRC err", "CRC errors")
+#define TR_STATS_SIZE_ERRORS           TR("Size err", "Size errors")
+#define TR_STATS_OVERRUNS              "Overruns"
+#define TR_STATS_LATENCY               "Latency (us)"
+#define TR_STATS_MAX_LATENCY           TR("Max lat. us", "Max latency (us)")
 #define TR_SDCARD_FULL                 "SD card full"
 #if defined(COLORLCD)
 #define TR_SDCARD_FULL_EXT             TR_SDCARD_FULL "\nLogs and Screenshots disabled"
 #else
 #define TR_SDCARD_FULL_EXT             TR_SDCARD_FULL "\036Logs & Screenshots" LCDW_128_480_LINEBREAK "disabled"
 #endif
+#define TR_LOGS_FORMAT_CSV             "CSV"
+#define TR_LOGS_FORMAT_BINARY          TR("BIN", "Binary")
+#define TR_LOGS_FORMAT_RAW             TR("RAW", "Raw telemetry")
 #define TR_NEEDS_FILE                  "NEEDS FILE"
 #define TR_EXT_MULTI_SPEC              "opentx-inv"
 #define TR_INT_MULTI_SPEC              "stm-opentx-noinv"